@@ -3,8 +3,20 @@
 // macro defines
 
 // engine
-#define ENGINE_NAME    "EMT-D3D12"
-#define MAX_SYNC_FRAME 2
+#define ENGINE_NAME               "EMT-D3D12"
+#define MAX_SYNC_FRAME            2                             // default frames in flight
+#define MAX_FRAMES_IN_FLIGHT      8                             // upper bound for set_frames_in_flight
+#define MAX_BACKBUFFER_COUNT      3                             // default swapchain buffers
+#define UPLOAD_RING_SIZE          (32ull << 20)                 // persistent staging ring (bytes)
+#define MAX_RECORD_WORKERS        64                            // parallel command lists per frame
+#define MAX_RENDER_PASS_COLORS    8                             // simultaneous render targets
+#define PIPELINE_CACHE_FILE       "pipeline.cache"              // ID3D12PipelineLibrary blob in EMT_CACHE_DIR
+#define ROOT_SIGNATURE_CACHE_FILE "root_signature.cache"        // serialized root signatures in EMT_CACHE_DIR
+#define BINDLESS_DESCRIPTOR_COUNT 8192                          // persistent cbv/srv/uav slots (stable indices)
+#define FRAME_DESCRIPTOR_COUNT    (64 * 1024)                   // transient cbv/srv/uav ring, shared by frames in flight
+#define DESCRIPTOR_CHUNK_SIZE     256                           // transient descriptors a recording thread takes at once
+#define DESCRIPTOR_CHUNK_SPAN     16                            // chunks reserved from the ring per lock
+#define STAGING_DESCRIPTOR_COUNT  16384                         // cpu-only cbv/srv/uav views, copied into tables
 
 // clang-format off
 #define unused(x) (void)(x)
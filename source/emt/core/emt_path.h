@@ -2,3 +2,4 @@
 
 #define EMT_DATA_DIR "C:/@github/@ripcode0/emt-d3d12/data/"
 #define EMT_HLSL_DIR "C:/@github/@ripcode0/emt-d3d12/data/hlsl/"
+#define EMT_CACHE_DIR "C:/@github/@ripcode0/emt-d3d12/bin/cache/"
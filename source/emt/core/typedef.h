@@ -85,6 +85,8 @@ namespace emt
 // frontend
 class context;
 class scene;
+class job_system;
+class job_counter;
 
 // backend
 // vulkan
@@ -127,6 +129,34 @@ enum class store_operator {
 	no_access
 };
 
+// resource usage seen by the render graph, read states may be or-ed together
+enum class resource_state : uint32_t {
+	common           = 0,
+	present          = 0,
+	vertex_buffer    = 1u << 0,
+	constant_buffer  = 1u << 1,
+	index_buffer     = 1u << 2,
+	render_target    = 1u << 3,
+	unordered_access = 1u << 4,
+	depth_write      = 1u << 5,
+	depth_read       = 1u << 6,
+	shader_read      = 1u << 7,
+	copy_dst         = 1u << 8,
+	copy_src         = 1u << 9,
+	indirect         = 1u << 10,
+
+	read_mask = vertex_buffer | constant_buffer | index_buffer | depth_read | shader_read | copy_src | indirect
+};
+
+constexpr resource_state operator|(resource_state a, resource_state b) { return resource_state(uint32_t(a) | uint32_t(b)); }
+constexpr resource_state operator&(resource_state a, resource_state b) { return resource_state(uint32_t(a) & uint32_t(b)); }
+
+// common(=present) 는 read 로 보지 않음 : 다른 read 와 합칠 수 없음
+constexpr bool is_read_state(resource_state s)
+{
+	return s != resource_state::common && (s & resource_state::read_mask) == s;
+}
+
 enum class buffer_type : uint32_t {
 	raw,
 	vertex,
@@ -141,6 +171,15 @@ struct buffer_create_info
 	uint32_t    size;
 };
 
+// rgba8 2d texture
+struct texture_create_info
+{
+	const void* pixels;
+	uint32_t    width;
+	uint32_t    height;
+	uint32_t    row_stride;
+};
+
 // shader
 
 enum class shader_stage : uint32_t {
@@ -153,12 +192,20 @@ enum class shader_stage : uint32_t {
 	domain
 };
 
+// -D name=value (value 가 nullptr 면 1)
+struct shader_define
+{
+	const char* name;
+	const char* value;
+};
+
 struct shader_create_info
 {
-	shader_stage           stage;
-	const char*            filename;
-	const char*            entry;
-	std::span<const char*> includes;
+	shader_stage                   stage;
+	const char*                    filename;
+	const char*                    entry;
+	std::span<const char*>         includes;
+	std::span<const shader_define> defines;
 };
 
 }        // namespace emt
@@ -0,0 +1,200 @@
+#include "file_watcher.h"
+#include <emt/core/config.h>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+#if defined(__linux__)
+#	include <poll.h>
+#	include <sys/inotify.h>
+#	include <unistd.h>
+#endif
+
+namespace emt
+{
+namespace fs = std::filesystem;
+
+std::string normalize_path(const std::string& path)
+{
+	std::error_code ec;
+	fs::path        p = fs::weakly_canonical(fs::path(path), ec);
+	if(ec)
+		p = fs::path(path).lexically_normal();
+	return p.generic_string();
+}
+
+void file_watcher::push(const std::string& path)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_changed.push_back(normalize_path(path));
+}
+
+bool file_watcher::poll(std::vector<std::string>* changed)
+{
+	changed->clear();
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		changed->swap(m_changed);
+	}
+	// editor 는 한 번 저장에 여러 event 를 만듦
+	std::sort(changed->begin(), changed->end());
+	changed->erase(std::unique(changed->begin(), changed->end()), changed->end());
+	return !changed->empty();
+}
+
+void file_watcher::stop()
+{
+	if(!m_thread.joinable())
+		return;
+	m_running.store(false);
+	m_thread.join();
+#if defined(_WIN32)
+	CloseHandle(reinterpret_cast<HANDLE>(m_handle));
+#elif defined(__linux__)
+	close(int(m_handle));
+#endif
+	m_handle = -1;
+}
+
+#if defined(__linux__)
+
+bool file_watcher::start(const char* directory)
+{
+	log_assert(!running(), "file watcher already started");
+	m_directory = directory;
+	const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if(fd < 0) {
+		log_warn("inotify unavailable, shader hot reload disabled");
+		return false;
+	}
+	m_handle = fd;
+	m_running.store(true);
+	m_thread = std::thread(&file_watcher::watch_main, this);
+	return true;
+}
+
+void file_watcher::watch_main()
+{
+	const int                            fd   = int(m_handle);
+	const uint32_t                       mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE;
+	std::unordered_map<int, std::string> dirs;
+
+	// inotify 는 재귀 감시가 없음 : directory 마다 watch
+	auto add_tree = [&](const std::string& root) {
+		std::error_code ec;
+		if(int wd = inotify_add_watch(fd, root.c_str(), mask); wd >= 0)
+			dirs[wd] = root;
+		for(fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+			if(!it->is_directory(ec))
+				continue;
+			const std::string path = it->path().string();
+			if(int wd = inotify_add_watch(fd, path.c_str(), mask); wd >= 0)
+				dirs[wd] = path;
+		}
+	};
+	add_tree(m_directory);
+
+	alignas(inotify_event) char buffer[16 * 1024];
+	while(m_running.load()) {
+		pollfd pfd{fd, POLLIN, 0};
+		if(::poll(&pfd, 1, 100) <= 0)
+			continue;
+		const ssize_t size = read(fd, buffer, sizeof(buffer));
+		for(ssize_t offset = 0; offset < size;) {
+			const inotify_event* e = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + e->len;
+
+			auto it = dirs.find(e->wd);
+			if(it == dirs.end() || e->len == 0)
+				continue;
+			const std::string path = it->second + "/" + e->name;
+			if(e->mask & IN_ISDIR) {
+				if(e->mask & (IN_CREATE | IN_MOVED_TO))
+					add_tree(path);
+				continue;
+			}
+			// IN_CREATE 뒤에는 IN_CLOSE_WRITE 가 따라옴
+			if(e->mask & (IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE))
+				push(path);
+		}
+	}
+}
+
+#elif defined(_WIN32)
+
+bool file_watcher::start(const char* directory)
+{
+	log_assert(!running(), "file watcher already started");
+	m_directory = directory;
+
+	const std::wstring wide = fs::path(directory).wstring();
+	HANDLE             dir  = CreateFileW(wide.c_str(), FILE_LIST_DIRECTORY,
+	                                      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+	                                      OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	if(dir == INVALID_HANDLE_VALUE) {
+		log_warn("cannot watch %s, shader hot reload disabled", directory);
+		return false;
+	}
+	m_handle = reinterpret_cast<intptr_t>(dir);
+	m_running.store(true);
+	m_thread = std::thread(&file_watcher::watch_main, this);
+	return true;
+}
+
+void file_watcher::watch_main()
+{
+	HANDLE     dir = reinterpret_cast<HANDLE>(m_handle);
+	OVERLAPPED ov{};
+	ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+	alignas(DWORD) uint8_t buffer[16 * 1024];
+	const DWORD            filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME;
+	while(m_running.load()) {
+		ResetEvent(ov.hEvent);
+		if(!ReadDirectoryChangesW(dir, buffer, sizeof(buffer), TRUE, filter, nullptr, &ov, nullptr))
+			break;
+		// 변경 또는 stop 까지 (stop 은 100ms 안에 반영)
+		DWORD wait  = WAIT_TIMEOUT;
+		DWORD bytes = 0;
+		while(m_running.load() && (wait = WaitForSingleObject(ov.hEvent, 100)) == WAIT_TIMEOUT) {
+		}
+		if(wait != WAIT_OBJECT_0) {
+			CancelIoEx(dir, &ov);
+			GetOverlappedResult(dir, &ov, &bytes, TRUE);
+			break;
+		}
+		// bytes 0 : buffer overflow, 이번 변경은 놓침
+		if(!GetOverlappedResult(dir, &ov, &bytes, FALSE) || bytes == 0)
+			continue;
+
+		for(DWORD offset = 0;;) {
+			const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buffer + offset);
+			if(info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_ADDED ||
+			   info->Action == FILE_ACTION_RENAMED_NEW_NAME || info->Action == FILE_ACTION_REMOVED) {
+				const std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+				push((fs::path(m_directory) / fs::path(name)).string());
+			}
+			if(info->NextEntryOffset == 0)
+				break;
+			offset += info->NextEntryOffset;
+		}
+	}
+	CloseHandle(ov.hEvent);
+}
+
+#else
+
+bool file_watcher::start(const char* directory)
+{
+	unused(directory);
+	log_warn("file watching is not supported on this platform");
+	return false;
+}
+
+void file_watcher::watch_main()
+{
+}
+
+#endif
+
+}        // namespace emt
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace emt
+{
+// Directory tree 의 파일 변경 감시 (linux : inotify, windows : ReadDirectoryChangesW)
+// 감시는 background thread 에서, 변경된 파일은 poll 로 가져감
+// 경로는 weakly_canonical 후 '/' 구분자 (shader_dependency_graph 와 같은 형식)
+class file_watcher
+{
+public:
+	file_watcher() = default;
+	~file_watcher() { stop(); }
+
+	file_watcher(const file_watcher&)            = delete;
+	file_watcher& operator=(const file_watcher&) = delete;
+
+	bool start(const char* directory);
+	void stop();
+	bool running() const { return m_thread.joinable(); }
+
+	// 마지막 poll 이후 바뀐 파일 (중복 제거), 없으면 false
+	bool poll(std::vector<std::string>* changed);
+
+private:
+	void watch_main();
+	void push(const std::string& path);
+
+	std::string              m_directory;
+	std::thread              m_thread;
+	std::atomic<bool>        m_running{false};
+	std::mutex               m_lock;
+	std::vector<std::string> m_changed;
+
+	// platform handle : inotify fd / directory HANDLE
+	intptr_t m_handle = -1;
+};
+
+// file_watcher 와 dependency graph 가 같은 key 를 쓰도록
+std::string normalize_path(const std::string& path);
+
+}        // namespace emt
@@ -0,0 +1,216 @@
+#include "job_system.h"
+
+namespace emt
+{
+static thread_local uint32_t   t_thread_index = ~0u;
+static thread_local job_system* t_owner        = nullptr;
+
+job_system::job_system(uint32_t worker_count)
+{
+	if(worker_count == 0) {
+		const uint32_t hw = std::thread::hardware_concurrency();
+		worker_count      = hw > 1 ? hw - 1 : 1;
+	}
+	m_thread_count = worker_count + 1;
+	m_threads      = emt_new thread_state[m_thread_count];
+	for(uint32_t i = 0; i < m_thread_count; ++i) {
+		m_threads[i].pool = emt_new job[k_queue_size];
+		m_threads[i].rng  = 0x9E3779B9u * (i + 1);
+	}
+
+	t_thread_index = 0;
+	t_owner        = this;
+
+	m_workers.reserve(worker_count);
+	for(uint32_t i = 1; i < m_thread_count; ++i) {
+		m_workers.emplace_back(&job_system::worker_main, this, i);
+	}
+	log_info("job system : %u threads", m_thread_count);
+}
+
+job_system::~job_system()
+{
+	// queue 에 남은 job 을 버리면 다른 곳에서 wait 중인 counter 가 0 이 되지 않음 -> drain
+	// continuation 은 pending 인 job 에만 의존하므로 결국 모두 submit 됨
+	while(m_pending.load(std::memory_order_acquire) != 0) {
+		if(t_owner != this || !run_one())
+			std::this_thread::yield();
+	}
+
+	m_running.store(false);
+	m_epoch.fetch_add(1);
+	m_epoch.notify_all();
+	for(auto& t : m_workers) {
+		t.join();
+	}
+	for(uint32_t i = 0; i < m_thread_count; ++i) {
+		safe_delete_array(m_threads[i].pool);
+	}
+	safe_delete_array(m_threads);
+	if(t_owner == this) {
+		t_owner        = nullptr;
+		t_thread_index = ~0u;
+	}
+}
+
+uint32_t job_system::thread_index()
+{
+	return t_thread_index;
+}
+
+void job_system::spawn(job_function fn, job_counter* counter)
+{
+	if(counter)
+		counter->m_value.fetch_add(1, std::memory_order_relaxed);
+	submit(allocate(std::move(fn), counter));
+}
+
+void job_system::spawn_after(job_counter* dependency, job_function fn, job_counter* counter)
+{
+	if(counter)
+		counter->m_value.fetch_add(1, std::memory_order_relaxed);
+	job* j = allocate(std::move(fn), counter);
+	{
+		std::lock_guard<std::mutex> lock(dependency->m_mutex);
+		if(dependency->value() != 0) {
+			dependency->m_continuations.push_back(j);
+			return;
+		}
+	}
+	submit(j);
+}
+
+void job_system::wait(job_counter* counter)
+{
+	while(!counter->done()) {
+		if(!run_one())
+			std::this_thread::yield();
+	}
+}
+
+job_system::job* job_system::allocate(job_function fn, job_counter* counter)
+{
+	log_assert(t_owner == this, "spawn from a thread not owned by the job system");
+	thread_state& ts = m_threads[t_thread_index];
+	job*          j  = &ts.pool[ts.pool_next];
+	ts.pool_next     = (ts.pool_next + 1) % k_queue_size;
+
+	// pool 이 한 바퀴 돌았는데 아직 끝나지 않은 슬롯 (실행 중인 상위 job 일 수도 있음) -> heap
+	if(j->busy.load(std::memory_order_acquire)) {
+		j       = emt_new job;
+		j->heap = true;
+	}
+	j->fn      = std::move(fn);
+	j->counter = counter;
+	j->busy.store(true, std::memory_order_relaxed);
+	m_pending.fetch_add(1, std::memory_order_relaxed);
+	return j;
+}
+
+void job_system::submit(job* j)
+{
+	thread_state& ts = m_threads[t_thread_index];
+	if(!ts.queue.push(j)) {
+		// queue 가 가득 차면 바로 실행
+		execute(j);
+		return;
+	}
+	m_epoch.fetch_add(1);
+	if(m_sleeping.load() > 0)
+		m_epoch.notify_one();
+}
+
+void job_system::execute(job* j)
+{
+	job_counter* counter = j->counter;
+	j->fn();
+	if(j->heap) {
+		delete j;
+	}
+	else {
+		j->fn = nullptr;
+		j->busy.store(false, std::memory_order_release);
+	}
+	if(counter)
+		finish(counter);
+	// continuation 이 submit 된 뒤에 감소 -> drain 중 pending 이 잠깐 0 이 되지 않음
+	m_pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void job_system::finish(job_counter* counter)
+{
+	// m_finishing 감소가 counter 에 대한 마지막 접근 -> 그 뒤로 대기자가 파괴해도 안전
+	counter->m_finishing.fetch_add(1);
+	std::vector<void*> ready;
+	if(counter->m_value.fetch_sub(1) == 1) {
+		std::lock_guard<std::mutex> lock(counter->m_mutex);
+		ready.swap(counter->m_continuations);
+	}
+	counter->m_finishing.fetch_sub(1);
+
+	for(void* p : ready) {
+		submit(static_cast<job*>(p));
+	}
+}
+
+job_system::job* job_system::find_job(uint32_t index)
+{
+	thread_state& ts = m_threads[index];
+	if(job* j = ts.queue.pop())
+		return j;
+
+	// xorshift 로 고른 victim 부터 한 바퀴
+	ts.rng ^= ts.rng << 13;
+	ts.rng ^= ts.rng >> 17;
+	ts.rng ^= ts.rng << 5;
+	const uint32_t start = ts.rng % m_thread_count;
+	for(uint32_t i = 0; i < m_thread_count; ++i) {
+		const uint32_t victim = (start + i) % m_thread_count;
+		if(victim == index)
+			continue;
+		if(job* j = m_threads[victim].queue.steal())
+			return j;
+	}
+	return nullptr;
+}
+
+bool job_system::run_one()
+{
+	job* j = find_job(t_thread_index);
+	if(!j)
+		return false;
+	execute(j);
+	return true;
+}
+
+void job_system::worker_main(uint32_t index)
+{
+	t_thread_index = index;
+	t_owner        = this;
+
+	uint32_t spins = 0;
+	while(m_running.load(std::memory_order_relaxed)) {
+		if(run_one()) {
+			spins = 0;
+			continue;
+		}
+		if(++spins < 64) {
+			std::this_thread::yield();
+			continue;
+		}
+		// epoch 를 먼저 읽고 다시 확인 -> 그 사이 spawn 이 있었다면 wait 는 바로 반환
+		const uint32_t epoch = m_epoch.load();
+		m_sleeping.fetch_add(1);
+		if(job* j = find_job(index)) {
+			m_sleeping.fetch_sub(1);
+			execute(j);
+			spins = 0;
+			continue;
+		}
+		m_epoch.wait(epoch);
+		m_sleeping.fetch_sub(1);
+		spins = 0;
+	}
+}
+
+}        // namespace emt
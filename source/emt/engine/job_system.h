@@ -0,0 +1,109 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include "work_stealing_deque.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace emt
+{
+class job_system;
+
+// Counts unfinished jobs; jobs spawned "after" a counter run once it reaches zero.
+class job_counter
+{
+public:
+	uint32_t value() const { return m_value.load(std::memory_order_acquire); }
+	// finishing 까지 0 이어야 counter 를 (stack 에서) 안전하게 파괴할 수 있음
+	bool done() const { return value() == 0 && m_finishing.load(std::memory_order_acquire) == 0; }
+
+private:
+	friend class job_system;
+	std::atomic<uint32_t> m_value{0};
+	std::atomic<uint32_t> m_finishing{0};
+	std::mutex            m_mutex;
+	std::vector<void*>    m_continuations;        // job* 대기열
+};
+
+// Work-stealing scheduler : one Chase-Lev deque per thread, the constructing
+// (main) thread is thread 0 and helps run jobs while it waits.
+// spawn/wait may only be called from the main thread or from inside a job.
+class job_system
+{
+public:
+	typedef std::function<void()> job_function;
+
+	// worker_count 0 : hardware threads - 1
+	explicit job_system(uint32_t worker_count = 0);
+	// 남은 job (continuation 포함) 을 모두 실행한 뒤 worker 를 종료
+	~job_system();
+
+	job_system(const job_system&)            = delete;
+	job_system& operator=(const job_system&) = delete;
+
+	void spawn(job_function fn, job_counter* counter = nullptr);
+	// dependency 가 0 이 된 뒤에 실행
+	void spawn_after(job_counter* dependency, job_function fn, job_counter* counter = nullptr);
+	// counter 가 0 이 될 때까지 다른 job 을 실행하며 대기
+	void wait(job_counter* counter);
+
+	// fn(begin, end) 를 grain 크기로 나눠 실행하고 끝날 때까지 대기
+	template<typename Fn>
+	void parallel_for(uint32_t count, uint32_t grain, Fn&& fn)
+	{
+		if(count == 0)
+			return;
+		if(grain == 0)
+			grain = 1;
+		job_counter counter;
+		for(uint32_t begin = grain; begin < count; begin += grain) {
+			const uint32_t end = begin + grain < count ? begin + grain : count;
+			spawn([&fn, begin, end]() { fn(begin, end); }, &counter);
+		}
+		// 첫 구간은 호출한 thread 가 직접
+		fn(0u, grain < count ? grain : count);
+		wait(&counter);
+	}
+
+	uint32_t        thread_count() const { return m_thread_count; }
+	static uint32_t thread_index();
+
+private:
+	static constexpr uint32_t k_queue_size = 4096;
+
+	struct job
+	{
+		job_function      fn;
+		job_counter*      counter{};
+		std::atomic<bool> busy{false};
+		bool              heap{false};        // pool 슬롯이 사용 중이라 따로 할당됨
+	};
+	struct alignas(64) thread_state
+	{
+		work_stealing_deque<job*, k_queue_size> queue;
+		job*                                    pool{};
+		uint32_t                                pool_next{};
+		uint32_t                                rng{};
+	};
+
+	job* allocate(job_function fn, job_counter* counter);
+	void submit(job* j);
+	void execute(job* j);
+	void finish(job_counter* counter);
+	job* find_job(uint32_t index);
+	bool run_one();
+	void worker_main(uint32_t index);
+
+	std::vector<std::thread> m_workers;
+	thread_state*            m_threads{};
+	uint32_t                 m_thread_count{};
+	std::atomic<bool>        m_running{true};
+	std::atomic<uint32_t>    m_epoch{0};
+	std::atomic<uint32_t>    m_sleeping{0};
+	std::atomic<uint32_t>    m_pending{0};        // allocate ~ execute 끝, continuation 대기 포함
+};
+
+}        // namespace emt
@@ -19,5 +19,6 @@ public:
 	// private:
 	dx_context_core* m_context{};
 	dx_device*       m_device{};
+	job_system*      m_jobs{};        // execute_scene 에서 설정, object 단위 작업 분산용
 };
 }        // namespace emt
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace emt
+{
+// Chase-Lev work-stealing deque (Le, Pop, Cohen, Nardelli 2013 memory orders).
+// The owner thread push()/pop() at the bottom, any thread may steal() from the top.
+// Fixed capacity (power of two), T must be a pointer type; nullptr means "nothing".
+template<typename T, uint32_t N>
+class work_stealing_deque
+{
+	static_assert((N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+	// owner only, false when full
+	bool push(T item)
+	{
+		const int64_t b = m_bottom.load(std::memory_order_relaxed);
+		const int64_t t = m_top.load(std::memory_order_acquire);
+		if(b - t >= static_cast<int64_t>(N))
+			return false;
+		m_items[b & (N - 1)].store(item, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// owner only, LIFO
+	T pop()
+	{
+		const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = m_top.load(std::memory_order_relaxed);
+
+		if(t > b) {
+			m_bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		T item = m_items[b & (N - 1)].load(std::memory_order_relaxed);
+		if(t == b) {
+			// 마지막 하나는 thief 와 경쟁
+			if(!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				item = nullptr;
+			m_bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return item;
+	}
+
+	// any thread, FIFO
+	T steal()
+	{
+		int64_t t = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t b = m_bottom.load(std::memory_order_acquire);
+		if(t >= b)
+			return nullptr;
+		T item = m_items[t & (N - 1)].load(std::memory_order_relaxed);
+		if(!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+		return item;
+	}
+
+	bool empty() const
+	{
+		return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+	}
+
+private:
+	// top 과 bottom 은 다른 thread 가 쓰므로 cache line 분리
+	alignas(64) std::atomic<int64_t> m_top{0};
+	alignas(64) std::atomic<int64_t> m_bottom{0};
+	alignas(64) std::atomic<T> m_items[N]{};
+};
+
+}        // namespace emt
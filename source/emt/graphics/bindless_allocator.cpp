@@ -0,0 +1,77 @@
+#include "bindless_allocator.h"
+
+namespace emt
+{
+void bindless_allocator::initialize(uint32_t first, uint32_t capacity)
+{
+	log_assert(capacity <= bindless_handle::slot_mask + 1, "bindless capacity exceeds handle range");
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_first    = first;
+	m_capacity = capacity;
+	m_live     = 0;
+	m_generations.assign(capacity, 1);
+	m_free.resize(capacity);
+	// pop_back 이 slot 0 부터 주도록
+	for(uint32_t i = 0; i < capacity; ++i)
+		m_free[i] = capacity - 1 - i;
+	m_retired = retire_queue<uint32_t>{};
+}
+
+void bindless_allocator::release()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_capacity = 0;
+	m_live     = 0;
+	m_generations.clear();
+	m_free.clear();
+	m_retired = retire_queue<uint32_t>{};
+}
+
+bindless_handle bindless_allocator::allocate()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	if(m_free.empty()) {
+		log_error("bindless heap full (%u live, %zu pending)", m_live, m_retired.size());
+		return {};
+	}
+	const uint32_t slot = m_free.back();
+	m_free.pop_back();
+	++m_live;
+	return bindless_handle{(uint32_t(m_generations[slot]) << bindless_handle::slot_bits) | slot};
+}
+
+void bindless_allocator::free(bindless_handle handle, uint64_t retire_value)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	const uint32_t              slot = handle.slot();
+	if(!handle || slot >= m_capacity || m_generations[slot] != handle.generation()) {
+		log_error("stale or invalid bindless handle %08x", handle.value);
+		return;
+	}
+	// 0 은 invalid handle 용
+	uint16_t& generation = m_generations[slot];
+	generation           = generation == bindless_handle::generation_mask ? 1 : uint16_t(generation + 1);
+	--m_live;
+	m_retired.push(retire_value, slot);
+}
+
+void bindless_allocator::collect(uint64_t completed)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_retired.collect(completed, [this](uint32_t slot) { m_free.push_back(slot); });
+}
+
+bool bindless_allocator::valid(bindless_handle handle) const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	const uint32_t              slot = handle.slot();
+	return handle && slot < m_capacity && m_generations[slot] == handle.generation();
+}
+
+uint32_t bindless_allocator::pending()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return uint32_t(m_retired.size());
+}
+
+}        // namespace emt
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <emt/graphics/retire_queue.h>
+#include <mutex>
+#include <vector>
+
+namespace emt
+{
+// [generation 12 | slot 20] : slot 을 다시 쓰면 이전 handle 은 invalid, 0 은 항상 invalid
+struct bindless_handle
+{
+	static constexpr uint32_t slot_bits       = 20;
+	static constexpr uint32_t slot_mask       = (1u << slot_bits) - 1;
+	static constexpr uint32_t generation_mask = (1u << (32 - slot_bits)) - 1;
+
+	uint32_t value{};
+
+	uint32_t slot() const { return value & slot_mask; }
+	uint32_t generation() const { return value >> slot_bits; }
+	explicit operator bool() const { return value != 0; }
+	bool     operator==(const bindless_handle&) const = default;
+};
+
+// Shader visible heap 의 persistent 영역 (API 독립, headless 로 test 가능)
+//  - 한 번 만든 descriptor 는 free 할 때까지 같은 index (shader 는 ResourceDescriptorHeap[index])
+//  - free 한 slot 은 gpu 가 retire_value 를 지난 뒤 (collect) 재사용, handle 은 free 즉시 invalid
+// 여러 thread 에서 allocate / free 가능
+class bindless_allocator
+{
+public:
+	// heap 의 [first, first + capacity) 를 관리
+	void initialize(uint32_t first, uint32_t capacity);
+	void release();
+
+	// 가득 차면 invalid handle (log_error)
+	bindless_handle allocate();
+	void            free(bindless_handle handle, uint64_t retire_value);
+	// completed 까지 끝난 slot 을 free list 로 (begin_frame)
+	void collect(uint64_t completed);
+
+	bool     valid(bindless_handle handle) const;
+	uint32_t index(bindless_handle handle) const { return m_first + handle.slot(); }        // heap 안의 index
+
+	uint32_t first() const { return m_first; }
+	uint32_t capacity() const { return m_capacity; }
+	uint32_t size() const { return m_live; }        // 살아 있는 handle 수
+	uint32_t pending();                             // free 되었지만 gpu 대기 중
+
+private:
+	mutable std::mutex     m_lock;
+	uint32_t               m_first{};
+	uint32_t               m_capacity{};
+	uint32_t               m_live{};
+	std::vector<uint16_t>  m_generations;        // slot 의 현재 generation
+	std::vector<uint32_t>  m_free;               // LIFO : 최근 slot 이 cache 에 남아 있음
+	retire_queue<uint32_t> m_retired;
+};
+
+}        // namespace emt
@@ -0,0 +1,75 @@
+#include "descriptor_chunk.h"
+
+namespace emt
+{
+void descriptor_chunk_source::initialize(uint32_t chunk_size, uint32_t chunks_per_span, reserve_function reserve)
+{
+	m_chunk_size = chunk_size;
+	m_span_size  = chunk_size * chunks_per_span;
+	m_reserve    = std::move(reserve);
+	m_cursor.store(0, std::memory_order_relaxed);
+	m_spans.store(0, std::memory_order_relaxed);
+}
+
+void descriptor_chunk_source::release()
+{
+	m_reserve = nullptr;
+	m_cursor.store(0, std::memory_order_relaxed);
+}
+
+uint32_t descriptor_chunk_source::acquire()
+{
+	// index 는 lock (refill) 을 거쳐 publish 되므로 relaxed 로 충분
+	const uint64_t cursor = m_cursor.fetch_add(m_chunk_size, std::memory_order_relaxed);
+	const uint32_t next   = uint32_t(cursor);
+	const uint32_t end    = uint32_t(cursor >> 32);
+	if(next <= end && end - next >= m_chunk_size)
+		return next;
+	return refill();
+}
+
+uint32_t descriptor_chunk_source::refill()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	for(;;) {
+		// 먼저 들어온 thread 가 새 span 을 걸었으면 거기서 받음
+		uint64_t cursor = m_cursor.load(std::memory_order_relaxed);
+		uint32_t next   = uint32_t(cursor);
+		uint32_t end    = uint32_t(cursor >> 32);
+		if(next > end || end - next < m_chunk_size)
+			break;
+		if(m_cursor.compare_exchange_weak(cursor, cursor + m_chunk_size, std::memory_order_relaxed))
+			return next;
+	}
+	if(!m_reserve)
+		return invalid;
+
+	// ring 끝이나 가득 찬 경우 chunk 하나라도
+	uint32_t size  = m_span_size;
+	uint32_t first = m_reserve(size);
+	if(first == invalid && m_span_size > m_chunk_size) {
+		size  = m_chunk_size;
+		first = m_reserve(size);
+	}
+	if(first == invalid)
+		return invalid;
+	m_spans.fetch_add(1, std::memory_order_relaxed);
+	// 남은 span 은 이 store 로 버려짐 (이미 넘친 fetch_add 만 옛 값을 봄)
+	m_cursor.store(uint64_t(first + size) << 32 | (first + m_chunk_size), std::memory_order_relaxed);
+	return first;
+}
+
+uint32_t descriptor_chunk_cache::refill(uint32_t count)
+{
+	if(!m_source || count > m_source->chunk_size())
+		return descriptor_chunk_source::invalid;
+	const uint32_t first = m_source->acquire();
+	if(first == descriptor_chunk_source::invalid)
+		return first;
+	// 이전 chunk 의 나머지는 버림
+	m_next = first + count;
+	m_end  = first + m_source->chunk_size();
+	return first;
+}
+
+}        // namespace emt
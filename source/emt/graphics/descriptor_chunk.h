@@ -0,0 +1,72 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace emt
+{
+// transient descriptor 를 recording thread 마다 chunk 단위로 나눠 줌
+//  - descriptor_chunk_source : 공유, span (chunk 여러 개) 안에서 fetch_add 한 번으로 chunk 하나
+//    span 이 떨어졌을 때만 lock 을 잡고 reserve (heap 의 ring) 에서 새 span
+//  - descriptor_chunk_cache : thread 하나 전용, chunk 안에서는 lock / atomic 없이 bump
+// index 는 source 가 관리하는 범위 기준 (heap 의 transient offset)
+class descriptor_chunk_source
+{
+public:
+	static constexpr uint32_t invalid = ~0u;
+
+	// reserve(count) -> 연속된 count 개의 시작 index, 실패하면 invalid (lock 안에서 호출)
+	typedef std::function<uint32_t(uint32_t count)> reserve_function;
+
+	void initialize(uint32_t chunk_size, uint32_t chunks_per_span, reserve_function reserve);
+	void release();
+
+	// 여러 thread 에서 호출 가능, 실패하면 invalid
+	uint32_t acquire();
+	// 현재 span 을 버림 : 다음 acquire 는 새 span (fence 가 바뀌는 begin_frame, recording 중이 아닐 때)
+	void invalidate() { m_cursor.store(0, std::memory_order_relaxed); }
+
+	uint32_t chunk_size() const { return m_chunk_size; }
+	uint32_t spans() const { return m_spans.load(std::memory_order_relaxed); }        // initialize 이후 reserve 한 span 수
+
+private:
+	uint32_t refill();
+
+	// [end 32 | next 32] : 한 번의 fetch_add 로 next 를 올리고 같은 span 의 end 를 같이 읽음
+	std::atomic<uint64_t> m_cursor{0};
+	std::atomic<uint32_t> m_spans{0};
+	uint32_t              m_chunk_size{};
+	uint32_t              m_span_size{};
+	reserve_function      m_reserve;
+	std::mutex            m_lock;
+};
+
+class descriptor_chunk_cache
+{
+public:
+	void bind(descriptor_chunk_source* source) { m_source = source; }
+	// 남은 chunk 를 버림 (source 의 invalidate 와 같이)
+	void reset() { m_next = m_end = 0; }
+
+	// count 개 연속, chunk 보다 크거나 source 가 비면 invalid
+	uint32_t allocate(uint32_t count)
+	{
+		if(m_end - m_next >= count) {
+			const uint32_t index = m_next;
+			m_next += count;
+			return index;
+		}
+		return refill(count);
+	}
+
+private:
+	uint32_t refill(uint32_t count);
+
+	descriptor_chunk_source* m_source{};
+	uint32_t                 m_next{};
+	uint32_t                 m_end{};
+};
+
+}        // namespace emt
@@ -0,0 +1,52 @@
+#include "descriptor_table_cache.h"
+#include <emt/graphics/hash.h>
+#include <algorithm>
+
+namespace emt
+{
+uint64_t descriptor_table_cache::hash(std::span<const bindless_handle> sources)
+{
+	stable_hasher h;
+	for(const bindless_handle& s : sources)
+		h.add(s.value);
+	return h.value();
+}
+
+bool descriptor_table_cache::find(std::span<const bindless_handle> sources, uint64_t hash, uint32_t* index)
+{
+	auto it = m_buckets.find(hash);
+	for(uint32_t i = it == m_buckets.end() ? end : it->second; i != end; i = m_entries[i].next) {
+		const entry& e = m_entries[i];
+		if(e.count == sources.size() && std::equal(sources.begin(), sources.end(), m_sources.begin() + e.first)) {
+			*index = e.index;
+			++m_hits;
+			return true;
+		}
+	}
+	++m_misses;
+	return false;
+}
+
+void descriptor_table_cache::insert(std::span<const bindless_handle> sources, uint64_t hash, uint32_t index)
+{
+	auto  it = m_buckets.try_emplace(hash, end).first;
+	entry e;
+	e.first    = uint32_t(m_sources.size());
+	e.count    = uint32_t(sources.size());
+	e.index    = index;
+	e.next     = it->second;
+	it->second = uint32_t(m_entries.size());
+	m_entries.push_back(e);
+	m_sources.insert(m_sources.end(), sources.begin(), sources.end());
+}
+
+void descriptor_table_cache::reset()
+{
+	m_buckets.clear();
+	m_entries.clear();
+	m_sources.clear();
+	m_hits   = 0;
+	m_misses = 0;
+}
+
+}        // namespace emt
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <emt/graphics/bindless_allocator.h>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace emt
+{
+// 한 frame 동안 같은 descriptor table (같은 source 가 같은 순서) 은 한 번만 copy
+//  - key 는 staging descriptor handle (generation 포함 : slot 이 재사용되면 다른 key)
+//  - value 는 shader visible heap 의 transient index, heap 과 같이 reset
+// hash 가 같아도 source 를 전부 비교 (충돌해도 잘못된 table 을 주지 않음)
+class descriptor_table_cache
+{
+public:
+	static uint64_t hash(std::span<const bindless_handle> sources);
+
+	bool find(std::span<const bindless_handle> sources, uint64_t hash, uint32_t* index);
+	void insert(std::span<const bindless_handle> sources, uint64_t hash, uint32_t index);
+	// 이번 frame 의 table 을 모두 버림 (capacity 는 유지)
+	void reset();
+
+	uint32_t size() const { return uint32_t(m_entries.size()); }
+	uint32_t hits() const { return m_hits; }        // 마지막 reset 이후
+	uint32_t misses() const { return m_misses; }
+
+private:
+	struct entry
+	{
+		uint32_t first;        // m_sources 안의 위치
+		uint32_t count;
+		uint32_t index;
+		uint32_t next;         // 같은 hash 의 다음 entry
+	};
+
+	static constexpr uint32_t end = ~0u;
+
+	std::unordered_map<uint64_t, uint32_t> m_buckets;        // hash -> 마지막에 넣은 entry
+	std::vector<entry>                     m_entries;
+	std::vector<bindless_handle>           m_sources;        // entry 의 key 를 이어 붙임
+	uint32_t                               m_hits{};
+	uint32_t                               m_misses{};
+};
+
+}        // namespace emt
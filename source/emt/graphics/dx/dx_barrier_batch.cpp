@@ -0,0 +1,156 @@
+#include "dx_barrier_batch.h"
+
+namespace emt
+{
+// clang-format off
+static const struct
+{
+	resource_state        state;
+	D3D12_RESOURCE_STATES legacy;
+	D3D12_BARRIER_SYNC    sync;
+	D3D12_BARRIER_ACCESS  access;
+	D3D12_BARRIER_LAYOUT  layout;
+} g_state_table[] = {
+	{resource_state::vertex_buffer,    D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, D3D12_BARRIER_SYNC_VERTEX_SHADING,  D3D12_BARRIER_ACCESS_VERTEX_BUFFER,        D3D12_BARRIER_LAYOUT_GENERIC_READ},
+	{resource_state::constant_buffer,  D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, D3D12_BARRIER_SYNC_ALL_SHADING,     D3D12_BARRIER_ACCESS_CONSTANT_BUFFER,      D3D12_BARRIER_LAYOUT_GENERIC_READ},
+	{resource_state::index_buffer,     D3D12_RESOURCE_STATE_INDEX_BUFFER,               D3D12_BARRIER_SYNC_INDEX_INPUT,      D3D12_BARRIER_ACCESS_INDEX_BUFFER,         D3D12_BARRIER_LAYOUT_GENERIC_READ},
+	{resource_state::render_target,    D3D12_RESOURCE_STATE_RENDER_TARGET,              D3D12_BARRIER_SYNC_RENDER_TARGET,    D3D12_BARRIER_ACCESS_RENDER_TARGET,        D3D12_BARRIER_LAYOUT_RENDER_TARGET},
+	{resource_state::unordered_access, D3D12_RESOURCE_STATE_UNORDERED_ACCESS,           D3D12_BARRIER_SYNC_ALL_SHADING,     D3D12_BARRIER_ACCESS_UNORDERED_ACCESS,     D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS},
+	{resource_state::depth_write,      D3D12_RESOURCE_STATE_DEPTH_WRITE,                D3D12_BARRIER_SYNC_DEPTH_STENCIL,    D3D12_BARRIER_ACCESS_DEPTH_STENCIL_WRITE,  D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_WRITE},
+	{resource_state::depth_read,       D3D12_RESOURCE_STATE_DEPTH_READ,                 D3D12_BARRIER_SYNC_DEPTH_STENCIL,    D3D12_BARRIER_ACCESS_DEPTH_STENCIL_READ,   D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ},
+	{resource_state::shader_read,      D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE,        D3D12_BARRIER_SYNC_ALL_SHADING,     D3D12_BARRIER_ACCESS_SHADER_RESOURCE,      D3D12_BARRIER_LAYOUT_SHADER_RESOURCE},
+	{resource_state::copy_dst,         D3D12_RESOURCE_STATE_COPY_DEST,                  D3D12_BARRIER_SYNC_COPY,             D3D12_BARRIER_ACCESS_COPY_DEST,            D3D12_BARRIER_LAYOUT_COPY_DEST},
+	{resource_state::copy_src,         D3D12_RESOURCE_STATE_COPY_SOURCE,                D3D12_BARRIER_SYNC_COPY,             D3D12_BARRIER_ACCESS_COPY_SOURCE,          D3D12_BARRIER_LAYOUT_COPY_SOURCE},
+	{resource_state::indirect,         D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT,          D3D12_BARRIER_SYNC_EXECUTE_INDIRECT, D3D12_BARRIER_ACCESS_INDIRECT_ARGUMENT,    D3D12_BARRIER_LAYOUT_GENERIC_READ},
+};
+// clang-format on
+
+D3D12_RESOURCE_STATES dx_resource_state(resource_state state)
+{
+	D3D12_RESOURCE_STATES out = D3D12_RESOURCE_STATE_COMMON;
+	for(const auto& e : g_state_table) {
+		if((state & e.state) == e.state)
+			out |= e.legacy;
+	}
+	return out;
+}
+
+dx_barrier_scope dx_barrier_scope_of(resource_state state)
+{
+	// common(present) : 이전 submit 의 작업은 이미 끝나 있으므로 sync 없음
+	if(state == resource_state::common)
+		return dx_barrier_scope{D3D12_BARRIER_SYNC_NONE, D3D12_BARRIER_ACCESS_NO_ACCESS, D3D12_BARRIER_LAYOUT_COMMON};
+
+	dx_barrier_scope out{D3D12_BARRIER_SYNC_NONE, D3D12_BARRIER_ACCESS_COMMON, D3D12_BARRIER_LAYOUT_UNDEFINED};
+	uint32_t         layouts = 0;
+	for(const auto& e : g_state_table) {
+		if((state & e.state) != e.state)
+			continue;
+		out.sync |= e.sync;
+		out.access |= e.access;
+		if(out.layout != e.layout)
+			++layouts;
+		out.layout = e.layout;
+	}
+
+	// 여러 read 를 합친 상태 : depth read 가 있으면 depth layout, 아니면 generic read
+	if(layouts > 1) {
+		out.layout = (state & resource_state::depth_read) == resource_state::depth_read
+		                 ? D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ
+		                 : D3D12_BARRIER_LAYOUT_GENERIC_READ;
+	}
+	return out;
+}
+
+bool dx_barrier_batch::query_enhanced_support(ID3D12Device* device)
+{
+	D3D12_FEATURE_DATA_D3D12_OPTIONS12 options12{};
+	if(FAILED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &options12, sizeof(options12))))
+		return false;
+	return options12.EnhancedBarriersSupported;
+}
+
+void dx_barrier_batch::add(ID3D12Resource* resource, uint32_t subresource, resource_state before, resource_state after)
+{
+	const bool buffer = resource->GetDesc().Dimension == D3D12_RESOURCE_DIMENSION_BUFFER;
+	m_entries.push_back(entry{resource, subresource, before, after, buffer});
+}
+
+void dx_barrier_batch::record(ID3D12GraphicsCommandList* cmd)
+{
+	if(m_entries.empty())
+		return;
+
+	ID3D12GraphicsCommandList7* cmd7 = nullptr;
+	if(s_enhanced && SUCCEEDED(cmd->QueryInterface(IID_PPV_ARGS(&cmd7)))) {
+		record_enhanced(cmd7);
+		safe_release(cmd7);
+	}
+	else {
+		record_legacy(cmd);
+	}
+	m_entries.clear();
+}
+
+void dx_barrier_batch::translate_legacy(const entry* entries, uint32_t count, std::vector<D3D12_RESOURCE_BARRIER>* out)
+{
+	out->clear();
+	for(uint32_t i = 0; i < count; ++i) {
+		const entry& e = entries[i];
+		if(e.before == e.after) {
+			out->push_back(CD3DX12_RESOURCE_BARRIER::UAV(e.resource));
+			continue;
+		}
+		const D3D12_RESOURCE_STATES before = dx_resource_state(e.before);
+		const D3D12_RESOURCE_STATES after  = dx_resource_state(e.after);
+		if(before == after)
+			continue;
+		out->push_back(CD3DX12_RESOURCE_BARRIER::Transition(e.resource, before, after, e.subresource));
+	}
+}
+
+void dx_barrier_batch::translate_enhanced(const entry* entries, uint32_t count, std::vector<D3D12_BUFFER_BARRIER>* buffers,
+                                          std::vector<D3D12_TEXTURE_BARRIER>* textures)
+{
+	buffers->clear();
+	textures->clear();
+	for(uint32_t i = 0; i < count; ++i) {
+		const entry&           e      = entries[i];
+		const dx_barrier_scope before = dx_barrier_scope_of(e.before);
+		const dx_barrier_scope after  = dx_barrier_scope_of(e.after);
+
+		if(e.buffer) {
+			// buffer 는 layout 이 없어 access 가 같으면 (read -> 같은 read) 생략
+			if(before.access == after.access && e.before != resource_state::unordered_access)
+				continue;
+			buffers->push_back(CD3DX12_BUFFER_BARRIER(before.sync, after.sync, before.access, after.access, e.resource));
+			continue;
+		}
+		textures->push_back(CD3DX12_TEXTURE_BARRIER(before.sync, after.sync, before.access, after.access,
+		                                            before.layout, after.layout, e.resource,
+		                                            CD3DX12_BARRIER_SUBRESOURCE_RANGE(e.subresource)));
+	}
+}
+
+void dx_barrier_batch::record_legacy(ID3D12GraphicsCommandList* cmd)
+{
+	translate_legacy(m_entries.data(), uint32_t(m_entries.size()), &m_legacy);
+	if(!m_legacy.empty())
+		cmd->ResourceBarrier(UINT(m_legacy.size()), m_legacy.data());
+}
+
+void dx_barrier_batch::record_enhanced(ID3D12GraphicsCommandList7* cmd)
+{
+	translate_enhanced(m_entries.data(), uint32_t(m_entries.size()), &m_buffers, &m_textures);
+
+	D3D12_BARRIER_GROUP groups[2]{};
+	UINT32              count = 0;
+	if(!m_buffers.empty())
+		groups[count++] = CD3DX12_BARRIER_GROUP(UINT32(m_buffers.size()), m_buffers.data());
+	if(!m_textures.empty())
+		groups[count++] = CD3DX12_BARRIER_GROUP(UINT32(m_textures.size()), m_textures.data());
+	if(count)
+		cmd->Barrier(count, groups);
+}
+
+}        // namespace emt
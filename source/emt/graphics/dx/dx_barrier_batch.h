@@ -0,0 +1,70 @@
+#pragma once
+
+#include "dx_config.h"
+#include <vector>
+
+namespace emt
+{
+// legacy D3D12_RESOURCE_STATES (read 상태는 합쳐짐)
+D3D12_RESOURCE_STATES dx_resource_state(resource_state state);
+
+// enhanced barrier 의 한쪽 (sync / access / layout)
+struct dx_barrier_scope
+{
+	D3D12_BARRIER_SYNC   sync;
+	D3D12_BARRIER_ACCESS access;
+	D3D12_BARRIER_LAYOUT layout;        // texture 만 의미 있음
+};
+dx_barrier_scope dx_barrier_scope_of(resource_state state);
+
+// Barriers gathered from engine states and recorded with one call.
+// Enhanced barriers (ID3D12GraphicsCommandList7::Barrier, one group for buffers
+// and one for textures) are used when the device supports them, otherwise the
+// legacy ResourceBarrier path. Buffers have no layout, so the enhanced path never
+// needs a COMMON round-trip for them.
+class dx_barrier_batch
+{
+public:
+	// device 생성 후 한 번 : CheckFeatureSupport(OPTIONS12) 결과로 선택
+	static bool query_enhanced_support(ID3D12Device* device);
+	static void use_enhanced(bool enable) { s_enhanced = enable; }
+	static bool enhanced() { return s_enhanced; }
+
+	struct entry
+	{
+		ID3D12Resource* resource;
+		uint32_t        subresource;
+		resource_state  before;
+		resource_state  after;
+		bool            buffer;        // enhanced 는 buffer 와 texture 를 다른 group 으로
+	};
+
+	// before == after == unordered_access : uav barrier
+	void add(ID3D12Resource* resource, uint32_t subresource, resource_state before, resource_state after);
+
+	bool     empty() const { return m_entries.empty(); }
+	uint32_t size() const { return uint32_t(m_entries.size()); }
+	void     clear() { m_entries.clear(); }
+
+	// 한 번의 api 호출로 기록 후 비움
+	void record(ID3D12GraphicsCommandList* cmd);
+
+	// entry -> api barrier 변환 (기록 없이, resource 는 dereference 하지 않음)
+	// 생략되는 전환 : legacy 는 같은 D3D12_RESOURCE_STATES, enhanced 는 access 가 같은 buffer
+	static void translate_legacy(const entry* entries, uint32_t count, std::vector<D3D12_RESOURCE_BARRIER>* out);
+	static void translate_enhanced(const entry* entries, uint32_t count, std::vector<D3D12_BUFFER_BARRIER>* buffers,
+	                               std::vector<D3D12_TEXTURE_BARRIER>* textures);
+
+private:
+	void record_legacy(ID3D12GraphicsCommandList* cmd);
+	void record_enhanced(ID3D12GraphicsCommandList7* cmd);
+
+	static inline bool s_enhanced = false;
+
+	std::vector<entry>                  m_entries;
+	std::vector<D3D12_RESOURCE_BARRIER> m_legacy;
+	std::vector<D3D12_BUFFER_BARRIER>   m_buffers;
+	std::vector<D3D12_TEXTURE_BARRIER>  m_textures;
+};
+
+}        // namespace emt
@@ -14,6 +14,7 @@ struct dx_buffer
 	ID3D12Resource*           handle{};
 	D3D12_GPU_VIRTUAL_ADDRESS gpu_addr{};
 	uint64_t                  size{};
+	uint64_t                  ready_value{};        // copy timeline value (0 : already usable)
 
 	union
 	{
@@ -0,0 +1,77 @@
+#include "dx_command_pool.h"
+
+namespace emt
+{
+dx_command_pool::dx_command_pool(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type, uint32_t capacity) :
+    m_device(device), m_type(type), m_capacity(capacity)
+{
+	m_entries = emt_new entry[capacity]{};
+}
+
+dx_command_pool::~dx_command_pool()
+{
+	for(uint32_t i = 0; i < m_capacity; ++i) {
+		safe_release(m_entries[i].list);
+		safe_release(m_entries[i].allocator);
+	}
+	safe_delete_array(m_entries);
+}
+
+void dx_command_pool::reset()
+{
+	for(uint32_t i = 0; i < m_capacity; ++i) {
+		entry& e = m_entries[i];
+		if(e.open) {
+			e.list->Close();
+			e.open = false;
+		}
+		if(e.allocator)
+			HR(e.allocator->Reset());
+	}
+}
+
+ID3D12GraphicsCommandList* dx_command_pool::open(uint32_t index)
+{
+	log_assert(index < m_capacity, "command pool index out of range");
+	entry& e = m_entries[index];
+	if(e.open)
+		return e.list;
+
+	if(!e.allocator) {
+		HR(m_device->CreateCommandAllocator(m_type, IID_PPV_ARGS(&e.allocator)));
+		HR(m_device->CreateCommandList(0, m_type, e.allocator, nullptr, IID_PPV_ARGS(&e.list)));
+	}
+	else {
+		HR(e.list->Reset(e.allocator, nullptr));
+	}
+	e.open = true;
+	return e.list;
+}
+
+ID3D12CommandList* dx_command_pool::close(uint32_t index)
+{
+	log_assert(index < m_capacity, "command pool index out of range");
+	entry& e = m_entries[index];
+	if(!e.open)
+		return nullptr;
+	HR(e.list->Close());
+	e.open = false;
+	return e.list;
+}
+
+uint32_t dx_command_pool::close_all(ID3D12CommandList** out, uint32_t cap)
+{
+	uint32_t count = 0;
+	for(uint32_t i = 0; i < m_capacity; ++i) {
+		entry& e = m_entries[i];
+		if(!e.open)
+			continue;
+		HR(e.list->Close());
+		e.open = false;
+		if(count < cap)
+			out[count++] = e.list;
+	}
+	return count;
+}
+
+}        // namespace emt
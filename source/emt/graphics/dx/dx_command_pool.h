@@ -0,0 +1,46 @@
+#pragma once
+
+#include "dx_config.h"
+
+namespace emt
+{
+// Fixed set of (allocator, command list) pairs owned by one frame slot.
+// Entries are created lazily on first open; distinct indices may be opened
+// from different threads at the same time without locking.
+// Lists are handed back in index order, so submit order never depends on thread timing.
+class dx_command_pool
+{
+public:
+	dx_command_pool(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type, uint32_t capacity);
+	~dx_command_pool();
+
+	dx_command_pool(const dx_command_pool&)            = delete;
+	dx_command_pool& operator=(const dx_command_pool&) = delete;
+
+	// 이전 frame 의 gpu 작업이 끝난 뒤 호출
+	void reset();
+
+	ID3D12GraphicsCommandList* open(uint32_t index);
+	// 열린 list 를 닫고 index 순서로 out 에 채움, 채운 수 반환
+	uint32_t close_all(ID3D12CommandList** out, uint32_t cap);
+	// 열려 있으면 닫아서 반환, 아니면 nullptr
+	ID3D12CommandList* close(uint32_t index);
+	bool               is_open(uint32_t index) const { return m_entries[index].open; }
+
+	uint32_t capacity() const { return m_capacity; }
+
+private:
+	struct entry
+	{
+		ID3D12CommandAllocator*    allocator{};
+		ID3D12GraphicsCommandList* list{};
+		bool                       open{};
+	};
+
+	ID3D12Device*           m_device{};
+	D3D12_COMMAND_LIST_TYPE m_type{D3D12_COMMAND_LIST_TYPE_DIRECT};
+	entry*                  m_entries{};
+	uint32_t                m_capacity{};
+};
+
+}        // namespace emt
@@ -1,5 +1,6 @@
 #include "dx_context_core.h"
 #include "dx_shader.h"
+#include <emt/graphics/hash.h>
 
 namespace emt
 {
@@ -12,14 +13,29 @@ static inline DXGI_SAMPLE_DESC sample1()
 	return s;
 }
 
-dx_context_core::dx_context_core(uint32_t cx, uint32_t cy, HWND hwnd) :
+static bool valid_backbuffer_count(uint32_t count)
+{
+	return count >= 2 && count <= DXGI_MAX_SWAP_CHAIN_BUFFERS;
+}
+
+dx_context_core::dx_context_core(uint32_t cx, uint32_t cy, HWND hwnd, const dx_context_config& config) :
     context(cx, cy, hwnd)
 {
 	m_width  = cx;
 	m_height = cy;
+	set_frames_in_flight(config.frames_in_flight);
 	initialize_core();
-	create_swapchain(hwnd, m_width, m_height, 3);
+	if(config.async_compute)
+		create_compute_queue();
+	uint32_t backbuffer_count = config.backbuffer_count;
+	if(!valid_backbuffer_count(backbuffer_count)) {
+		log_warn("invalid backbuffer count %u, using %u", backbuffer_count, MAX_BACKBUFFER_COUNT);
+		backbuffer_count = MAX_BACKBUFFER_COUNT;
+	}
+	create_swapchain(hwnd, m_width, m_height, backbuffer_count);
 	dx_shader_cache::initialize();
+	if(config.shader_hot_reload)
+		m_shader_reloader.initialize(&m_graphic_device, EMT_DATA_DIR "shader/");
 }
 
 dx_context_core::~dx_context_core()
@@ -30,33 +46,38 @@ dx_context_core::~dx_context_core()
 void dx_context_core::initialize_core()
 {
 	create_device_and_queue();
+	m_timeline.initialize(m_device, m_queue, L"GRAPHICS TIMELINE");
 
-	m_allow_tearing    = check_tearing_support();
-	m_frames_in_flight = MAX_SYNC_FRAME;
+	const bool enhanced_barriers = dx_barrier_batch::query_enhanced_support(m_device);
+	dx_barrier_batch::use_enhanced(enhanced_barriers);
+	log_info("barriers : %s", enhanced_barriers ? "enhanced" : "legacy");
+
+	m_allow_tearing = check_tearing_support();
 
 	create_frame_resources(m_frames_in_flight);
 
 	// 공용 graphics command list
 	HR(m_device->CreateCommandList(
 	    0, D3D12_COMMAND_LIST_TYPE_DIRECT,
-	    m_frames[0].allocator, /*PSO*/ nullptr,
+	    m_frames.at(0).payload.allocator, /*PSO*/ nullptr,
 	    IID_PPV_ARGS(&m_cmdlist)));
 	m_cmdlist->Close();        // Reset 전에 닫아둠
 
-	HR(m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_idle_fence)));
-	m_idle_fence->SetName(L"IDLE FENCE");
-	m_fence_event = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
-
-	m_graphic_device.initialize(m_device, m_queue);
+	m_graphic_device.initialize(m_device, m_queue, &m_timeline);
+	m_graphic_device.pipelines()->initialize(m_device, EMT_CACHE_DIR PIPELINE_CACHE_FILE, m_adapter_identity);
+	m_graphic_device.root_signatures()->initialize(m_device, m_graphic_device.pipelines(), EMT_CACHE_DIR ROOT_SIGNATURE_CACHE_FILE);
+	for(descriptor_chunk_cache& cache : m_worker_descriptors) {
+		cache.bind(m_graphic_device.cbv_srv_uav_heap()->chunks());
+	}
 }
 
 void dx_context_core::release()
 {
 	wait_idle();
+	m_shader_reloader.release();
 	dx_shader_cache::deinitialize();
 	m_graphic_device.release();
 
-	safe_release(m_idle_fence);
 	destroy_swapchain_resources();
 	safe_release(m_swapchain);
 
@@ -64,6 +85,9 @@ void dx_context_core::release()
 
 	safe_release(m_cmdlist);
 
+	m_compute_timeline.release();
+	safe_release(m_compute_queue);
+	m_timeline.release();
 	safe_release(m_queue);
 
 	// #ifdef _DEBUG
@@ -71,11 +95,6 @@ void dx_context_core::release()
 	// #endif
 	safe_release(m_device);
 	safe_release(m_factory);
-
-	if(m_fence_event) {
-		::CloseHandle(m_fence_event);
-		m_fence_event = nullptr;
-	}
 #ifdef _DEBUG
 	report_live_objects();
 #endif
@@ -85,7 +104,8 @@ void dx_context_core::resize_frame(uint32_t cx, uint32_t cy)
 {
 	if(!m_swapchain || cx == 0 || cy == 0)
 		return;
-	wait_idle();
+	// ResizeBuffers 는 backbuffer 참조가 없어야 하므로 마지막 present 까지만 대기
+	m_timeline.wait(m_timeline.last_signaled());
 
 	log_debug("resize context %d : %d", cx, cy);
 
@@ -98,23 +118,37 @@ void dx_context_core::resize_frame(uint32_t cx, uint32_t cy)
 	HR(m_swapchain->ResizeBuffers(
 	    m_backbuffer_count, m_width, m_height, DXGI_FORMAT_R8G8B8A8_UNORM, flags));
 
-	// RTV heap
-	m_rtv_desc_size = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
-	D3D12_DESCRIPTOR_HEAP_DESC rtvDesc{};
-	rtvDesc.NumDescriptors = m_backbuffer_count;
-	rtvDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-	rtvDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-	HR(m_device->CreateDescriptorHeap(&rtvDesc, IID_PPV_ARGS(&m_rtv_heap)));
+	create_rtv_and_backbuffers();
+}
 
-	m_backbuffers = new ID3D12Resource* [m_backbuffer_count] {};
-	for(UINT i = 0; i < m_backbuffer_count; ++i) {
-		HR(m_swapchain->GetBuffer(i, IID_PPV_ARGS(&m_backbuffers[i])));
-		D3D12_CPU_DESCRIPTOR_HANDLE h = m_rtv_heap->GetCPUDescriptorHandleForHeapStart();
-		h.ptr += SIZE_T(i) * m_rtv_desc_size;
-		m_device->CreateRenderTargetView(m_backbuffers[i], nullptr, h);
+void dx_context_core::set_frames_in_flight(uint32_t count)
+{
+	if(count == 0) {
+		log_warn("frames in flight must be at least 1");
+		count = 1;
+	}
+	if(count > MAX_FRAMES_IN_FLIGHT) {
+		log_warn("frames in flight %u exceeds %u", count, MAX_FRAMES_IN_FLIGHT);
+		count = MAX_FRAMES_IN_FLIGHT;
 	}
+	m_frames_in_flight = count;
+}
 
-	m_backbuffer_index = m_swapchain->GetCurrentBackBufferIndex();
+void dx_context_core::set_backbuffer_count(uint32_t count)
+{
+	if(!valid_backbuffer_count(count)) {
+		log_warn("invalid backbuffer count %u", count);
+		return;
+	}
+	if(count == m_backbuffer_count)
+		return;
+	m_backbuffer_count = count;
+	// 버퍼 수가 바뀌면 ResizeBuffers 가 필요 -> resize 경로 재사용
+	if(m_swapchain && m_width && m_height) {
+		uint32_t cx = m_width;
+		uint32_t cy = m_height;
+		resize_frame(cx, cy);
+	}
 }
 
 void dx_context_core::begin_frame()
@@ -123,41 +157,85 @@ void dx_context_core::begin_frame()
 		log_debug("wait for frame latency");
 		::WaitForSingleObject(m_frame_latency_waitable, INFINITE);
 	}
-	frame_resources& fr = m_frames[m_frame_index];
-
-	if(fr.fence && fr.fence->GetCompletedValue() < fr.fence_value) {
-		HR(fr.fence->SetEventOnCompletion(fr.fence_value, m_fence_event));
-		::WaitForSingleObject(m_fence_event, INFINITE);
+	apply_frames_in_flight();
+
+	frame_resources& fr = m_frames.current().payload;
+
+	// 이 slot 의 마지막 submit 완료 대기 + 완료된 callback 실행
+	m_timeline.wait(m_frames.wait_value());
+	m_graphic_device.collect_releases(m_timeline.completed());
+	m_queue_sync.retire(queue_graphics, m_timeline.completed());
+	if(m_compute_queue) {
+		m_compute_timeline.wait(fr.compute_value);
+		m_queue_sync.retire(queue_compute, m_compute_timeline.completed());
+		fr.compute->reset();
+		fr.compute_fixups->reset();
 	}
 
-	descriptor_heap_gpu* gpu_heap = m_graphic_device.cbv_srv_uav_heap();
-	gpu_heap->reset();
-
 	HR(fr.allocator->Reset());
 	HR(m_cmdlist->Reset(fr.allocator, nullptr));
+	fr.workers->reset();
+	fr.fixups->reset();
+	m_states.reset();
+	for(dx_state_tracker& tracker : m_worker_states) {
+		tracker.reset();
+	}
+	for(dx_state_tracker& tracker : m_compute_states) {
+		tracker.reset();
+	}
+	// source 는 collect_releases 에서 invalidate, 남은 chunk 도 버림
+	for(descriptor_chunk_cache& cache : m_worker_descriptors) {
+		cache.reset();
+	}
 
-	D3D12_RESOURCE_BARRIER b{};
-	b.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-	b.Transition.pResource   = m_backbuffers[m_backbuffer_index];
-	b.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-	b.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
-	b.Transition.StateAfter  = D3D12_RESOURCE_STATE_RENDER_TARGET;
-	m_cmdlist->ResourceBarrier(1, &b);
+	// backbuffer transition 은 graph 가 실제 사용에 맞춰 유도
+	m_graph.reset();
+	m_backbuffer_handle = m_graph.import_resource("backbuffer", m_backbuffers[m_backbuffer_index],
+	                                              resource_state::present, resource_state::present);
 }
 
 void dx_context_core::end_frame(bool vsync)
 {
-	D3D12_RESOURCE_BARRIER b{};
-	b.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-	b.Transition.pResource   = m_backbuffers[m_backbuffer_index];
-	b.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-	b.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-	b.Transition.StateAfter  = D3D12_RESOURCE_STATE_PRESENT;
-	m_cmdlist->ResourceBarrier(1, &b);
+	frame_resources& fr = m_frames.current().payload;
+
+	if(!m_graph.execute(m_cmdlist)) {
+		log_error("render graph compile failed, frame passes skipped");
+	}
 
+	// submit 순서대로 tracker 를 resolve : 필요한 상태 보정은 해당 list 바로 앞의 fixup list 로
+	ID3D12CommandList* lists[2 * (MAX_RECORD_WORKERS + 1) + 1]{};
+	uint32_t           list_count = 0;
+	m_states.flush(m_cmdlist);
+	resolve_states(fr.fixups, 0, &m_states, lists, &list_count);
+	lists[list_count++] = m_cmdlist;
+
+	bool workers_used = false;
+	for(uint32_t w = 0; w < MAX_RECORD_WORKERS; ++w) {
+		if(!fr.workers->is_open(w))
+			continue;
+		m_worker_states[w].flush(fr.workers->open(w));
+		resolve_states(fr.fixups, w + 1, &m_worker_states[w], lists, &list_count);
+		lists[list_count++] = fr.workers->close(w);
+		workers_used        = true;
+	}
+
+	// worker list 가 있으면 present barrier 는 모든 worker 뒤의 epilogue list 에 기록
+	ID3D12GraphicsCommandList* tail = workers_used ? fr.workers->open(MAX_RECORD_WORKERS) : m_cmdlist;
+	m_graph.record_final_barriers(tail);
 	HR(m_cmdlist->Close());
-	ID3D12CommandList* lists[] = {m_cmdlist};
-	m_queue->ExecuteCommandLists(1, lists);
+	if(tail != m_cmdlist) {
+		lists[list_count++] = fr.workers->close(MAX_RECORD_WORKERS);
+	}
+
+	// 이번 frame 에 처음 쓰인 async upload 는 gpu 에서만 대기
+	m_graphic_device.flush_uploads();
+	m_graphic_device.submit_queue_waits(m_queue);
+	if(m_pending_compute_wait && m_queue_sync.require(queue_graphics, queue_compute, m_pending_compute_wait)) {
+		m_compute_timeline.gpu_wait(m_queue, m_pending_compute_wait);
+	}
+	m_pending_compute_wait = 0;
+
+	m_queue->ExecuteCommandLists(list_count, lists);
 
 	UINT sync_interval = vsync ? 1 : 0;
 	UINT present_flags = (!vsync && m_allow_tearing) ? DXGI_PRESENT_ALLOW_TEARING : 0;
@@ -169,26 +247,98 @@ void dx_context_core::end_frame(bool vsync)
 	}
 	HR(hr);
 
-	frame_resources& fr = m_frames[m_frame_index];
-	if(!fr.fence)
-		HR(m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fr.fence)));
-	const UINT64 signalValue = fr.fence_value + 1;
-	HR(m_queue->Signal(fr.fence, signalValue));
-	fr.fence_value = signalValue;
+	const uint64_t frame_value = m_timeline.signal();
+	// frame 중에 tag 한 값 (transient descriptor, bindless, defer release) 과 같아야 함
+	log_assert(frame_value == m_graphic_device.frame_value(), "graphics timeline signaled outside end_frame");
+	m_queue_sync.on_signal(queue_graphics, frame_value);
+	m_frames.advance(frame_value);
 
-	m_frame_index      = (m_frame_index + 1) % m_frames_in_flight;
 	m_backbuffer_index = m_swapchain->GetCurrentBackBufferIndex();
 }
 
 void dx_context_core::wait_idle()
 {
-	if(!m_queue || !m_idle_fence || !m_fence_event) {
-		return;
+	// graphics 는 새 값을 signal 하지 않음 : frame 중에 불려도 이번 frame 의 tag 가 일찍 풀리지 않음
+	m_compute_timeline.wait_idle();
+	m_graphic_device.wait_idle();
+}
+
+ID3D12GraphicsCommandList* dx_context_core::compute_command_list(uint32_t index)
+{
+	log_assert(m_compute_queue, "async compute is not enabled");
+	log_assert(index < MAX_RECORD_WORKERS, "compute list index out of range");
+	return m_frames.current().payload.compute->open(index);
+}
+
+uint64_t dx_context_core::submit_compute(uint64_t wait_graphics)
+{
+	frame_resources& fr = m_frames.current().payload;
+
+	// graphics 와 같은 registry 를 submit 순서대로 : 보정은 각 compute list 바로 앞의 fixup list 로
+	ID3D12CommandList* lists[2 * MAX_RECORD_WORKERS]{};
+	uint32_t           count = 0;
+	for(uint32_t i = 0; i < MAX_RECORD_WORKERS; ++i) {
+		if(!fr.compute->is_open(i))
+			continue;
+		m_compute_states[i].flush(fr.compute->open(i));
+		resolve_states(fr.compute_fixups, i, &m_compute_states[i], lists, &count);
+		lists[count++] = fr.compute->close(i);
+		m_compute_states[i].reset();
+	}
+	if(count == 0)
+		return fr.compute_value;
+
+	// 아직 signal 전인 graphics 값도 gpu Wait 는 가능 (end_frame 에서 signal 됨)
+	if(m_queue_sync.require(queue_compute, queue_graphics, wait_graphics)) {
+		m_timeline.gpu_wait(m_compute_queue, wait_graphics);
 	}
-	const uint64_t val = ++m_idle_value;
-	HR(m_queue->Signal(m_idle_fence, val));
-	HR(m_idle_fence->SetEventOnCompletion(val, m_fence_event));
-	::WaitForSingleObject(m_fence_event, INFINITE);
+	m_compute_queue->ExecuteCommandLists(count, lists);
+
+	const uint64_t value = m_compute_timeline.signal();
+	m_queue_sync.on_signal(queue_compute, value);
+	fr.compute_value = value;
+	return value;
+}
+
+void dx_context_core::graphics_wait_compute(uint64_t value)
+{
+	if(value > m_pending_compute_wait)
+		m_pending_compute_wait = value;
+}
+
+dx_state_tracker* dx_context_core::compute_state_tracker(uint32_t index)
+{
+	log_assert(m_compute_queue, "async compute is not enabled");
+	log_assert(index < MAX_RECORD_WORKERS, "compute list index out of range");
+	return &m_compute_states[index];
+}
+
+dx_state_tracker* dx_context_core::worker_state_tracker(uint32_t worker)
+{
+	log_assert(worker < MAX_RECORD_WORKERS, "worker index out of range");
+	return &m_worker_states[worker];
+}
+
+void dx_context_core::resolve_states(dx_command_pool* fixups, uint32_t slot, dx_state_tracker* tracker,
+                                     ID3D12CommandList** lists, uint32_t* count)
+{
+	if(!tracker->resolve(m_graphic_device.states(), &m_fixups))
+		return;
+	ID3D12GraphicsCommandList* fixup = fixups->open(slot);
+	m_fixups.record(fixup);
+	lists[(*count)++] = fixups->close(slot);
+}
+
+ID3D12GraphicsCommandList* dx_context_core::worker_command_list(uint32_t worker)
+{
+	log_assert(worker < MAX_RECORD_WORKERS, "worker index out of range");
+	return m_frames.current().payload.workers->open(worker);
+}
+
+descriptor_heap_gpu::alloc_out dx_context_core::worker_descriptors(uint32_t worker, UINT count)
+{
+	log_assert(worker < MAX_RECORD_WORKERS, "worker index out of range");
+	return m_graphic_device.cbv_srv_uav_heap()->alloc(&m_worker_descriptors[worker], count);
 }
 
 D3D12_CPU_DESCRIPTOR_HANDLE dx_context_core::rtv_handle(UINT buffer_index) const
@@ -201,6 +351,15 @@ D3D12_CPU_DESCRIPTOR_HANDLE dx_context_core::rtv_handle(UINT buffer_index) const
 	return h;
 }
 
+dx_render_target dx_context_core::backbuffer_target() const
+{
+	dx_render_target target;
+	target.view     = rtv_handle(m_backbuffer_index);
+	target.resource = m_backbuffers ? m_backbuffers[m_backbuffer_index] : nullptr;
+	target.format   = DXGI_FORMAT_R8G8B8A8_UNORM;
+	return target;
+}
+
 // ===== internal =====
 
 bool dx_context_core::check_tearing_support() const
@@ -260,6 +419,21 @@ void dx_context_core::create_device_and_queue()
 	}
 
 	HR(hr);
+
+	// 같은 gpu + driver 에서만 disk cache 를 재사용
+	if(adapter) {
+		DXGI_ADAPTER_DESC1 desc{};
+		LARGE_INTEGER      umd_version{};
+		adapter->GetDesc1(&desc);
+		adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &umd_version);
+		m_adapter_identity = stable_hasher()
+		                         .add(desc.VendorId)
+		                         .add(desc.DeviceId)
+		                         .add(desc.SubSysId)
+		                         .add(desc.Revision)
+		                         .add(umd_version.QuadPart)
+		                         .value();
+	}
 	safe_release(adapter);
 
 	// HR(D3D12CreateDevice(adapter, D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&m_device)));
@@ -271,21 +445,81 @@ void dx_context_core::create_device_and_queue()
 	HR(m_device->CreateCommandQueue(&qd, IID_PPV_ARGS(&m_queue)));
 }
 
+void dx_context_core::create_compute_queue()
+{
+	D3D12_COMMAND_QUEUE_DESC qd{};
+	qd.Type  = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+	qd.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+	HR(m_device->CreateCommandQueue(&qd, IID_PPV_ARGS(&m_compute_queue)));
+	m_compute_queue->SetName(L"COMPUTE QUEUE");
+	m_compute_timeline.initialize(m_device, m_compute_queue, L"COMPUTE TIMELINE");
+
+	// 이미 만들어진 slot 에도 compute allocator 추가
+	for(uint32_t i = 0; i < m_frames.size(); ++i) {
+		frame_resources& fr = m_frames.at(i).payload;
+		fr.compute          = emt_new dx_command_pool(m_device, D3D12_COMMAND_LIST_TYPE_COMPUTE, MAX_RECORD_WORKERS);
+		fr.compute_fixups   = emt_new dx_command_pool(m_device, D3D12_COMMAND_LIST_TYPE_COMPUTE, MAX_RECORD_WORKERS);
+	}
+}
+
 void dx_context_core::create_frame_resources(UINT frames)
 {
 	destroy_frame_resources();
-	m_frames           = new frame_resources[frames]{};
 	m_frames_in_flight = frames;
 
 	for(UINT i = 0; i < frames; ++i) {
-		HR(m_device->CreateCommandAllocator(
-		    D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_frames[i].allocator)));
-		HR(m_device->CreateFence(
-		    0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_frames[i].fence)));
-		m_frames[i].fence_value = 0;
+		frame_resources fr{};
+		create_frame_slot(&fr);
+		m_frames.push(fr);
 	}
 }
 
+void dx_context_core::create_frame_slot(frame_resources* fr)
+{
+	HR(m_device->CreateCommandAllocator(
+	    D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&fr->allocator)));
+	// 마지막 하나는 end_frame 의 epilogue barrier 용
+	fr->workers = emt_new dx_command_pool(m_device, D3D12_COMMAND_LIST_TYPE_DIRECT, MAX_RECORD_WORKERS + 1);
+	// [0] main list, [1 + worker] worker list 앞의 상태 보정
+	fr->fixups = emt_new dx_command_pool(m_device, D3D12_COMMAND_LIST_TYPE_DIRECT, MAX_RECORD_WORKERS + 1);
+	if(m_compute_queue) {
+		fr->compute        = emt_new dx_command_pool(m_device, D3D12_COMMAND_LIST_TYPE_COMPUTE, MAX_RECORD_WORKERS);
+		fr->compute_fixups = emt_new dx_command_pool(m_device, D3D12_COMMAND_LIST_TYPE_COMPUTE, MAX_RECORD_WORKERS);
+	}
+}
+
+void dx_context_core::release_frame_slot(frame_resources* fr)
+{
+	if(fr->compute) {
+		// graphics fence 와 별개로 compute submit 도 끝나야 allocator 해제 가능
+		m_compute_timeline.wait(fr->compute_value);
+		safe_delete(fr->compute_fixups);
+		safe_delete(fr->compute);
+	}
+	safe_delete(fr->fixups);
+	safe_delete(fr->workers);
+	safe_release(fr->allocator);
+}
+
+void dx_context_core::apply_frames_in_flight()
+{
+	// 줄어든 slot 은 fence 가 끝난 뒤에 해제
+	m_frames.collect_retired(m_timeline.poll(), [this](frame_resources& fr) {
+		release_frame_slot(&fr);
+	});
+
+	if(m_frames_in_flight == m_frames.size())
+		return;
+
+	log_debug("frames in flight %u -> %u", m_frames.size(), m_frames_in_flight);
+	while(m_frames.size() < m_frames_in_flight) {
+		frame_resources fr{};
+		create_frame_slot(&fr);
+		m_frames.push(fr);
+	}
+	m_frames.shrink(m_frames_in_flight);
+}
+
 void dx_context_core::create_swapchain(HWND hwnd, UINT w, UINT h, UINT buffer_count)
 {
 	m_backbuffer_count = buffer_count;
@@ -323,6 +557,11 @@ void dx_context_core::create_swapchain(HWND hwnd, UINT w, UINT h, UINT buffer_co
 	// }
 
 	// RTV heap & backbuffers
+	create_rtv_and_backbuffers();
+}
+
+void dx_context_core::create_rtv_and_backbuffers()
+{
 	m_rtv_desc_size = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 
 	D3D12_DESCRIPTOR_HEAP_DESC rtvDesc{};
@@ -340,24 +579,18 @@ void dx_context_core::create_swapchain(HWND hwnd, UINT w, UINT h, UINT buffer_co
 	}
 
 	m_backbuffer_index = m_swapchain->GetCurrentBackBufferIndex();
-	m_frame_index      = 0;
 }
 
 void dx_context_core::destroy_frame_resources()
 {
-	if(m_frames) {
-		for(UINT i = 0; i < m_frames_in_flight; ++i) {
-			m_cmdlist->Reset(m_frames[i].allocator, nullptr);
+	m_frames.clear([this](frame_resources& fr) {
+		if(m_cmdlist) {
+			m_cmdlist->Reset(fr.allocator, nullptr);
 			m_cmdlist->ClearState(nullptr);
-
 			m_cmdlist->Close();
-			safe_release(m_frames[i].allocator);
-			safe_release(m_frames[i].fence);
 		}
-		delete[] m_frames;
-		m_frames = nullptr;
-	}
-	m_frames_in_flight = 0;
+		release_frame_slot(&fr);
+	});
 }
 
 void dx_context_core::destroy_swapchain_resources()
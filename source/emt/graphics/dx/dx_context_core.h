@@ -3,14 +3,29 @@
 #include <emt/graphics/context.h>
 #include "dx_config.h"
 #include "dx_device.h"
+#include "dx_timeline.h"
+#include "dx_command_pool.h"
+#include "dx_render_graph.h"
+#include "dx_render_pass.h"
+#include "dx_shader_reloader.h"
+#include <emt/graphics/frame_ring.h>
+#include <emt/graphics/queue_sync.h>
 
 namespace emt
 {
 
+struct dx_context_config
+{
+	uint32_t frames_in_flight  = MAX_SYNC_FRAME;
+	uint32_t backbuffer_count  = MAX_BACKBUFFER_COUNT;
+	bool     async_compute     = false;        // 별도 compute queue 생성
+	bool     shader_hot_reload = true;         // EMT_DATA_DIR/shader 감시, 바뀐 shader 만 다시 compile
+};
+
 class dx_context_core : public context
 {
 public:
-	dx_context_core(uint32_t cx, uint32_t cy, HWND hwnd);
+	dx_context_core(uint32_t cx, uint32_t cy, HWND hwnd, const dx_context_config& config = {});
 	~dx_context_core();
 
 	// 리사이즈(스왑체인 재생성)
@@ -23,32 +38,79 @@ public:
 	// 대기
 	void wait_idle();
 
+	// frames in flight 은 다음 begin_frame 에서 대기 없이 적용
+	void set_frames_in_flight(uint32_t count);
+	// backbuffer 수 변경은 ResizeBuffers 가 필요하므로 즉시 swapchain 을 재구성
+	void set_backbuffer_count(uint32_t count);
+
 	// getters
 	IDXGIFactory4*             factory() const { return m_factory; }
 	ID3D12Device*              device() const { return m_device; }
 	ID3D12CommandQueue*        queue() const { return m_queue; }
+	dx_timeline*               timeline() { return &m_timeline; }
 	ID3D12GraphicsCommandList* get_current_command_list() const { return m_cmdlist; }
+	// 이번 frame 의 render graph, backbuffer 는 begin_frame 에서 import 됨 (present -> present)
+	// pass 는 end_frame 에서 main list 에 기록
+	dx_render_graph* graph() { return &m_graph; }
+	rg_handle        backbuffer() const { return m_backbuffer_handle; }
+	// 상태 tracker : 필요한 상태만 require, draw/dispatch 직전에 flush
+	// list 간의 상태는 end_frame 에서 submit 순서대로 맞춰짐
+	dx_state_tracker* state_tracker() { return &m_states; }
+	dx_state_tracker* worker_state_tracker(uint32_t worker);
+	// 병렬 기록용 : worker 마다 다른 index 를 쓰면 lock 없이 여러 thread 에서 호출 가능
+	// graph pass 다음에 index 순서로 submit 되며 graph 가 남긴 상태를 그대로 봄
+	// (begin_frame ~ end_frame 사이에서만 유효)
+	ID3D12GraphicsCommandList* worker_command_list(uint32_t worker);
+	// worker 의 transient descriptor (cbv/srv/uav heap) : worker_command_list 와 같은 규칙, lock 없이 chunk 에서
+	descriptor_heap_gpu::alloc_out worker_descriptors(uint32_t worker, UINT count = 1);
 	IDXGISwapChain3*           swapchain() const { return m_swapchain; }
 
+	// async compute : 의존성은 항상 queue Wait (gpu) 로만 표현, cpu 대기 없음
+	bool                       async_compute() const { return m_compute_queue != nullptr; }
+	ID3D12CommandQueue*        compute_queue() const { return m_compute_queue; }
+	dx_timeline*               compute_timeline() { return &m_compute_timeline; }
+	ID3D12GraphicsCommandList* compute_command_list(uint32_t index = 0);
+	// compute list 의 상태 tracker : submit_compute 에서 submit 순서대로 resolve
+	// (render_target 처럼 graphics 전용 상태는 graphics queue 에서 미리 벗어나 있어야 함)
+	dx_state_tracker*          compute_state_tracker(uint32_t index = 0);
+	// 열린 compute list 를 제출, wait_graphics 가 있으면 그 graphics 값 이후에 실행 -> compute value 반환
+	uint64_t submit_compute(uint64_t wait_graphics = 0);
+	// 다음 graphics submit 이 compute value 이후에 실행되도록 예약
+	void graphics_wait_compute(uint64_t value);
+
 	ID3D12DescriptorHeap*       rtv_heap() const { return m_rtv_heap; }
 	D3D12_CPU_DESCRIPTOR_HANDLE rtv_handle(UINT buffer_index) const;
+	dx_render_target            backbuffer_target() const;        // 현재 backbuffer 의 rtv/resource/format
 	UINT                        rtv_descriptor_size() const { return m_rtv_desc_size; }
 	UINT                        backbuffer_count() const { return m_backbuffer_count; }
-	UINT                        frame_index() const { return m_frame_index; }
+	UINT                        frame_index() const { return m_frames.index(); }
+	uint32_t                    frames_in_flight() const { return m_frames.size(); }
 	uint32_t                    backbuffer_index() const { return m_backbuffer_index; }
 	bool                        tearing_supported() const { return m_allow_tearing; }
+	uint64_t                    adapter_identity() const { return m_adapter_identity; }
 	const dx_device*            graphic_device() const { return &m_graphic_device; }
 	dx_device*                  graphic_device() { return &m_graphic_device; }
+	// frame 마다 begin_frame 전에 update (job_system) 호출
+	dx_shader_reloader*         shader_reloader() { return &m_shader_reloader; }
 
 private:
 	struct frame_resources
 	{
-		ID3D12CommandAllocator* allocator   = nullptr;
-		ID3D12Fence*            fence       = nullptr;
-		uint64_t                fence_value = 0;
+		ID3D12CommandAllocator* allocator      = nullptr;
+		dx_command_pool*        workers        = nullptr;        // [0, MAX_RECORD_WORKERS) + epilogue
+		dx_command_pool*        fixups         = nullptr;        // main + worker 별 상태 보정
+		dx_command_pool*        compute        = nullptr;        // async compute 일 때만
+		dx_command_pool*        compute_fixups = nullptr;        // compute list 별 상태 보정
+		uint64_t                compute_value  = 0;
+	};
+	enum : uint32_t {
+		queue_graphics,
+		queue_compute,
+		queue_count
 	};
-	dx_device m_graphic_device{};
-	HANDLE    m_frame_latency_waitable = nullptr;
+	dx_device          m_graphic_device{};
+	dx_shader_reloader m_shader_reloader;
+	HANDLE             m_frame_latency_waitable = nullptr;
 
 private:
 	// 내부 유틸
@@ -57,7 +119,14 @@ private:
 	void create_swapchain(HWND hwnd, UINT w, UINT h, UINT buffer_count);
 	bool check_tearing_support() const;
 	void create_device_and_queue();
+	void create_compute_queue();
+	void resolve_states(dx_command_pool* fixups, uint32_t slot, dx_state_tracker* tracker,
+	                    ID3D12CommandList** lists, uint32_t* count);
 	void create_frame_resources(UINT frames);
+	void apply_frames_in_flight();
+	void create_frame_slot(frame_resources* fr);
+	void release_frame_slot(frame_resources* fr);
+	void create_rtv_and_backbuffers();
 
 	void destroy_frame_resources();
 	void destroy_swapchain_resources();
@@ -70,16 +139,29 @@ private:
 	ID3D12CommandQueue* m_queue   = nullptr;
 
 	// command recording
-	ID3D12GraphicsCommandList* m_cmdlist          = nullptr;
-	frame_resources*           m_frames           = nullptr;
-	uint32_t                   m_frames_in_flight = 0;
-	uint32_t                   m_frame_index      = 0;
-	uint32_t                   m_backbuffer_index = 0;
-
-	// sync
-	HANDLE       m_fence_event = nullptr;
-	ID3D12Fence* m_idle_fence  = nullptr;
-	uint64_t     m_idle_value  = 0;
+	ID3D12GraphicsCommandList*  m_cmdlist          = nullptr;
+	frame_ring<frame_resources> m_frames;
+	uint32_t                    m_frames_in_flight = 0;        // requested, applied in begin_frame
+	uint32_t                    m_backbuffer_index = 0;
+
+	// sync : graphics queue timeline
+	dx_timeline m_timeline;
+
+	dx_render_graph m_graph;
+	rg_handle       m_backbuffer_handle{};
+
+	// resource 상태 : main list 와 worker list 마다 하나씩, worker 는 descriptor chunk 도
+	dx_state_tracker       m_states;
+	dx_state_tracker       m_worker_states[MAX_RECORD_WORKERS];
+	descriptor_chunk_cache m_worker_descriptors[MAX_RECORD_WORKERS];
+	dx_barrier_batch       m_fixups;
+
+	// async compute
+	dx_state_tracker    m_compute_states[MAX_RECORD_WORKERS];
+	ID3D12CommandQueue* m_compute_queue = nullptr;
+	dx_timeline         m_compute_timeline;
+	queue_sync          m_queue_sync{queue_count};
+	uint64_t            m_pending_compute_wait = 0;
 
 	// swapchain & rtv
 	IDXGISwapChain3*      m_swapchain        = nullptr;
@@ -91,7 +173,8 @@ private:
 	uint32_t              m_height           = 0;
 
 	// features
-	bool m_allow_tearing = false;
+	bool     m_allow_tearing    = false;
+	uint64_t m_adapter_identity = 0;        // vendor/device/driver, disk cache 검증용
 };
 
 }        // namespace emt
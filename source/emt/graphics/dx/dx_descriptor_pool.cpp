@@ -11,38 +11,44 @@ void dx_descriptor_pool::initialize(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_
 
 	HR(device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&heap)));
 
-	cap    = capacity;
 	stride = device->GetDescriptorHandleIncrementSize(type);
 	cpu    = heap->GetCPUDescriptorHandleForHeapStart();
 	gpu    = heap->GetGPUDescriptorHandleForHeapStart();
-	next   = 0;
+	ring.initialize(capacity);
 }
 
 void dx_descriptor_pool::release()
 {
 	safe_release(heap);
-	cap = stride = next = 0;
-	cpu                 = {};
-	gpu                 = {};
+	ring.initialize(0);
+	stride = 0;
+	cpu    = {};
+	gpu    = {};
 }
 
-void dx_descriptor_pool::reset_frame()
+void dx_descriptor_pool::retire(uint64_t completed_value)
 {
-	next = 0;
+	ring.retire([completed_value](const ring_fence& fence) {
+		return fence.value <= completed_value;
+	});
 }
 
-dx_descriptor_handle dx_descriptor_pool::alloc_handle(uint32_t count)
+dx_descriptor_handle dx_descriptor_pool::alloc_handle(uint64_t fence_value, uint32_t count)
 {
 	dx_descriptor_handle handle{};
-	if(!heap || next + count > cap) {
+	if(!heap) {
 		return handle;
 	}
 
-	uint32_t offset = next * stride;
+	const uint64_t next = ring.allocate(count, 1, ring_fence{0, fence_value});
+	if(next == ring_allocator::invalid) {
+		return handle;
+	}
+
+	uint64_t offset = next * stride;
 	handle.cpu.ptr  = cpu.ptr + offset;
 	handle.gpu.ptr  = gpu.ptr + offset;
-	handle.index    = next;
-	next += count;
+	handle.index    = uint32_t(next);
 
 	return handle;
 }
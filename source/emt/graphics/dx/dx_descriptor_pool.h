@@ -1,6 +1,7 @@
 #pragma once
 
 #include "dx_config.h"
+#include <emt/graphics/ring_allocator.h>
 
 namespace emt
 {
@@ -11,20 +12,22 @@ struct dx_descriptor_handle
 	uint32_t                    index;
 };
 
+// shader visible ring : alloc 은 소비하는 queue 의 fence 값으로 tag, retire 에서 완료된 것만 재사용
+// 한 thread 에서만 (병렬 기록은 descriptor_heap_gpu 의 chunk cache)
 struct dx_descriptor_pool
 {
 	void initialize(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t capacity);
 	void release();
-	void reset_frame();
+	void retire(uint64_t completed_value);
 
-	dx_descriptor_handle alloc_handle(uint32_t count = 1);
+	// 가득 차면 cpu.ptr == 0
+	dx_descriptor_handle alloc_handle(uint64_t fence_value, uint32_t count = 1);
 
 	ID3D12DescriptorHeap*       heap{};
 	uint32_t                    stride{};
 	D3D12_CPU_DESCRIPTOR_HANDLE cpu{};
 	D3D12_GPU_DESCRIPTOR_HANDLE gpu{};
-	uint32_t                    next{};
-	uint32_t                    cap{};
+	ring_allocator              ring;
 };
 
 }        // namespace emt
@@ -1,160 +1,624 @@
 #include "dx_device.h"
 #include "dx_buffer.h"
+#include <emt/graphics/hash.h>
+#include <algorithm>
 
 namespace emt
 {
 
+// ===== descriptor_heap_cpu =====
+void descriptor_heap_cpu::create(ID3D12Device* dev, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT capacity)
+{
+	release();
+	m_type = type;
+	D3D12_DESCRIPTOR_HEAP_DESC desc{};
+	desc.Type           = type;
+	desc.NumDescriptors = capacity;
+	desc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+	HR(dev->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&m_heap)));
+	m_heap->SetName(L"STAGING DESCRIPTORS");
+	m_stride = dev->GetDescriptorHandleIncrementSize(type);
+	m_cpu    = m_heap->GetCPUDescriptorHandleForHeapStart();
+	m_slots.initialize(0, capacity);
+	m_slot_views.resize(capacity);
+}
+
+void descriptor_heap_cpu::release()
+{
+	safe_release(m_heap);
+	m_slots.release();
+	m_slot_views.clear();
+	m_views.clear();
+	m_stride = 0;
+	m_cpu    = {};
+}
+
+staging_descriptor descriptor_heap_cpu::acquire(std::span<const uint8_t> key, bool* created)
+{
+	const uint64_t              hash = stable_hash(key.data(), key.size());
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto                        it = m_views.find(hash);
+	if(it != m_views.end()) {
+		view& v = m_slot_views[it->second.slot()];
+		if(std::equal(key.begin(), key.end(), v.key.begin(), v.key.end())) {
+			++v.refs;
+			*created = false;
+			return it->second;
+		}
+	}
+
+	staging_descriptor handle = m_slots.allocate();
+	*created                  = bool(handle);
+	if(!handle)
+		return handle;
+	view& v = m_slot_views[handle.slot()];
+	v.key.assign(key.begin(), key.end());
+	v.hash   = hash;
+	v.refs   = 1;
+	v.shared = it == m_views.end();
+	if(v.shared)
+		m_views.emplace(hash, handle);
+	return handle;
+}
+
+void descriptor_heap_cpu::free(staging_descriptor handle)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	if(!m_slots.valid(handle)) {
+		log_error("stale staging descriptor %08x", handle.value);
+		return;
+	}
+	view& v = m_slot_views[handle.slot()];
+	if(--v.refs)
+		return;
+	if(v.shared)
+		m_views.erase(v.hash);
+	v.key.clear();
+	v.shared = false;
+	// gpu 는 staging heap 을 읽지 않음 : 바로 재사용
+	m_slots.free(handle, 0);
+	m_slots.collect(0);
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE descriptor_heap_cpu::cpu(staging_descriptor handle) const
+{
+	log_assert(m_slots.valid(handle), "stale staging descriptor");
+	return {m_cpu.ptr + SIZE_T(m_slots.index(handle)) * m_stride};
+}
+
 // ===== descriptor_heap_gpu =====
-void descriptor_heap_gpu::create(ID3D12Device* dev, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT capacity)
+void descriptor_heap_gpu::create(ID3D12Device* dev, D3D12_DESCRIPTOR_HEAP_TYPE type, dx_timeline* timeline, UINT transient_capacity, UINT persistent_capacity)
 {
 	release();
 	m_device   = dev;
 	m_type     = type;
-	m_capacity = capacity;
+	m_timeline = timeline;
+	m_capacity = persistent_capacity + transient_capacity;
 	D3D12_DESCRIPTOR_HEAP_DESC desc{};
 	desc.Type           = type;
-	desc.NumDescriptors = capacity;
+	desc.NumDescriptors = m_capacity;
 	desc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
 	HR(dev->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&m_heap)));
 	m_heap->SetName(L"HEAPS UPLOADERED");
-	m_stride = dev->GetDescriptorHandleIncrementSize(type);
-	m_cpu    = m_heap->GetCPUDescriptorHandleForHeapStart();
-	m_gpu    = m_heap->GetGPUDescriptorHandleForHeapStart();
-	m_next   = 0;
+	m_stride          = dev->GetDescriptorHandleIncrementSize(type);
+	m_cpu             = m_heap->GetCPUDescriptorHandleForHeapStart();
+	m_gpu             = m_heap->GetGPUDescriptorHandleForHeapStart();
+	m_transient_first = persistent_capacity;
+	m_ring.initialize(transient_capacity);
+	m_frame_value     = timeline->next_value();
+	m_chunks.initialize(DESCRIPTOR_CHUNK_SIZE, DESCRIPTOR_CHUNK_SPAN, [this](uint32_t count) { return reserve(count); });
+	m_bindless.initialize(0, persistent_capacity);
 }
 
 void descriptor_heap_gpu::release()
 {
 	safe_release(m_heap);
-	m_device   = nullptr;
-	m_capacity = 0;
-	m_stride   = 0;
-	m_next     = 0;
+	m_bindless.release();
+	m_chunks.release();
+	m_ring.initialize(0);
+	m_tables.reset();
+	m_device          = nullptr;
+	m_timeline        = nullptr;
+	m_capacity        = 0;
+	m_stride          = 0;
+	m_transient_first = 0;
 }
 
 descriptor_heap_gpu::alloc_out descriptor_heap_gpu::alloc(UINT n)
 {
-	alloc_out out{};
-	if((m_next + n) > m_capacity) {
-		__debugbreak();
-		return out;
+	std::lock_guard<std::mutex> lock(m_lock);
+	const ring_fence            fence{0, m_frame_value};
+	uint64_t                    offset = m_ring.allocate(n, 1, fence);
+	while(offset == ring_allocator::invalid) {
+		const uint64_t completed = m_timeline->poll();
+		m_ring.retire([completed](const ring_fence& f) {
+			return f.value <= completed;
+		});
+		offset = m_ring.allocate(n, 1, fence);
+		if(offset != ring_allocator::invalid)
+			break;
+		// 남은 것이 모두 아직 signal 되지 않은 이번 frame 이면 기다려도 비지 않음
+		if(m_ring.empty() || m_ring.oldest().value > m_timeline->last_signaled()) {
+			overflow(fence.value, n);
+			return {};
+		}
+		m_timeline->wait(m_ring.oldest().value);
+	}
+	return at(uint32_t(offset));
+}
+
+descriptor_heap_gpu::alloc_out descriptor_heap_gpu::alloc(descriptor_chunk_cache* cache, UINT n)
+{
+	uint32_t offset = cache->allocate(n);
+	if(offset == descriptor_chunk_source::invalid && n > m_chunks.chunk_size())
+		offset = reserve(n);
+	if(offset == descriptor_chunk_source::invalid) {
+		overflow(m_frame_value, n);
+		return {};
+	}
+	return at(offset);
+}
+
+void descriptor_heap_gpu::collect(uint64_t completed_value, uint64_t frame_value)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_ring.retire([completed_value](const ring_fence& fence) {
+			return fence.value <= completed_value;
+		});
+		m_frame_value = frame_value;
 	}
-	out.index   = m_next;
-	out.cpu.ptr = m_cpu.ptr + SIZE_T(m_next) * m_stride;
-	out.gpu.ptr = m_gpu.ptr + UINT64(m_next) * UINT64(m_stride);
-	m_next += n;
+	m_chunks.invalidate();
+	m_bindless.collect(completed_value);
+}
+
+uint32_t descriptor_heap_gpu::reserve(uint32_t count)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	const uint64_t              offset = m_ring.allocate(count, 1, ring_fence{0, m_frame_value});
+	return offset == ring_allocator::invalid ? descriptor_chunk_source::invalid : uint32_t(offset);
+}
+
+descriptor_heap_gpu::alloc_out descriptor_heap_gpu::at(uint32_t offset) const
+{
+	alloc_out out{};
+	out.index   = m_transient_first + offset;
+	out.cpu.ptr = m_cpu.ptr + SIZE_T(out.index) * m_stride;
+	out.gpu.ptr = m_gpu.ptr + UINT64(out.index) * UINT64(m_stride);
 	return out;
 }
 
+void descriptor_heap_gpu::overflow(uint64_t value, UINT n)
+{
+	if(m_overflow_value.exchange(value, std::memory_order_relaxed) != value)
+		log_error("transient descriptors exhausted (%u requested, ring %u)", n, uint32_t(m_ring.capacity()));
+}
+
+descriptor_table_cache* descriptor_heap_gpu::tables()
+{
+	// main thread 전용 : m_frame_value 는 같은 thread 의 collect 에서만 바뀜
+	if(m_tables_value != m_frame_value) {
+		m_tables.reset();
+		m_tables_value = m_frame_value;
+	}
+	return &m_tables;
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE descriptor_heap_gpu::cpu(bindless_handle handle) const
+{
+	log_assert(m_bindless.valid(handle), "stale bindless handle");
+	return {m_cpu.ptr + SIZE_T(m_bindless.index(handle)) * m_stride};
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE descriptor_heap_gpu::gpu(bindless_handle handle) const
+{
+	log_assert(m_bindless.valid(handle), "stale bindless handle");
+	return {m_gpu.ptr + UINT64(m_bindless.index(handle)) * UINT64(m_stride)};
+}
+
 // ===== dx_device =====
-void dx_device::initialize(ID3D12Device* dev, ID3D12CommandQueue* gfx_queue)
+void dx_device::initialize(ID3D12Device* dev, ID3D12CommandQueue* gfx_queue, dx_timeline* gfx_timeline)
 {
-	m_device = dev;
-	m_queue  = gfx_queue;
+	m_device   = dev;
+	m_queue    = gfx_queue;
+	m_timeline    = gfx_timeline;
+	m_frame_value = m_timeline->next_value();
+	m_upload_timeline.initialize(m_device, m_queue, L"UPLOAD TIMELINE");
+
+	// enhanced barrier 에서는 texture layout 이 암시적으로 바뀌지 않음
+	m_states.set_texture_promotion(!dx_barrier_batch::enhanced());
 
 	HR(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_upload_alloc)));
 	HR(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, m_upload_alloc, nullptr, IID_PPV_ARGS(&m_cmd)));
 	HR(m_cmd->Close());
+	m_upload_alloc_free.push_back(m_upload_alloc);
+	m_upload_alloc = nullptr;
 
-	HR(m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)));
-	m_fence_event = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
-	m_fence_value = 0;
-
-	m_heap_cbv_srv_uav.create(m_device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 1024);
+	m_heap_cbv_srv_uav.create(m_device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, m_timeline, FRAME_DESCRIPTOR_COUNT, BINDLESS_DESCRIPTOR_COUNT);
+	m_staging_cbv_srv_uav.create(m_device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, STAGING_DESCRIPTOR_COUNT);
 	m_cmd->SetName(L"Uploaded CMD");
-	m_fence->SetName(L"Uploaded Fence");
+	HR(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, m_upload_alloc_free.front(), nullptr, IID_PPV_ARGS(&m_fixup_cmd)));
+	HR(m_fixup_cmd->Close());
+	m_fixup_cmd->SetName(L"Upload Fixup CMD");
+
+	create_copy_queue();
+
+	m_upload_ring.initialize(m_device, UPLOAD_RING_SIZE);
+	m_ring_graphics = m_upload_ring.register_timeline(m_timeline);
+	m_ring_copy     = m_upload_ring.register_timeline(&m_copy_timeline);
 }
 
 void dx_device::release()
 {
-	if(m_device && m_fence) {
-		signal_and_wait();
+	if(m_copy_queue) {
+		flush_uploads();
+		m_copy_timeline.wait_idle();
 	}
-	// signal_and_wait();
-	if(m_fence_event) {
-		::CloseHandle(m_fence_event);
-		m_fence_event = nullptr;
+	if(m_device && m_timeline) {
+		wait_idle();
 	}
-	m_heap_cbv_srv_uav.release();
+	collect_releases(UINT64_MAX);
+	m_copy_release_queue.collect(UINT64_MAX, [](IUnknown*& object) {
+		safe_release(object);
+	});
+
+	m_upload_ring.release();
+	m_pipelines.release();
+	m_root_signatures.release();
+
+	safe_release(m_copy_cmd);
+	for(auto& alloc : m_copy_alloc_free) {
+		safe_release(alloc);
+	}
+	m_copy_alloc_free.clear();
+	m_copy_timeline.release();
+	safe_release(m_copy_queue);
+	m_copy_wait_value   = 0;
+	m_copy_waited_value = 0;
 
-	if(m_upload_alloc && m_cmd) {
-		m_upload_alloc->Reset();
-		m_cmd->Reset(m_upload_alloc, nullptr);
+	m_heap_cbv_srv_uav.release();
+	m_staging_cbv_srv_uav.release();
+
+	// 대기 후 callback 으로 모든 upload allocator 가 free list 로 돌아옴
+	m_upload_timeline.release();
+	if(!m_upload_alloc_free.empty() && m_cmd) {
+		ID3D12CommandAllocator* alloc = m_upload_alloc_free.front();
+		alloc->Reset();
+		m_cmd->Reset(alloc, nullptr);
 		m_cmd->ClearState(nullptr);
 		m_cmd->Close();
 	}
 	safe_release(m_cmd);
+	safe_release(m_fixup_cmd);
+	m_upload_states.reset();
+	m_states = resource_state_registry{};
+	for(auto& alloc : m_upload_alloc_free) {
+		safe_release(alloc);
+	}
+	m_upload_alloc_free.clear();
 	safe_release(m_upload_alloc);
-	safe_release(m_fence);
-	m_device = nullptr;
-	m_queue  = nullptr;
+	m_device   = nullptr;
+	m_queue    = nullptr;
+	m_timeline = nullptr;
 }
 
 void dx_device::begin_upload()
 {
-	HR(m_upload_alloc->Reset());
+	log_assert(!m_upload_alloc, "begin_upload called twice");
+	m_upload_timeline.poll();
+	if(m_upload_alloc_free.empty()) {
+		HR(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_upload_alloc)));
+	}
+	else {
+		m_upload_alloc = m_upload_alloc_free.back();
+		m_upload_alloc_free.pop_back();
+		HR(m_upload_alloc->Reset());
+	}
 	HR(m_cmd->Reset(m_upload_alloc, nullptr));
+	m_upload_states.reset();
 }
 
 void dx_device::end_upload()
 {
+	m_upload_states.flush(m_cmd);
 	HR(m_cmd->Close());
-	ID3D12CommandList* lists[] = {m_cmd};
-	m_queue->ExecuteCommandLists(1, lists);
-	signal_and_wait();
+	submit_queue_waits(m_queue);
+
+	// 이전 submit 이 남긴 상태와 다르면 같은 allocator 로 보정 list 를 앞에 붙임
+	ID3D12CommandList* lists[2]{};
+	UINT               count = 0;
+	if(m_upload_states.resolve(&m_states, &m_fixups)) {
+		HR(m_fixup_cmd->Reset(m_upload_alloc, nullptr));
+		m_fixups.record(m_fixup_cmd);
+		HR(m_fixup_cmd->Close());
+		lists[count++] = m_fixup_cmd;
+	}
+	lists[count++] = m_cmd;
+	m_queue->ExecuteCommandLists(count, lists);
+
+	// 같은 queue 라 이후 frame 의 명령은 순서대로 copy 이후에 실행됨 -> cpu 대기 불필요
+	ID3D12CommandAllocator* alloc = m_upload_alloc;
+	m_upload_alloc                = nullptr;
+	m_upload_timeline.on_complete(m_upload_timeline.signal(), [this, alloc]() {
+		m_upload_alloc_free.push_back(alloc);
+	});
 }
 
-void dx_device::create_buffer(const buffer_create_info* info, dx_buffer** pp_buffer)
+void dx_device::defer_release(IUnknown* object, uint64_t bytes)
+{
+	if(!object)
+		return;
+	m_release_queue.push(m_frame_value, object, bytes);
+}
+
+void dx_device::defer_release(ID3D12Resource* resource)
+{
+	if(!resource)
+		return;
+	m_states.remove(resource);
+	D3D12_RESOURCE_DESC            desc = resource->GetDesc();
+	D3D12_RESOURCE_ALLOCATION_INFO info = m_device->GetResourceAllocationInfo(0, 1, &desc);
+	defer_release(static_cast<IUnknown*>(resource), info.SizeInBytes);
+}
+
+void dx_device::collect_releases(uint64_t completed_value)
+{
+	auto release = [](IUnknown*& object) {
+		safe_release(object);
+	};
+	m_released_bytes = m_release_queue.collect(completed_value, release);
+	if(m_timeline)
+		m_frame_value = m_timeline->next_value();
+	m_heap_cbv_srv_uav.collect(completed_value, m_frame_value);
+	if(m_device)
+		m_upload_timeline.poll();
+	if(m_copy_queue) {
+		m_released_bytes += m_copy_release_queue.collect(m_copy_timeline.poll(), release);
+	}
+	m_upload_ring.retire();
+}
+
+// ---- Copy queue ----
+void dx_device::create_copy_queue()
+{
+	D3D12_COMMAND_QUEUE_DESC qd{};
+	qd.Type  = D3D12_COMMAND_LIST_TYPE_COPY;
+	qd.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+	HR(m_device->CreateCommandQueue(&qd, IID_PPV_ARGS(&m_copy_queue)));
+	m_copy_queue->SetName(L"COPY QUEUE");
+	m_copy_timeline.initialize(m_device, m_copy_queue, L"COPY TIMELINE");
+
+	ID3D12CommandAllocator* alloc{};
+	HR(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&alloc)));
+	HR(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, alloc, nullptr, IID_PPV_ARGS(&m_copy_cmd)));
+	HR(m_copy_cmd->Close());
+	m_copy_cmd->SetName(L"Copy CMD");
+	m_copy_alloc_free.push_back(alloc);
+}
+
+void dx_device::begin_copy()
 {
-	ID3D12Resource* buffer         = create_default_buffer(info->size);
-	ID3D12Resource* staging_buffer = create_upload_buffer(info->size, info->data);
+	if(m_copy_alloc)
+		return;        // 이미 열려 있음 -> 같은 list 에 누적
+	if(m_copy_alloc_free.empty()) {
+		HR(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&m_copy_alloc)));
+	}
+	else {
+		m_copy_alloc = m_copy_alloc_free.back();
+		m_copy_alloc_free.pop_back();
+		HR(m_copy_alloc->Reset());
+	}
+	HR(m_copy_cmd->Reset(m_copy_alloc, nullptr));
+}
 
-	D3D12_RESOURCE_STATES layout = D3D12_RESOURCE_STATE_COMMON;
+void dx_device::flush_uploads()
+{
+	if(!m_copy_alloc)
+		return;
+	HR(m_copy_cmd->Close());
+	ID3D12CommandList* lists[] = {m_copy_cmd};
+	m_copy_queue->ExecuteCommandLists(1, lists);
+
+	ID3D12CommandAllocator* alloc = m_copy_alloc;
+	m_copy_alloc                  = nullptr;
+	m_copy_timeline.on_complete(m_copy_timeline.signal(), [this, alloc]() {
+		m_copy_alloc_free.push_back(alloc);
+	});
+}
 
-	switch(info->type) {
+uint64_t dx_device::create_buffer_async(const buffer_create_info* info, dx_buffer** pp_buffer)
+{
+	ID3D12Resource* buffer  = create_default_buffer(info->size);
+	dx_staging      staging = alloc_staging(info->size, 4, upload_queue::copy);
+	std::memcpy(staging.cpu, info->data, info->size);
+	m_states.set(buffer, 1, resource_state::common, true);
+
+	// COMMON 으로 생성된 buffer 는 copy queue 에서 COPY_DEST 로, graphics queue 에서
+	// VB/IB/CB 상태로 암시적 promotion 되므로 barrier 가 필요 없음
+	begin_copy();
+	m_copy_cmd->CopyBufferRegion(buffer, 0, staging.resource, staging.offset, info->size);
+
+	// 열린 list 는 다음 flush 에서 next_value 로 signal 됨
+	const uint64_t ticket = m_copy_timeline.next_value();
+
+	dx_buffer* p_buffer   = make_buffer(info, buffer);
+	p_buffer->ready_value = ticket;
+	*pp_buffer            = p_buffer;
+	return ticket;
+}
+
+bool dx_device::is_upload_complete(uint64_t ticket)
+{
+	return m_copy_timeline.is_complete(ticket);
+}
+
+void dx_device::wait_upload(uint64_t ticket)
+{
+	if(ticket > m_copy_timeline.last_signaled())
+		flush_uploads();
+	m_copy_timeline.wait(ticket);
+}
+
+void dx_device::use(const dx_buffer* buffer)
+{
+	const uint64_t ticket = buffer->ready_value;
+	if(ticket <= m_copy_waited_value || m_copy_timeline.is_complete(ticket))
+		return;
+	if(ticket > m_copy_timeline.last_signaled())
+		flush_uploads();
+	if(ticket > m_copy_wait_value)
+		m_copy_wait_value = ticket;
+}
+
+void dx_device::submit_queue_waits(ID3D12CommandQueue* queue)
+{
+	if(m_copy_wait_value <= m_copy_waited_value)
+		return;
+	m_copy_timeline.gpu_wait(queue, m_copy_wait_value);
+	m_copy_waited_value = m_copy_wait_value;
+}
+
+static resource_state buffer_usage(buffer_type type)
+{
+	switch(type) {
 		case buffer_type::vertex:
-			layout = D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER;
-			break;
+			return resource_state::vertex_buffer;
 		case buffer_type::index:
-			layout = D3D12_RESOURCE_STATE_INDEX_BUFFER;
-			break;
+			return resource_state::index_buffer;
 		case buffer_type::uniform:
-			layout = D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER;
-			break;
+			return resource_state::constant_buffer;
 		default:
 			log_assert(0, "unknown type is not supported");
-			break;
+			return resource_state::common;
 	}
+}
+
+void dx_device::create_buffer(const buffer_create_info* info, dx_buffer** pp_buffer)
+{
+	create_resources({info, 1}, pp_buffer);
+}
+
+void dx_device::create_resources(std::span<const buffer_create_info>  buffers,
+                                 dx_buffer**                          pp_buffers,
+                                 std::span<const texture_create_info> textures,
+                                 Texture2D*                           out_textures)
+{
+	if(buffers.empty() && textures.empty())
+		return;
 
 	begin_upload();
-	transition(m_cmd, buffer,
-	           D3D12_RESOURCE_STATE_COMMON,
-	           D3D12_RESOURCE_STATE_COPY_DEST);
-	m_cmd->CopyBufferRegion(buffer, 0, staging_buffer, 0, info->size);
-	transition(m_cmd, buffer,
-	           D3D12_RESOURCE_STATE_COPY_DEST,
-	           layout);
-	end_upload();
 
-	safe_release(staging_buffer);
+	// COMMON 으로 만든 buffer/texture 는 첫 copy 에서 COPY_DEST 로 암시적 promotion 되므로
+	// 앞쪽 barrier 는 없고 (tracker 가 resolve 에서 판단), 최종 상태 barrier 만 한 번에 flush
+	for(size_t i = 0; i < buffers.size(); ++i) {
+		const buffer_create_info& info = buffers[i];
+
+		ID3D12Resource* buffer  = create_default_buffer(info.size);
+		dx_staging      staging = alloc_staging(info.size, 4, upload_queue::graphics);
+		std::memcpy(staging.cpu, info.data, info.size);
+		m_states.set(buffer, 1, resource_state::common, true);
+		m_upload_states.require(buffer, resource_state::copy_dst);
+		m_cmd->CopyBufferRegion(buffer, 0, staging.resource, staging.offset, info.size);
+
+		m_upload_states.require(buffer, buffer_usage(info.type));
+		pp_buffers[i] = make_buffer(&info, buffer);
+	}
+
+	for(size_t i = 0; i < textures.size(); ++i) {
+		const texture_create_info& info = textures[i];
+
+		Texture2D out{};
+		out.width  = info.width;
+		out.height = info.height;
+		out.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+
+		D3D12_HEAP_PROPERTIES hp = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+		D3D12_RESOURCE_DESC   rd = CD3DX12_RESOURCE_DESC::Tex2D(out.format, info.width, info.height, 1, 1);
+		HR(m_device->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &rd,
+		                                     D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&out.resource)));
+
+		m_states.set(out.resource, 1, resource_state::common, false);
+		m_upload_states.require(out.resource, resource_state::copy_dst);
 
+		const UINT64 upload_size = GetRequiredIntermediateSize(out.resource, 0, 1);
+		dx_staging   staging     = alloc_staging(upload_size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, upload_queue::graphics);
+
+		D3D12_SUBRESOURCE_DATA src{};
+		src.pData      = info.pixels;
+		src.RowPitch   = (LONG_PTR)info.row_stride;
+		src.SlicePitch = src.RowPitch * info.height;
+		UpdateSubresources(m_cmd, out.resource, staging.resource, staging.offset, 0, 1, &src);
+
+		m_upload_states.require(out.resource, resource_state::shader_read);
+		out_textures[i] = out;
+	}
+
+	m_upload_states.flush(m_cmd);
+	end_upload();
+}
+
+dx_buffer* dx_device::make_buffer(const buffer_create_info* info, ID3D12Resource* resource)
+{
 	dx_buffer* p_buffer               = emt_new dx_buffer;
 	p_buffer->type                    = info->type;
 	p_buffer->size                    = info->size;
-	p_buffer->handle                  = buffer;
-	p_buffer->vtx_view.BufferLocation = buffer->GetGPUVirtualAddress();
+	p_buffer->handle                  = resource;
+	p_buffer->vtx_view.BufferLocation = resource->GetGPUVirtualAddress();
 	p_buffer->vtx_view.SizeInBytes    = info->size;
-	p_buffer->gpu_addr                = buffer->GetGPUVirtualAddress();
+	p_buffer->gpu_addr                = resource->GetGPUVirtualAddress();
+	return p_buffer;
+}
+
+dx_staging dx_device::alloc_staging(uint64_t size, uint64_t align, upload_queue queue)
+{
+	const uint32_t consumer = queue == upload_queue::copy ? m_ring_copy : m_ring_graphics;
+
+	dx_staging out{};
+	if(size <= m_upload_ring.capacity()) {
+		m_upload_ring.retire();
+		while(!m_upload_ring.allocate(size, align, consumer, &out)) {
+			if(m_upload_ring.empty())
+				break;
+			const ring_fence& oldest   = m_upload_ring.oldest();
+			dx_timeline*      timeline = m_upload_ring.timeline(oldest.timeline);
+			if(oldest.value > timeline->last_signaled()) {
+				// 열린 copy list 는 flush 하면 되지만 기록 중인 graphics frame 은 기다릴 수 없음
+				if(timeline != &m_copy_timeline)
+					break;
+				flush_uploads();
+			}
+			timeline->wait(oldest.value);
+			m_upload_ring.retire();
+		}
+		if(out.resource)
+			return out;
+	}
 
-	*pp_buffer = p_buffer;
+	// spill : 이번 한 번만 쓰는 committed buffer
+	log_warn("upload ring full, spilling %llu bytes", static_cast<unsigned long long>(size));
+	ID3D12Resource* spill = create_upload_buffer(size);
+	CD3DX12_RANGE   range(0, 0);
+	HR(spill->Map(0, &range, reinterpret_cast<void**>(&out.cpu)));
+	out.resource = spill;
+	out.offset   = 0;
+	out.gpu      = spill->GetGPUVirtualAddress();
+	if(queue == upload_queue::copy)
+		m_copy_release_queue.push(m_copy_timeline.next_value(), spill, size);
+	else
+		defer_release(spill);
+	return out;
+}
+
+dx_staging dx_device::alloc_frame_data(uint64_t size, uint64_t align)
+{
+	return alloc_staging(size, align, upload_queue::graphics);
 }
 
-void dx_device::signal_and_wait()
+void dx_device::wait_idle()
 {
-	const UINT64 v = ++m_fence_value;
-	HR(m_queue->Signal(m_fence, v));
-	HR(m_fence->SetEventOnCompletion(v, m_fence_event));
-	::WaitForSingleObject(m_fence_event, INFINITE);
+	// upload 는 upload timeline 으로 signal, 나머지 graphics submit 은 end_frame 의 signal 로 끝남
+	m_timeline->wait(m_timeline->last_signaled());
+	m_upload_timeline.wait(m_upload_timeline.last_signaled());
 }
 
 ID3D12Resource* dx_device::create_default_buffer(UINT64 size)
@@ -286,38 +750,23 @@ void dx_device::transition(ID3D12GraphicsCommandList* cl, ID3D12Resource* res, D
 // ---- Textures ----
 Texture2D dx_device::create_texture2d_rgba8(const void* pixels, UINT width, UINT height, UINT rowStride)
 {
-	Texture2D out{};
-	out.width  = width;
-	out.height = height;
-	out.format = DXGI_FORMAT_R8G8B8A8_UNORM;
-
-	D3D12_HEAP_PROPERTIES hp = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
-	D3D12_RESOURCE_DESC   rd = CD3DX12_RESOURCE_DESC::Tex2D(out.format, width, height, 1, 1);
-	HR(m_device->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &rd,
-	                                     D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&out.resource)));
-
-	const UINT64 uploadSize = GetRequiredIntermediateSize(out.resource, 0, 1);
-	out.upload              = create_upload_buffer(uploadSize);
-
-	D3D12_SUBRESOURCE_DATA src{};
-	src.pData      = pixels;
-	src.RowPitch   = (LONG_PTR)rowStride;
-	src.SlicePitch = src.RowPitch * height;
-
-	begin_upload();
-	transition(m_cmd, out.resource, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST);
-	UpdateSubresources(m_cmd, out.resource, out.upload, 0, 0, 1, &src);
-	transition(m_cmd, out.resource, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-	end_upload();
+	texture_create_info info{};
+	info.pixels     = pixels;
+	info.width      = width;
+	info.height     = height;
+	info.row_stride = rowStride;
 
-	safe_release(out.upload);
+	Texture2D out{};
+	create_resources({}, nullptr, {&info, 1}, &out);
 	return out;
 }
 
 // ---- Descriptor helpers ----
 D3D12_GPU_DESCRIPTOR_HANDLE dx_device::create_cbv_gpu(ID3D12Resource* resource, UINT byteSize)
 {
-	auto                            a       = m_heap_cbv_srv_uav.alloc();
+	auto a = m_heap_cbv_srv_uav.alloc();
+	if(!a.cpu.ptr)
+		return a.gpu;
 	UINT                            aligned = (byteSize + 255) & ~255u;
 	D3D12_CONSTANT_BUFFER_VIEW_DESC cbv{};
 	cbv.BufferLocation = resource->GetGPUVirtualAddress();
@@ -328,7 +777,9 @@ D3D12_GPU_DESCRIPTOR_HANDLE dx_device::create_cbv_gpu(ID3D12Resource* resource,
 
 D3D12_GPU_DESCRIPTOR_HANDLE dx_device::create_srv_texture2d_gpu(ID3D12Resource* resource, DXGI_FORMAT format)
 {
-	auto                            a = m_heap_cbv_srv_uav.alloc();
+	auto a = m_heap_cbv_srv_uav.alloc();
+	if(!a.cpu.ptr)
+		return a.gpu;
 	D3D12_SHADER_RESOURCE_VIEW_DESC srv{};
 	srv.Format                    = format;
 	srv.ViewDimension             = D3D12_SRV_DIMENSION_TEXTURE2D;
@@ -339,13 +790,133 @@ D3D12_GPU_DESCRIPTOR_HANDLE dx_device::create_srv_texture2d_gpu(ID3D12Resource*
 	return a.gpu;
 }
 
-ID3D12RootSignature* dx_device::create_basic_root_signature(bool sampler_in_root)
+bindless_handle dx_device::create_cbv_bindless(ID3D12Resource* resource, UINT byteSize)
+{
+	bindless_handle handle = m_heap_cbv_srv_uav.alloc_persistent();
+	if(!handle)
+		return handle;
+	D3D12_CONSTANT_BUFFER_VIEW_DESC cbv{};
+	cbv.BufferLocation = resource->GetGPUVirtualAddress();
+	cbv.SizeInBytes    = (byteSize + 255) & ~255u;
+	m_device->CreateConstantBufferView(&cbv, m_heap_cbv_srv_uav.cpu(handle));
+	return handle;
+}
+
+bindless_handle dx_device::create_srv_texture2d_bindless(ID3D12Resource* resource, DXGI_FORMAT format)
+{
+	bindless_handle handle = m_heap_cbv_srv_uav.alloc_persistent();
+	if(!handle)
+		return handle;
+	D3D12_SHADER_RESOURCE_VIEW_DESC srv{};
+	srv.Format                    = format;
+	srv.ViewDimension             = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srv.Shader4ComponentMapping   = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srv.Texture2D.MipLevels       = UINT(-1);
+	srv.Texture2D.MostDetailedMip = 0;
+	m_device->CreateShaderResourceView(resource, &srv, m_heap_cbv_srv_uav.cpu(handle));
+	return handle;
+}
+
+void dx_device::release_bindless(bindless_handle handle)
+{
+	// 이미 기록된 command list 가 이 slot 을 읽을 수 있음 -> 이번 frame 을 끝내는 signal 이후 재사용
+	m_heap_cbv_srv_uav.free_persistent(handle, m_frame_value);
+}
+
+// staging view 의 dedupe key : padding 까지 0 으로 채워 byte 로 비교
+struct staging_view_key
+{
+	const ID3D12Resource* resource;
+	uint32_t              kind;        // 0 cbv, 1 srv
+	uint32_t              reserved;
+	union
+	{
+		D3D12_CONSTANT_BUFFER_VIEW_DESC cbv;
+		D3D12_SHADER_RESOURCE_VIEW_DESC srv;
+	};
+};
+
+static std::span<const uint8_t> key_bytes(const staging_view_key& key)
+{
+	return {reinterpret_cast<const uint8_t*>(&key), sizeof(key)};
+}
+
+staging_descriptor dx_device::create_cbv_staging(ID3D12Resource* resource, UINT byteSize)
+{
+	staging_view_key key;
+	memset(&key, 0, sizeof(key));
+	key.resource           = resource;
+	key.kind               = 0;
+	key.cbv.BufferLocation = resource->GetGPUVirtualAddress();
+	key.cbv.SizeInBytes    = (byteSize + 255) & ~255u;
+
+	bool               created{};
+	staging_descriptor handle = m_staging_cbv_srv_uav.acquire(key_bytes(key), &created);
+	if(created)
+		m_device->CreateConstantBufferView(&key.cbv, m_staging_cbv_srv_uav.cpu(handle));
+	return handle;
+}
+
+staging_descriptor dx_device::create_srv_texture2d_staging(ID3D12Resource* resource, DXGI_FORMAT format)
+{
+	staging_view_key key;
+	memset(&key, 0, sizeof(key));
+	key.resource                      = resource;
+	key.kind                          = 1;
+	key.srv.Format                    = format;
+	key.srv.ViewDimension             = D3D12_SRV_DIMENSION_TEXTURE2D;
+	key.srv.Shader4ComponentMapping   = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	key.srv.Texture2D.MipLevels       = UINT(-1);
+	key.srv.Texture2D.MostDetailedMip = 0;
+
+	bool               created{};
+	staging_descriptor handle = m_staging_cbv_srv_uav.acquire(key_bytes(key), &created);
+	if(created)
+		m_device->CreateShaderResourceView(resource, &key.srv, m_staging_cbv_srv_uav.cpu(handle));
+	return handle;
+}
+
+void dx_device::release_staging(staging_descriptor handle)
+{
+	m_staging_cbv_srv_uav.free(handle);
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE dx_device::copy_table(std::span<const staging_descriptor> views)
 {
-	CD3DX12_DESCRIPTOR_RANGE range{};
-	range.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+	if(views.empty())
+		return {};
+
+	descriptor_table_cache* tables = m_heap_cbv_srv_uav.tables();
+	const uint64_t          hash   = descriptor_table_cache::hash(views);
+	uint32_t                index{};
+	if(tables->find(views, hash, &index))
+		return m_heap_cbv_srv_uav.gpu_at(index);
+
+	descriptor_heap_gpu::alloc_out out = m_heap_cbv_srv_uav.alloc(UINT(views.size()));
+	if(!out.cpu.ptr)
+		return {};
+	// staging slot 이 연속인 구간은 한 번에 copy
+	const D3D12_DESCRIPTOR_HEAP_TYPE type = m_staging_cbv_srv_uav.type();
+	for(size_t i = 0, run = 0; i < views.size(); i += run) {
+		run = 1;
+		while(i + run < views.size() && views[i + run].slot() == views[i].slot() + run)
+			++run;
+		m_device->CopyDescriptorsSimple(UINT(run), m_heap_cbv_srv_uav.cpu_at(out.index + UINT(i)), m_staging_cbv_srv_uav.cpu(views[i]), type);
+	}
+	tables->insert(views, hash, out.index);
+	return out.gpu;
+}
 
-	CD3DX12_ROOT_PARAMETER params[2];
-	params[0].InitAsConstantBufferView(0, 0, D3D12_SHADER_VISIBILITY_ALL);
+ID3D12RootSignature* dx_device::create_basic_root_signature(bool sampler_in_root)
+{
+	// 1.0 과 같은 동작 : table 의 descriptor 와 data, root cbv 의 data 모두 volatile
+	// (1.1 의 NONE 은 data static 을 약속하므로 draw 사이에 바뀌는 buffer 에는 맞지 않음)
+	CD3DX12_DESCRIPTOR_RANGE1 range{};
+	range.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0,
+	           D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE | D3D12_DESCRIPTOR_RANGE_FLAG_DATA_VOLATILE);
+
+	CD3DX12_ROOT_PARAMETER1 params[2];
+	params[0].InitAsConstantBufferView(0, 0, D3D12_ROOT_DESCRIPTOR_FLAG_DATA_VOLATILE, D3D12_SHADER_VISIBILITY_ALL);
 	params[1].InitAsDescriptorTable(1, &range, D3D12_SHADER_VISIBILITY_PIXEL);
 
 	D3D12_STATIC_SAMPLER_DESC samp{};
@@ -355,7 +926,7 @@ ID3D12RootSignature* dx_device::create_basic_root_signature(bool sampler_in_root
 	samp.RegisterSpace                            = 0;
 	samp.ShaderVisibility                         = D3D12_SHADER_VISIBILITY_PIXEL;
 
-	D3D12_ROOT_SIGNATURE_DESC rsd{};
+	D3D12_ROOT_SIGNATURE_DESC1 rsd{};
 	rsd.NumParameters = 2;
 	rsd.pParameters   = params;
 	rsd.Flags         = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
@@ -364,14 +935,9 @@ ID3D12RootSignature* dx_device::create_basic_root_signature(bool sampler_in_root
 		rsd.pStaticSamplers   = &samp;
 	}
 
-	ID3DBlob* blob{};
-	ID3DBlob* err{};
-	HR(D3D12SerializeRootSignature(&rsd, D3D_ROOT_SIGNATURE_VERSION_1, &blob, &err));
-
-	ID3D12RootSignature* rs{};
-	HR(m_device->CreateRootSignature(0, blob->GetBufferPointer(), blob->GetBufferSize(), IID_PPV_ARGS(&rs)));
-	safe_release(blob);
-	safe_release(err);
+	// 같은 layout 이면 같은 object : 이전처럼 caller 가 Release 할 수 있도록 참조 추가
+	ID3D12RootSignature* rs = m_root_signatures.get(rsd);
+	rs->AddRef();
 	return rs;
 }
 
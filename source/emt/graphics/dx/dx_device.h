@@ -6,12 +6,35 @@
 //  - Upload begin/end w/ explicit command list (no lambdas)
 //  - Unified dx_buffer that can represent Vertex / Index / Constant / Raw
 //  - Helpers to bind IA vertex/index and root CBV
-//  - Linear GPU-visible CBV/SRV/UAV heap
+//  - GPU-visible CBV/SRV/UAV heap : bindless slots + fence-retired transient ring
+//  - CPU-only staging heap, tables copied per frame and deduplicated
+//  - Deferred release keyed by graphics timeline value (no idle stalls)
+//  - Async uploads on a dedicated copy queue, gpu-side wait on first use
+//  - All staging memory suballocated from one persistently mapped ring
+//  - Batched creation : many buffers/textures, one list, one barrier call, one submit
+//  - Resource states tracked per subresource, resolved between lists at submit
+//  - PSOs deduplicated by desc hash and persisted in an ID3D12PipelineLibrary
+//  - Root signatures deduplicated by layout hash, serialized blobs kept on disk
 // ==============================
 #pragma once
 
 #include <emt/core/typedef.h>
 #include "dx_config.h"
+#include "dx_timeline.h"
+#include "dx_upload_ring.h"
+#include "dx_state_tracker.h"
+#include "dx_pipeline_cache.h"
+#include "dx_root_signature_cache.h"
+#include <emt/graphics/retire_queue.h>
+#include <emt/graphics/bindless_allocator.h>
+#include <emt/graphics/descriptor_table_cache.h>
+#include <emt/graphics/descriptor_chunk.h>
+#include <emt/graphics/ring_allocator.h>
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 namespace emt
 {
@@ -25,13 +48,59 @@ struct Texture2D
 	DXGI_FORMAT     format{DXGI_FORMAT_R8G8B8A8_UNORM};
 };
 
+// Non shader visible heap : descriptor 의 원본 (cpu 에서 읽어도 느리지 않고 copy source 로 씀)
+//  - 같은 view (key byte 가 같음) 는 하나의 descriptor 를 공유, ref count 로 관리
+//  - 마지막 release 에서 slot 은 바로 재사용 (copy 는 cpu 에서 즉시 끝남, handle 은 generation 으로 구분)
+// 여러 thread 에서 acquire / release 가능
+using staging_descriptor = bindless_handle;
+class descriptor_heap_cpu
+{
+public:
+	descriptor_heap_cpu() = default;
+	~descriptor_heap_cpu() { release(); }
+
+	void create(ID3D12Device* dev, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT capacity);
+	void release();
+
+	// *created 가 true 면 caller 가 cpu(handle) 에 descriptor 를 기록
+	staging_descriptor          acquire(std::span<const uint8_t> key, bool* created);
+	void                        free(staging_descriptor handle);
+	D3D12_CPU_DESCRIPTOR_HANDLE cpu(staging_descriptor handle) const;
+
+	D3D12_DESCRIPTOR_HEAP_TYPE type() const { return m_type; }
+	uint32_t                   size() const { return m_slots.size(); }        // 살아 있는 descriptor 수
+
+private:
+	struct view
+	{
+		std::vector<uint8_t> key;
+		uint64_t             hash{};
+		uint32_t             refs{};
+		bool                 shared{};        // m_views 에 등록됨 (hash 충돌이면 공유하지 않음)
+	};
+
+	ID3D12DescriptorHeap*       m_heap{};
+	D3D12_DESCRIPTOR_HEAP_TYPE  m_type{D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV};
+	UINT                        m_stride{};
+	D3D12_CPU_DESCRIPTOR_HANDLE m_cpu{};
+	bindless_allocator          m_slots;
+
+	std::mutex                                       m_lock;
+	std::vector<view>                                m_slot_views;        // slot -> view
+	std::unordered_map<uint64_t, staging_descriptor> m_views;             // key hash -> handle
+};
+
+// Shader visible heap : [0, persistent) bindless, [persistent, persistent + transient) frame 용
+//  - bindless : free 할 때까지 같은 index, gpu 가 쓰는 동안은 재사용하지 않음
+//  - transient : collect 에서 받은 frame 값 (end_frame 이 signal 할 값) 으로 tag 된 ring, 그 값이 완료되면 retire
+//    (frames in flight 수와 무관, 이전 frame 의 table 을 덮어쓰지 않음)
 class descriptor_heap_gpu
 {
 public:
 	descriptor_heap_gpu() = default;
 	~descriptor_heap_gpu() { release(); }
 
-	void create(ID3D12Device* dev, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT capacity);
+	void create(ID3D12Device* dev, D3D12_DESCRIPTOR_HEAP_TYPE type, dx_timeline* timeline, UINT transient_capacity, UINT persistent_capacity = 0);
 	void release();
 
 	struct alloc_out
@@ -40,20 +109,62 @@ public:
 		D3D12_GPU_DESCRIPTOR_HANDLE gpu{};
 		UINT                        index{};
 	};
+	// transient : 다음 graphics signal 까지 기록한 command 에서만 유효
+	// ring 이 가득 차면 이전 frame 을 기다리고, 이번 frame 만으로 가득 차면 cpu.ptr == 0 (log_error)
 	alloc_out alloc(UINT n = 1);
+	// recording thread 용 : cache 는 thread 마다 하나, chunk 안에서는 lock / atomic 없음
+	// 기다리지 않음 (gpu 대기와 timeline callback 은 main thread 의 collect / alloc 에서)
+	alloc_out alloc(descriptor_chunk_cache* cache, UINT n = 1);
+	descriptor_chunk_source* chunks() { return &m_chunks; }
+
+	// persistent : free 는 retire_value (graphics timeline) 이후 slot 재사용
+	bindless_handle             alloc_persistent() { return m_bindless.allocate(); }
+	void                        free_persistent(bindless_handle handle, uint64_t retire_value) { m_bindless.free(handle, retire_value); }
+	// transient ring 과 bindless slot 을 retire, 이전 frame 의 chunk 를 버림 (begin_frame, recording 전)
+	// frame_value : 이번 frame 의 transient 를 tag 하는 값 (alloc / chunk / table 모두 같은 값)
+	void                        collect(uint64_t completed_value, uint64_t frame_value);
+	D3D12_CPU_DESCRIPTOR_HANDLE cpu(bindless_handle handle) const;
+	D3D12_GPU_DESCRIPTOR_HANDLE gpu(bindless_handle handle) const;
+	const bindless_allocator*   bindless() const { return &m_bindless; }
+
+	D3D12_CPU_DESCRIPTOR_HANDLE cpu_at(UINT index) const { return {m_cpu.ptr + SIZE_T(index) * m_stride}; }
+	D3D12_GPU_DESCRIPTOR_HANDLE gpu_at(UINT index) const { return {m_gpu.ptr + UINT64(index) * UINT64(m_stride)}; }
+
+	// 지금 기록 중인 signal 구간에 transient 영역으로 copy 한 table
+	// (signal 이 지나면 비움 : 이전 table 의 ring 범위는 이전 fence 로만 보호됨)
+	descriptor_table_cache* tables();
 
 	ID3D12DescriptorHeap* heap() const { return m_heap; }
-	void                  reset() { m_next = 0; }
+	uint32_t              transient_capacity() const { return uint32_t(m_ring.capacity()); }
+	uint32_t              transient_used() const { return uint32_t(m_ring.used()); }
 
 private:
+	uint32_t  reserve(uint32_t count);        // lock, 기다리지 않음
+	alloc_out at(uint32_t offset) const;
+	void      overflow(uint64_t value, UINT n);
+
 	ID3D12Device*               m_device{};
 	D3D12_DESCRIPTOR_HEAP_TYPE  m_type{D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV};
 	ID3D12DescriptorHeap*       m_heap{};
 	UINT                        m_capacity{};
 	UINT                        m_stride{};
-	UINT                        m_next{};
+	UINT                        m_transient_first{};
 	D3D12_CPU_DESCRIPTOR_HANDLE m_cpu{};
 	D3D12_GPU_DESCRIPTOR_HANDLE m_gpu{};
+	dx_timeline*                m_timeline{};
+	std::mutex                  m_lock;                    // m_ring
+	ring_allocator              m_ring;                    // [0, transient) -> m_transient_first + offset
+	uint64_t                    m_frame_value{};           // collect 에서만 바뀜, m_lock
+	descriptor_chunk_source     m_chunks;
+	std::atomic<uint64_t>       m_overflow_value{};        // 같은 frame 에서 log 를 한 번만
+	bindless_allocator          m_bindless;
+	descriptor_table_cache      m_tables;
+	uint64_t                    m_tables_value{};          // m_tables 가 유효한 timeline 값
+};
+
+enum class upload_queue : uint32_t {
+	graphics,
+	copy
 };
 
 class dx_device
@@ -62,7 +173,7 @@ public:
 	dx_device() = default;
 	~dx_device() { release(); }
 
-	void initialize(ID3D12Device* dev, ID3D12CommandQueue* gfx_queue);
+	void initialize(ID3D12Device* dev, ID3D12CommandQueue* gfx_queue, dx_timeline* gfx_timeline);
 	void release();
 
 	// Upload command list control (no lambdas)
@@ -72,6 +183,23 @@ public:
 
 	void create_buffer(const buffer_create_info* info, dx_buffer** pp_buffer);
 
+	// Batch : pp_buffers[i] <- buffers[i], out_textures[i] <- textures[i]
+	void create_resources(std::span<const buffer_create_info>  buffers,
+	                      dx_buffer**                          pp_buffers,
+	                      std::span<const texture_create_info> textures     = {},
+	                      Texture2D*                           out_textures = nullptr);
+
+	// Copy queue uploads : 반환값은 copy timeline ticket (dx_buffer::ready_value)
+	uint64_t create_buffer_async(const buffer_create_info* info, dx_buffer** pp_buffer);
+	void     flush_uploads();
+	bool     is_upload_complete(uint64_t ticket);
+	void     wait_upload(uint64_t ticket);
+	// graphics 에서 처음 사용하기 전에 호출 -> 다음 submit 전에 gpu-side wait 예약
+	void use(const dx_buffer* buffer);
+	// graphics queue ExecuteCommandLists 직전에 호출
+	void submit_queue_waits(ID3D12CommandQueue* queue);
+	dx_timeline* copy_timeline() { return &m_copy_timeline; }
+
 	// Unified buffer creators
 	// dx_buffer create_buffer_vertex(const void* data, UINT byteSize, UINT stride);
 	// dx_buffer create_buffer_index(const void* data, UINT byteSize, DXGI_FORMAT fmt);        // R16_UINT or R32_UINT
@@ -81,13 +209,56 @@ public:
 	// Textures
 	Texture2D create_texture2d_rgba8(const void* pixels, UINT width, UINT height, UINT rowStride);
 
-	// Descriptors
+	// Descriptors (transient : fence 로 retire 되는 ring, 이번 frame 을 끝내는 graphics signal 이 완료될 때까지 유효)
+	// ring 이 이번 frame 만으로 가득 차면 ptr == 0 인 handle (alloc 의 cpu.ptr == 0, log_error)
 	D3D12_GPU_DESCRIPTOR_HANDLE create_cbv_gpu(ID3D12Resource* resource, UINT byteSize);
 	D3D12_GPU_DESCRIPTOR_HANDLE create_srv_texture2d_gpu(ID3D12Resource* resource, DXGI_FORMAT format);
+	// Bindless (persistent) : release_bindless 까지 같은 index, shader 는 bindless_index 로 접근
+	bindless_handle create_cbv_bindless(ID3D12Resource* resource, UINT byteSize);
+	bindless_handle create_srv_texture2d_bindless(ID3D12Resource* resource, DXGI_FORMAT format);
+	void            release_bindless(bindless_handle handle);        // gpu 가 frame_value 를 지나면 slot 재사용
+	uint32_t        bindless_index(bindless_handle handle) const { return m_heap_cbv_srv_uav.bindless()->index(handle); }
+	// Staging (non shader visible) : 같은 view 는 하나를 공유, release_staging 까지 유효
+	// resource 를 해제하기 전에 release_staging (같은 주소의 새 resource 가 옛 view 를 받지 않게)
+	staging_descriptor create_cbv_staging(ID3D12Resource* resource, UINT byteSize);
+	staging_descriptor create_srv_texture2d_staging(ID3D12Resource* resource, DXGI_FORMAT format);
+	void               release_staging(staging_descriptor handle);
+	// views 를 transient 영역의 연속된 table 로 copy (위의 transient 와 같은 수명, 넘치면 ptr == 0, main thread)
+	// 이번 frame 에 같은 views 를 같은 순서로 copy 한 적이 있으면 그 table 을 재사용
+	D3D12_GPU_DESCRIPTOR_HANDLE copy_table(std::span<const staging_descriptor> views);
 
+	// root_signatures() 에서 공유되는 object, caller 가 Release
 	ID3D12RootSignature* create_basic_root_signature(bool sampler_in_root = false);
 
+	// PSO 는 여기서 생성 (root signature 는 root_signatures() 에서 만든 것만 사용 가능)
+	dx_pipeline_cache*       pipelines() { return &m_pipelines; }
+	dx_root_signature_cache* root_signatures() { return &m_root_signatures; }
+
 	descriptor_heap_gpu* cbv_srv_uav_heap() { return &m_heap_cbv_srv_uav; }
+	descriptor_heap_cpu* cbv_srv_uav_staging() { return &m_staging_cbv_srv_uav; }
+
+	// Staging memory : ring 이 가득 차면 가장 오래된 사용이 끝날 때까지 대기하거나
+	// (아직 submit 되지 않은 graphics 사용이면) 별도 buffer 로 spill
+	dx_staging alloc_staging(uint64_t size, uint64_t align, upload_queue queue);
+	// per-frame 데이터 (constant 등), graphics queue 가 이번 frame 에 소비
+	dx_staging alloc_frame_data(uint64_t size, uint64_t align = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+	// Deferred release : freed once the gpu passes the signal that ends this frame
+	void     defer_release(IUnknown* object, uint64_t bytes = 0);
+	void     defer_release(ID3D12Resource* resource);
+	void     collect_releases(uint64_t completed_value);        // begin_frame 에서 호출, frame_value 를 진행
+	// 이번 frame 을 끝내는 graphics signal 값 : collect_releases 에서만 바뀜
+	// frame 중에 tag 하는 것 (transient descriptor, bindless free, defer_release) 은 모두 이 값
+	uint64_t frame_value() const { return m_frame_value; }
+	// 제출된 graphics / upload 작업의 완료 대기 : 새 graphics 값을 signal 하지 않음 (frame 중에도 안전)
+	void     wait_idle();
+	uint64_t pending_release_bytes() const { return m_release_queue.pending_bytes(); }
+	uint64_t released_bytes_last_frame() const { return m_released_bytes; }
+
+	// submit 사이의 resource 상태, 모든 tracker 가 submit 순서대로 resolve
+	resource_state_registry* states() { return &m_states; }
+	// upload list (begin_upload ~ end_upload) 용 tracker
+	dx_state_tracker* upload_states() { return &m_upload_states; }
 
 	// Barrier helper
 	static void transition(ID3D12GraphicsCommandList* cl, ID3D12Resource* res, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after);
@@ -95,7 +266,9 @@ public:
 	const ID3D12Device* handle() const { return m_device; }
 
 private:
-	void            signal_and_wait();
+	void            create_copy_queue();
+	void            begin_copy();
+	dx_buffer*      make_buffer(const buffer_create_info* info, ID3D12Resource* resource);
 	ID3D12Resource* create_default_buffer(UINT64 size);
 	ID3D12Resource* create_upload_buffer(UINT64 size, const void* initData = nullptr);
 
@@ -103,13 +276,44 @@ private:
 	ID3D12Device*       m_device{};
 	ID3D12CommandQueue* m_queue{};
 
-	ID3D12CommandAllocator*    m_upload_alloc{};
-	ID3D12GraphicsCommandList* m_cmd{};
-	ID3D12Fence*               m_fence{};
-	HANDLE                     m_fence_event{};
-	UINT64                     m_fence_value{};
+	dx_timeline*        m_timeline{};
+	uint64_t            m_frame_value{};
+	// graphics queue 의 upload submit 전용 fence : graphics timeline 은 end_frame 만 signal
+	// (frame 중간에 next_value 가 바뀌면 그 frame 의 defer_release 가 일찍 풀림)
+	dx_timeline m_upload_timeline;
+
+	// upload allocator 는 사용 중인 동안 재사용 불가 -> upload timeline 완료 시 free list 로 반환
+	ID3D12CommandAllocator*              m_upload_alloc{};
+	std::vector<ID3D12CommandAllocator*> m_upload_alloc_free;
+	ID3D12GraphicsCommandList*           m_cmd{};
+	ID3D12GraphicsCommandList*           m_fixup_cmd{};        // upload list 앞의 상태 보정
+
+	resource_state_registry m_states;
+	dx_state_tracker        m_upload_states;
+	dx_barrier_batch        m_fixups;
+
+	retire_queue<IUnknown*> m_release_queue;
+	uint64_t                m_released_bytes{};
+
+	dx_upload_ring m_upload_ring;
+	uint32_t       m_ring_graphics{};
+	uint32_t       m_ring_copy{};
+
+	// copy queue
+	ID3D12CommandQueue*                  m_copy_queue{};
+	dx_timeline                          m_copy_timeline;
+	ID3D12CommandAllocator*              m_copy_alloc{};
+	std::vector<ID3D12CommandAllocator*> m_copy_alloc_free;
+	ID3D12GraphicsCommandList*           m_copy_cmd{};
+	retire_queue<IUnknown*>              m_copy_release_queue;
+	uint64_t                             m_copy_wait_value{};        // graphics 가 기다려야 할 값
+	uint64_t                             m_copy_waited_value{};      // 이미 queue 에 Wait 된 값
 
 	descriptor_heap_gpu m_heap_cbv_srv_uav;
+	descriptor_heap_cpu m_staging_cbv_srv_uav;
+
+	dx_pipeline_cache       m_pipelines;
+	dx_root_signature_cache m_root_signatures;
 };
 
 }        // namespace emt
\ No newline at end of file
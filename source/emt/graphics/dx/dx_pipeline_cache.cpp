@@ -0,0 +1,282 @@
+#include "dx_pipeline_cache.h"
+#include <emt/graphics/dxbc_container.h>
+#include <emt/graphics/hash.h>
+#include <emt/graphics/pipeline_cache_file.h>
+
+namespace emt
+{
+static void hash_shader(stable_hasher& h, const D3D12_SHADER_BYTECODE& shader)
+{
+	h.add(uint64_t(shader.BytecodeLength));
+	// DXC 의 HASH part 가 program 을 대표 : 가장 큰 DXIL / debug part 대신 digest 와 나머지 part 만
+	dxbc_container           container;
+	std::span<const uint8_t> digest;
+	if(shader.pShaderBytecode && !container.parse(shader.pShaderBytecode, shader.BytecodeLength) &&
+	   container.shader_hash(&digest)) {
+		h.add(digest.data(), digest.size());
+		for(const dxbc_part part : container) {
+			if(part.fourcc != dxbc::dxil && part.fourcc != dxbc::ildb)
+				h.add(part.fourcc).add(part.data.data(), part.data.size());
+		}
+		return;
+	}
+	h.add(shader.pShaderBytecode, shader.BytecodeLength);
+}
+
+static void hash_input_layout(stable_hasher& h, const D3D12_INPUT_LAYOUT_DESC& layout)
+{
+	h.add(layout.NumElements);
+	for(UINT i = 0; i < layout.NumElements; ++i) {
+		const D3D12_INPUT_ELEMENT_DESC& e = layout.pInputElementDescs[i];
+		h.add_string(e.SemanticName);
+		h.add(e.SemanticIndex).add(e.Format).add(e.InputSlot).add(e.AlignedByteOffset);
+		h.add(e.InputSlotClass).add(e.InstanceDataStepRate);
+	}
+}
+
+static void hash_stream_output(stable_hasher& h, const D3D12_STREAM_OUTPUT_DESC& so)
+{
+	h.add(so.NumEntries);
+	for(UINT i = 0; i < so.NumEntries; ++i) {
+		const D3D12_SO_DECLARATION_ENTRY& e = so.pSODeclaration[i];
+		h.add(e.Stream);
+		h.add_string(e.SemanticName);
+		h.add(e.SemanticIndex).add(e.StartComponent).add(e.ComponentCount).add(e.OutputSlot);
+	}
+	h.add(so.NumStrides);
+	h.add(so.pBufferStrides, sizeof(UINT) * so.NumStrides);
+	h.add(so.RasterizedStream);
+}
+
+// UINT8 write mask 뒤의 padding 때문에 field 단위로
+static void hash_blend(stable_hasher& h, const D3D12_BLEND_DESC& blend)
+{
+	h.add(blend.AlphaToCoverageEnable).add(blend.IndependentBlendEnable);
+	for(const D3D12_RENDER_TARGET_BLEND_DESC& rt : blend.RenderTarget) {
+		h.add(rt.BlendEnable).add(rt.LogicOpEnable);
+		h.add(rt.SrcBlend).add(rt.DestBlend).add(rt.BlendOp);
+		h.add(rt.SrcBlendAlpha).add(rt.DestBlendAlpha).add(rt.BlendOpAlpha);
+		h.add(rt.LogicOp).add(rt.RenderTargetWriteMask);
+	}
+}
+
+static void hash_depth_stencil(stable_hasher& h, const D3D12_DEPTH_STENCIL_DESC& ds)
+{
+	h.add(ds.DepthEnable).add(ds.DepthWriteMask).add(ds.DepthFunc);
+	h.add(ds.StencilEnable).add(ds.StencilReadMask).add(ds.StencilWriteMask);
+	h.add(ds.FrontFace).add(ds.BackFace);
+}
+
+uint64_t dx_pipeline_cache::hash(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t root_signature_hash)
+{
+	stable_hasher h;
+	h.add(uint32_t(0));        // graphics
+	h.add(root_signature_hash);
+	hash_shader(h, desc.VS);
+	hash_shader(h, desc.PS);
+	hash_shader(h, desc.DS);
+	hash_shader(h, desc.HS);
+	hash_shader(h, desc.GS);
+	hash_stream_output(h, desc.StreamOutput);
+	hash_blend(h, desc.BlendState);
+	h.add(desc.SampleMask);
+	h.add(desc.RasterizerState);
+	hash_depth_stencil(h, desc.DepthStencilState);
+	hash_input_layout(h, desc.InputLayout);
+	h.add(desc.IBStripCutValue).add(desc.PrimitiveTopologyType);
+	h.add(desc.NumRenderTargets);
+	for(UINT i = 0; i < desc.NumRenderTargets && i < 8; ++i)
+		h.add(desc.RTVFormats[i]);
+	h.add(desc.DSVFormat).add(desc.SampleDesc.Count).add(desc.SampleDesc.Quality);
+	h.add(desc.NodeMask).add(desc.Flags);
+	return h.value();
+}
+
+uint64_t dx_pipeline_cache::hash(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, uint64_t root_signature_hash)
+{
+	stable_hasher h;
+	h.add(uint32_t(1));        // compute
+	h.add(root_signature_hash);
+	hash_shader(h, desc.CS);
+	h.add(desc.NodeMask).add(desc.Flags);
+	return h.value();
+}
+
+void dx_pipeline_cache::initialize(ID3D12Device* device, const char* path, uint64_t identity)
+{
+	m_device   = device;
+	m_path     = path;
+	m_identity = identity;
+
+	ID3D12Device1* device1{};
+	if(FAILED(device->QueryInterface(IID_PPV_ARGS(&device1)))) {
+		log_warn("ID3D12Device1 unavailable, pipelines are cached in memory only");
+		return;
+	}
+
+	HRESULT hr = E_FAIL;
+	if(load_pipeline_cache(path, identity, &m_library_data)) {
+		hr = device1->CreatePipelineLibrary(m_library_data.data(), m_library_data.size(), IID_PPV_ARGS(&m_library));
+		if(FAILED(hr))
+			log_warn("pipeline library rejected (0x%08X), starting empty", unsigned(hr));
+	}
+	if(FAILED(hr)) {
+		m_library_data.clear();
+		hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_library));
+	}
+	safe_release(device1);
+	if(FAILED(hr)) {
+		log_warn("pipeline library unsupported (0x%08X), pipelines are cached in memory only", unsigned(hr));
+		m_library = nullptr;
+		return;
+	}
+	log_info("pipeline library : %zu bytes loaded", m_library_data.size());
+}
+
+void dx_pipeline_cache::release()
+{
+	save();
+	for(auto& [key, pso] : m_pipelines) {
+		safe_release(pso);
+	}
+	m_pipelines.clear();
+	m_root_signatures.clear();
+	safe_release(m_library);
+	m_library_data.clear();
+	m_device = nullptr;
+}
+
+bool dx_pipeline_cache::save()
+{
+	if(!m_library || !m_dirty)
+		return true;
+
+	std::vector<uint8_t> data(m_library->GetSerializedSize());
+	if(FAILED(m_library->Serialize(data.data(), data.size()))) {
+		log_error("failed to serialize the pipeline library");
+		return false;
+	}
+	if(!save_pipeline_cache(m_path.c_str(), m_identity, data.data(), data.size()))
+		return false;
+	m_dirty = false;
+	log_info("pipeline library : %zu bytes saved", data.size());
+	return true;
+}
+
+void dx_pipeline_cache::register_root_signature(ID3D12RootSignature* root_signature, const void* blob, size_t size)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_root_signatures[root_signature] = stable_hash(blob, size);
+}
+
+void dx_pipeline_cache::unregister_root_signature(ID3D12RootSignature* root_signature)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_root_signatures.erase(root_signature);
+}
+
+bool dx_pipeline_cache::root_signature_hash(ID3D12RootSignature* root_signature, uint64_t* out) const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto it = m_root_signatures.find(root_signature);
+	if(it == m_root_signatures.end())
+		return false;
+	*out = it->second;
+	return true;
+}
+
+template<typename Desc, typename Load, typename Create>
+ID3D12PipelineState* dx_pipeline_cache::find_or_create(const Desc& desc, Load&& load, Create&& create)
+{
+	// pointer 로 대신하면 해제된 root signature 의 주소를 새 object 가 받을 때 다른 PSO 가 나옴
+	uint64_t rs_hash = 0;
+	if(!root_signature_hash(desc.pRootSignature, &rs_hash)) {
+		log_assert(0, "root signature is not registered, create it through dx_root_signature_cache");
+		return nullptr;
+	}
+	const bool     persist = m_library != nullptr;
+	const uint64_t key     = hash(desc, rs_hash);
+
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		auto it = m_pipelines.find(key);
+		if(it != m_pipelines.end()) {
+			++m_stats.hits;
+			return it->second;
+		}
+	}
+
+	// driver compile 은 lock 밖에서 : 다른 thread 의 다른 PSO 를 막지 않음
+	wchar_t name[17]{};
+	swprintf(name, std::size(name), L"%016llx", static_cast<unsigned long long>(key));
+
+	ID3D12PipelineState* pso{};
+	bool                 loaded = false;
+	if(persist) {
+		HRESULT hr = load(name, &pso);
+		loaded     = SUCCEEDED(hr);
+		// E_INVALIDARG : library 에 없음
+		if(FAILED(hr) && hr != E_INVALIDARG)
+			log_warn("pipeline %ls load failed (0x%08X)", name, unsigned(hr));
+	}
+	if(!loaded) {
+		HR(create(&pso));
+		if(persist) {
+			// 같은 key 를 다른 thread 가 먼저 저장했으면 E_INVALIDARG, 무시
+			if(SUCCEEDED(m_library->StorePipeline(name, pso))) {
+				std::lock_guard<std::mutex> lock(m_lock);
+				m_dirty = true;
+			}
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto [it, inserted] = m_pipelines.emplace(key, pso);
+	if(!inserted) {
+		// 동시에 만든 같은 PSO : 먼저 들어간 것을 사용
+		safe_release(pso);
+		++m_stats.hits;
+		return it->second;
+	}
+	++(loaded ? m_stats.loads : m_stats.compiles);
+	return pso;
+}
+
+bool dx_pipeline_cache::evict(ID3D12PipelineState* pso)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	// hot reload 에서만 쓰이므로 선형 탐색
+	for(auto it = m_pipelines.begin(); it != m_pipelines.end(); ++it) {
+		if(it->second == pso) {
+			m_pipelines.erase(it);
+			return true;
+		}
+	}
+	return false;
+}
+
+ID3D12PipelineState* dx_pipeline_cache::graphics(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+	return find_or_create(
+	    desc,
+	    [&](const wchar_t* name, ID3D12PipelineState** pso) {
+		    return m_library->LoadGraphicsPipeline(name, &desc, IID_PPV_ARGS(pso));
+	    },
+	    [&](ID3D12PipelineState** pso) {
+		    return m_device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(pso));
+	    });
+}
+
+ID3D12PipelineState* dx_pipeline_cache::compute(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc)
+{
+	return find_or_create(
+	    desc,
+	    [&](const wchar_t* name, ID3D12PipelineState** pso) {
+		    return m_library->LoadComputePipeline(name, &desc, IID_PPV_ARGS(pso));
+	    },
+	    [&](ID3D12PipelineState** pso) {
+		    return m_device->CreateComputePipelineState(&desc, IID_PPV_ARGS(pso));
+	    });
+}
+
+}        // namespace emt
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "dx_config.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace emt
+{
+// PSO cache : desc 전체의 stable hash -> ID3D12PipelineState
+//  - 메모리 : 같은 desc 는 한 번만 생성
+//  - disk   : ID3D12PipelineLibrary 에 저장, 다음 실행에서는 driver compile 없이 load
+// root signature 는 pointer 대신 serialize 된 blob 의 hash 로 key 에 들어감
+// 등록되지 않은 root signature 는 사용할 수 없음 (pointer 는 해제 후 재사용될 수 있어 key 가 되지 못함)
+// 여러 thread 에서 호출 가능
+class dx_pipeline_cache
+{
+public:
+	dx_pipeline_cache() = default;
+	~dx_pipeline_cache() { release(); }
+
+	// path 의 파일이 identity 와 맞으면 library 로 사용, 아니면 빈 library
+	void initialize(ID3D12Device* device, const char* path, uint64_t identity);
+	// 새 PSO 가 있으면 저장 후 모든 PSO 해제
+	void release();
+	bool save();
+
+	// dx_root_signature_cache 가 만들 때 등록, 해제 전에 unregister
+	void register_root_signature(ID3D12RootSignature* root_signature, const void* blob, size_t size);
+	void unregister_root_signature(ID3D12RootSignature* root_signature);
+
+	// 반환된 PSO 는 cache 소유 (Release 하지 말 것)
+	ID3D12PipelineState* graphics(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+	ID3D12PipelineState* compute(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc);
+	// 메모리 cache 에서 제거, true 면 소유권이 caller 로 (gpu 가 끝난 뒤 Release)
+	// library 에 저장된 것은 지울 수 없으므로 다음 실행에서도 load 가능한 채로 남음
+	bool evict(ID3D12PipelineState* pso);
+
+	// device 없이 계산 가능, root signature 는 hash 로 대신함
+	static uint64_t hash(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t root_signature_hash);
+	static uint64_t hash(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, uint64_t root_signature_hash);
+
+	struct stats
+	{
+		uint32_t hits;        // 메모리에서 찾음
+		uint32_t loads;       // library 에서 load
+		uint32_t compiles;        // driver compile
+	};
+	stats    statistics() const { return m_stats; }
+	uint32_t size() const { return uint32_t(m_pipelines.size()); }
+
+private:
+	// false : 등록되지 않음
+	bool root_signature_hash(ID3D12RootSignature* root_signature, uint64_t* out) const;
+
+	template<typename Desc, typename Load, typename Create>
+	ID3D12PipelineState* find_or_create(const Desc& desc, Load&& load, Create&& create);
+
+	ID3D12Device*          m_device{};
+	ID3D12PipelineLibrary* m_library{};
+	std::vector<uint8_t>   m_library_data;        // library 가 살아있는 동안 유지해야 함
+	std::string            m_path;
+	uint64_t               m_identity{};
+	bool                   m_dirty{};
+
+	mutable std::mutex                                       m_lock;
+	std::unordered_map<uint64_t, ID3D12PipelineState*>       m_pipelines;
+	std::unordered_map<const ID3D12RootSignature*, uint64_t> m_root_signatures;
+	stats                                                    m_stats{};
+};
+
+}        // namespace emt
@@ -0,0 +1,74 @@
+#include "dx_render_graph.h"
+
+namespace emt
+{
+void dx_render_graph::reset()
+{
+	m_graph.reset();
+	m_resources.clear();
+	m_functions.clear();
+	m_compiled = false;
+}
+
+rg_handle dx_render_graph::import_resource(const char* name, ID3D12Resource* resource, resource_state initial, resource_state final)
+{
+	rg_handle h = m_graph.import_resource(name, initial, final);
+	m_resources.push_back(resource);
+	return h;
+}
+
+rg_handle dx_render_graph::create_resource(const char* name)
+{
+	rg_handle h = m_graph.create_resource(name);
+	m_resources.push_back(nullptr);
+	return h;
+}
+
+void dx_render_graph::bind(rg_handle handle, ID3D12Resource* resource)
+{
+	log_assert(handle.resource < m_resources.size(), "invalid render graph handle");
+	m_resources[handle.resource] = resource;
+}
+
+uint32_t dx_render_graph::add_pass(const char* name, execute_function fn, bool never_cull)
+{
+	m_functions.push_back(std::move(fn));
+	return m_graph.add_pass(name, never_cull);
+}
+
+bool dx_render_graph::execute(ID3D12GraphicsCommandList* cmd)
+{
+	m_compiled = m_graph.compile();
+	if(!m_compiled)
+		return false;
+
+	for(uint32_t pass : m_graph.order()) {
+		uint32_t          count    = 0;
+		const rg_barrier* barriers = m_graph.barriers(pass, &count);
+		record(cmd, barriers, count);
+		if(m_functions[pass])
+			m_functions[pass](cmd);
+	}
+	return true;
+}
+
+void dx_render_graph::record_final_barriers(ID3D12GraphicsCommandList* cmd)
+{
+	if(!m_compiled)
+		return;
+	const std::vector<rg_barrier>& finals = m_graph.final_barriers();
+	record(cmd, finals.data(), uint32_t(finals.size()));
+}
+
+void dx_render_graph::record(ID3D12GraphicsCommandList* cmd, const rg_barrier* barriers, uint32_t count)
+{
+	for(uint32_t i = 0; i < count; ++i) {
+		const rg_barrier& rb  = barriers[i];
+		ID3D12Resource*   res = m_resources[rb.resource];
+		log_assert(res, "render graph resource is not bound");
+		m_batch.add(res, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, rb.before, rb.after);
+	}
+	m_batch.record(cmd);
+}
+
+}        // namespace emt
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "dx_config.h"
+#include "dx_barrier_batch.h"
+#include <emt/graphics/render_graph.h>
+#include <functional>
+#include <vector>
+
+namespace emt
+{
+// D3D12 front of render_graph : binds ID3D12Resource to graph resources and
+// records the compiled passes, each preceded by its barriers in one ResourceBarrier call.
+// Rebuilt every frame (reset -> declare -> execute).
+class dx_render_graph
+{
+public:
+	typedef std::function<void(ID3D12GraphicsCommandList*)> execute_function;
+
+	void reset();
+
+	rg_handle import_resource(const char* name, ID3D12Resource* resource, resource_state initial, resource_state final);
+	// transient : 호출자가 first_state() 상태로 만든 resource 를 execute 전에 bind
+	rg_handle create_resource(const char* name);
+	void      bind(rg_handle handle, ID3D12Resource* resource);
+
+	uint32_t  add_pass(const char* name, execute_function fn, bool never_cull = false);
+	void      read(uint32_t pass, rg_handle handle, resource_state state) { m_graph.read(pass, handle, state); }
+	rg_handle write(uint32_t pass, rg_handle handle, resource_state state) { return m_graph.write(pass, handle, state); }
+
+	// compile 후 살아남은 pass 를 순서대로 기록, false : cycle (아무것도 기록 안 함)
+	bool execute(ID3D12GraphicsCommandList* cmd);
+	// imported resource 를 final 상태로 되돌림 (frame 의 마지막 list 에 기록)
+	void record_final_barriers(ID3D12GraphicsCommandList* cmd);
+
+	render_graph&       graph() { return m_graph; }
+	const render_graph& graph() const { return m_graph; }
+
+private:
+	void record(ID3D12GraphicsCommandList* cmd, const rg_barrier* barriers, uint32_t count);
+
+	render_graph                  m_graph;
+	std::vector<ID3D12Resource*>  m_resources;
+	std::vector<execute_function> m_functions;
+	dx_barrier_batch              m_batch;
+	bool                          m_compiled = false;
+};
+
+}        // namespace emt
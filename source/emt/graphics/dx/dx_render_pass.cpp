@@ -0,0 +1,144 @@
+#include "dx_render_pass.h"
+
+namespace emt
+{
+D3D12_RENDER_PASS_BEGINNING_ACCESS_TYPE dx_render_pass::beginning_type(render_pass_access access)
+{
+	switch(access) {
+		case render_pass_access::clear:
+			return D3D12_RENDER_PASS_BEGINNING_ACCESS_TYPE_CLEAR;
+		case render_pass_access::discard:
+			return D3D12_RENDER_PASS_BEGINNING_ACCESS_TYPE_DISCARD;
+		case render_pass_access::no_access:
+			return D3D12_RENDER_PASS_BEGINNING_ACCESS_TYPE_NO_ACCESS;
+		default:
+			return D3D12_RENDER_PASS_BEGINNING_ACCESS_TYPE_PRESERVE;
+	}
+}
+
+D3D12_RENDER_PASS_ENDING_ACCESS_TYPE dx_render_pass::ending_type(render_pass_access access)
+{
+	switch(access) {
+		case render_pass_access::discard:
+			return D3D12_RENDER_PASS_ENDING_ACCESS_TYPE_DISCARD;
+		case render_pass_access::no_access:
+			return D3D12_RENDER_PASS_ENDING_ACCESS_TYPE_NO_ACCESS;
+		default:
+			return D3D12_RENDER_PASS_ENDING_ACCESS_TYPE_PRESERVE;
+	}
+}
+
+bool dx_render_pass::begin(ID3D12GraphicsCommandList* cmd, const render_pass_desc& desc,
+                           const dx_render_target* colors, const dx_render_target* depth)
+{
+	log_assert(!m_cmd, "render pass already begun");
+	if(const char* error = validate_render_pass(desc)) {
+		log_error("invalid render pass : %s", error);
+		return false;
+	}
+	log_assert(!desc.has_depth || depth, "render pass expects a depth target");
+
+	m_cmd           = cmd;
+	m_discard_count = 0;
+	if(SUCCEEDED(cmd->QueryInterface(IID_PPV_ARGS(&m_cmd4)))) {
+		begin_native(desc, colors, depth);
+	}
+	else {
+		begin_fallback(desc, colors, depth);
+	}
+	return true;
+}
+
+void dx_render_pass::end()
+{
+	if(!m_cmd)
+		return;
+	if(m_cmd4) {
+		m_cmd4->EndRenderPass();
+		safe_release(m_cmd4);
+	}
+	else {
+		for(uint32_t i = 0; i < m_discard_count; ++i)
+			m_cmd->DiscardResource(m_discards[i], nullptr);
+	}
+	m_cmd           = nullptr;
+	m_discard_count = 0;
+}
+
+void dx_render_pass::begin_native(const render_pass_desc& desc, const dx_render_target* colors, const dx_render_target* depth)
+{
+	D3D12_RENDER_PASS_RENDER_TARGET_DESC rts[MAX_RENDER_PASS_COLORS]{};
+	for(uint32_t i = 0; i < desc.color_count; ++i) {
+		const render_pass_attachment& a = desc.colors[i];
+		D3D12_RENDER_PASS_RENDER_TARGET_DESC& rt = rts[i];
+
+		rt.cpuDescriptor        = colors[i].view;
+		rt.BeginningAccess.Type = beginning_type(render_pass_begin_access(a.load, a.store));
+		rt.EndingAccess.Type    = ending_type(render_pass_end_access(a.store));
+		if(rt.BeginningAccess.Type == D3D12_RENDER_PASS_BEGINNING_ACCESS_TYPE_CLEAR) {
+			rt.BeginningAccess.Clear.ClearValue.Format = colors[i].format;
+			for(uint32_t c = 0; c < 4; ++c)
+				rt.BeginningAccess.Clear.ClearValue.Color[c] = a.clear_color[c];
+		}
+	}
+
+	D3D12_RENDER_PASS_DEPTH_STENCIL_DESC ds{};
+	if(desc.has_depth) {
+		const render_pass_attachment& d = desc.depth;
+
+		ds.cpuDescriptor               = depth->view;
+		ds.DepthBeginningAccess.Type   = beginning_type(render_pass_begin_access(d.load, d.store));
+		ds.DepthEndingAccess.Type      = ending_type(render_pass_end_access(d.store));
+		ds.StencilBeginningAccess.Type = beginning_type(render_pass_begin_access(d.stencil_load, d.stencil_store));
+		ds.StencilEndingAccess.Type    = ending_type(render_pass_end_access(d.stencil_store));
+
+		D3D12_CLEAR_VALUE clear{};
+		clear.Format               = depth->format;
+		clear.DepthStencil.Depth   = d.clear_depth;
+		clear.DepthStencil.Stencil = d.clear_stencil;
+		ds.DepthBeginningAccess.Clear.ClearValue   = clear;
+		ds.StencilBeginningAccess.Clear.ClearValue = clear;
+	}
+
+	const D3D12_RENDER_PASS_FLAGS flags = desc.uav_writes ? D3D12_RENDER_PASS_FLAG_ALLOW_UAV_WRITES : D3D12_RENDER_PASS_FLAG_NONE;
+	m_cmd4->BeginRenderPass(desc.color_count, rts, desc.has_depth ? &ds : nullptr, flags);
+}
+
+void dx_render_pass::begin_fallback(const render_pass_desc& desc, const dx_render_target* colors, const dx_render_target* depth)
+{
+	D3D12_CPU_DESCRIPTOR_HANDLE views[MAX_RENDER_PASS_COLORS]{};
+	for(uint32_t i = 0; i < desc.color_count; ++i) {
+		const render_pass_attachment& a      = desc.colors[i];
+		const render_pass_access      access = render_pass_begin_access(a.load, a.store);
+		views[i]                             = colors[i].view;
+
+		if(access == render_pass_access::clear)
+			m_cmd->ClearRenderTargetView(colors[i].view, a.clear_color, 0, nullptr);
+		else if(access == render_pass_access::discard && colors[i].resource)
+			m_cmd->DiscardResource(colors[i].resource, nullptr);
+
+		if(render_pass_end_access(a.store) == render_pass_access::discard && colors[i].resource)
+			m_discards[m_discard_count++] = colors[i].resource;
+	}
+
+	if(desc.has_depth) {
+		const render_pass_attachment& d     = desc.depth;
+		D3D12_CLEAR_FLAGS             clear = D3D12_CLEAR_FLAGS(0);
+		if(render_pass_begin_access(d.load, d.store) == render_pass_access::clear)
+			clear |= D3D12_CLEAR_FLAG_DEPTH;
+		if(render_pass_begin_access(d.stencil_load, d.stencil_store) == render_pass_access::clear)
+			clear |= D3D12_CLEAR_FLAG_STENCIL;
+		if(clear)
+			m_cmd->ClearDepthStencilView(depth->view, clear, d.clear_depth, d.clear_stencil, 0, nullptr);
+
+		// depth 와 stencil 이 모두 버려질 때만 resource 전체 discard
+		const bool discard_depth   = render_pass_end_access(d.store) != render_pass_access::preserve;
+		const bool discard_stencil = render_pass_end_access(d.stencil_store) != render_pass_access::preserve;
+		if(discard_depth && discard_stencil && depth->resource)
+			m_discards[m_discard_count++] = depth->resource;
+	}
+
+	m_cmd->OMSetRenderTargets(desc.color_count, views, FALSE, desc.has_depth ? &depth->view : nullptr);
+}
+
+}        // namespace emt
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "dx_config.h"
+#include <emt/graphics/render_pass.h>
+
+namespace emt
+{
+struct dx_render_target
+{
+	D3D12_CPU_DESCRIPTOR_HANDLE view{};
+	ID3D12Resource*             resource{};
+	DXGI_FORMAT                 format{DXGI_FORMAT_UNKNOWN};
+};
+
+// begin/end around the draws of one pass.
+// Uses ID3D12GraphicsCommandList4::BeginRenderPass when the list supports it,
+// otherwise binds the targets, clears and issues DiscardResource by hand.
+// The desc is validated first, an invalid pass is logged and not begun.
+class dx_render_pass
+{
+public:
+	bool begin(ID3D12GraphicsCommandList* cmd, const render_pass_desc& desc,
+	           const dx_render_target* colors, const dx_render_target* depth = nullptr);
+	void end();
+
+	bool active() const { return m_cmd != nullptr; }
+
+	static D3D12_RENDER_PASS_BEGINNING_ACCESS_TYPE beginning_type(render_pass_access access);
+	static D3D12_RENDER_PASS_ENDING_ACCESS_TYPE    ending_type(render_pass_access access);
+
+private:
+	void begin_native(const render_pass_desc& desc, const dx_render_target* colors, const dx_render_target* depth);
+	void begin_fallback(const render_pass_desc& desc, const dx_render_target* colors, const dx_render_target* depth);
+
+	ID3D12GraphicsCommandList*  m_cmd{};
+	ID3D12GraphicsCommandList4* m_cmd4{};
+
+	// fallback : end 에서 discard 할 resource
+	ID3D12Resource* m_discards[MAX_RENDER_PASS_COLORS + 1]{};
+	uint32_t        m_discard_count{};
+};
+
+}        // namespace emt
@@ -0,0 +1,210 @@
+#include "dx_root_signature_cache.h"
+#include "dx_pipeline_cache.h"
+#include <emt/graphics/hash.h>
+
+namespace emt
+{
+uint64_t dx_root_signature_cache::hash(const D3D12_ROOT_SIGNATURE_DESC1& desc)
+{
+	stable_hasher h;
+	h.add(desc.NumParameters);
+	for(UINT i = 0; i < desc.NumParameters; ++i) {
+		const D3D12_ROOT_PARAMETER1& p = desc.pParameters[i];
+		h.add(p.ParameterType).add(p.ShaderVisibility);
+		// union 은 쓰이는 쪽만
+		switch(p.ParameterType) {
+			case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+				h.add(p.DescriptorTable.NumDescriptorRanges);
+				for(UINT r = 0; r < p.DescriptorTable.NumDescriptorRanges; ++r)
+					h.add(p.DescriptorTable.pDescriptorRanges[r]);
+				break;
+			case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+				h.add(p.Constants);
+				break;
+			default:
+				h.add(p.Descriptor);
+				break;
+		}
+	}
+	h.add(desc.NumStaticSamplers);
+	h.add(desc.pStaticSamplers, sizeof(D3D12_STATIC_SAMPLER_DESC) * desc.NumStaticSamplers);
+	h.add(desc.Flags);
+	return h.value();
+}
+
+void dx_root_signature_cache::initialize(ID3D12Device* device, dx_pipeline_cache* pipelines, const char* path)
+{
+	m_device    = device;
+	m_pipelines = pipelines;
+	m_path      = path;
+
+	D3D12_FEATURE_DATA_ROOT_SIGNATURE feature{D3D_ROOT_SIGNATURE_VERSION_1_1};
+	if(FAILED(m_device->CheckFeatureSupport(D3D12_FEATURE_ROOT_SIGNATURE, &feature, sizeof(feature))))
+		feature.HighestVersion = D3D_ROOT_SIGNATURE_VERSION_1_0;
+	m_version = feature.HighestVersion;
+
+	// blob 형식은 serialize 한 version 에 따라 다름
+	std::vector<uint8_t> payload;
+	if(load_pipeline_cache(path, uint64_t(m_version), &payload) &&
+	   !unpack_blob_table(payload.data(), payload.size(), &m_blobs)) {
+		log_warn("root signature cache ignored (bad table) : %s", path);
+		m_blobs.clear();
+	}
+	log_debug("root signature cache : %zu blobs loaded", m_blobs.size());
+}
+
+void dx_root_signature_cache::release()
+{
+	save();
+	for(auto& [key, rs] : m_signatures) {
+		if(m_pipelines)
+			m_pipelines->unregister_root_signature(rs);
+		safe_release(rs);
+	}
+	m_signatures.clear();
+	m_blobs.clear();
+	m_device    = nullptr;
+	m_pipelines = nullptr;
+}
+
+bool dx_root_signature_cache::save()
+{
+	if(!m_dirty)
+		return true;
+	std::vector<uint8_t> payload;
+	pack_blob_table(m_blobs, &payload);
+	if(!save_pipeline_cache(m_path.c_str(), uint64_t(m_version), payload.data(), payload.size()))
+		return false;
+	m_dirty = false;
+	return true;
+}
+
+ID3D12RootSignature* dx_root_signature_cache::get(const D3D12_ROOT_SIGNATURE_DESC1& desc)
+{
+	const uint64_t key = hash(desc);
+
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto it = m_signatures.find(key);
+	if(it != m_signatures.end()) {
+		++m_stats.hits;
+		return it->second;
+	}
+
+	std::vector<uint8_t>& blob   = m_blobs[key];
+	ID3D12RootSignature*  rs     = nullptr;
+	bool                  cached = !blob.empty();
+	if(cached && FAILED(m_device->CreateRootSignature(0, blob.data(), blob.size(), IID_PPV_ARGS(&rs)))) {
+		log_warn("cached root signature %016llx rejected, serializing again", static_cast<unsigned long long>(key));
+		cached = false;
+	}
+
+	if(!cached) {
+		D3D12_VERSIONED_ROOT_SIGNATURE_DESC versioned{};
+		versioned.Version  = D3D_ROOT_SIGNATURE_VERSION_1_1;
+		versioned.Desc_1_1 = desc;
+
+		ID3DBlob* serialized{};
+		ID3DBlob* err{};
+		HRESULT   hr = D3DX12SerializeVersionedRootSignature(&versioned, m_version, &serialized, &err);
+		if(FAILED(hr) && err)
+			log_error("root signature : %s", static_cast<const char*>(err->GetBufferPointer()));
+		safe_release(err);
+		HR(hr);
+
+		const uint8_t* p = static_cast<const uint8_t*>(serialized->GetBufferPointer());
+		blob.assign(p, p + serialized->GetBufferSize());
+		safe_release(serialized);
+		m_dirty = true;
+
+		HR(m_device->CreateRootSignature(0, blob.data(), blob.size(), IID_PPV_ARGS(&rs)));
+	}
+	++(cached ? m_stats.blob_loads : m_stats.serializes);
+
+	if(m_pipelines)
+		m_pipelines->register_root_signature(rs, blob.data(), blob.size());
+	m_signatures.emplace(key, rs);
+	return rs;
+}
+
+static D3D12_SHADER_VISIBILITY shader_visibility(uint32_t stages)
+{
+	if(stages == shader_stage_bit(shader_stage::vertex))
+		return D3D12_SHADER_VISIBILITY_VERTEX;
+	if(stages == shader_stage_bit(shader_stage::pixel))
+		return D3D12_SHADER_VISIBILITY_PIXEL;
+	if(stages == shader_stage_bit(shader_stage::geometry))
+		return D3D12_SHADER_VISIBILITY_GEOMETRY;
+	if(stages == shader_stage_bit(shader_stage::hull))
+		return D3D12_SHADER_VISIBILITY_HULL;
+	if(stages == shader_stage_bit(shader_stage::domain))
+		return D3D12_SHADER_VISIBILITY_DOMAIN;
+	if(stages == shader_stage_bit(shader_stage::mesh))
+		return D3D12_SHADER_VISIBILITY_MESH;
+	return D3D12_SHADER_VISIBILITY_ALL;        // compute 포함
+}
+
+static D3D12_DESCRIPTOR_RANGE_TYPE range_type(shader_resource_type type)
+{
+	switch(type) {
+		case shader_resource_type::cbv: return D3D12_DESCRIPTOR_RANGE_TYPE_CBV;
+		case shader_resource_type::srv: return D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+		case shader_resource_type::uav: return D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+		default: return D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER;
+	}
+}
+
+ID3D12RootSignature* dx_root_signature_cache::get(std::span<const shader_reflection* const> shaders, root_layout_plan* plan)
+{
+	root_layout_plan local;
+	root_layout_plan& p = plan ? *plan : local;
+	plan_root_layout(shaders, &p);
+	log_assert(p.dword_cost() <= D3D12_MAX_ROOT_COST, "reflected root signature exceeds 64 DWORDs");
+
+	std::vector<CD3DX12_DESCRIPTOR_RANGE1> ranges(p.ranges.size());
+	for(size_t i = 0; i < p.ranges.size(); ++i) {
+		const root_range_plan& r = p.ranges[i];
+		// create_basic_root_signature 와 같이 1.0 과 같은 동작 (sampler 는 data flag 를 쓸 수 없음)
+		const D3D12_DESCRIPTOR_RANGE_FLAGS flags = r.type == shader_resource_type::sampler
+		                                               ? D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE
+		                                               : D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE |
+		                                                     D3D12_DESCRIPTOR_RANGE_FLAG_DATA_VOLATILE;
+		ranges[i].Init(range_type(r.type), r.count ? r.count : UINT_MAX, r.slot, r.space, flags, r.offset);
+	}
+
+	std::vector<CD3DX12_ROOT_PARAMETER1> params(p.parameters.size());
+	for(size_t i = 0; i < p.parameters.size(); ++i) {
+		const root_parameter_plan&    rp  = p.parameters[i];
+		const D3D12_SHADER_VISIBILITY vis = shader_visibility(rp.stages);
+		if(rp.kind == root_parameter_kind::cbv) {
+			const shader_binding& b = p.bindings[rp.binding];
+			params[i].InitAsConstantBufferView(b.slot, b.space, D3D12_ROOT_DESCRIPTOR_FLAG_DATA_VOLATILE, vis);
+			continue;
+		}
+		params[i].InitAsDescriptorTable(rp.range_count, ranges.data() + rp.first_range, vis);
+	}
+
+	D3D12_ROOT_SIGNATURE_DESC1 rsd{};
+	rsd.NumParameters = UINT(params.size());
+	rsd.pParameters   = params.data();
+	if(p.input_assembler)
+		rsd.Flags |= D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+	// graphics pipeline 에서 쓰지 않는 stage 는 root argument 를 보지 않도록
+	if(!(p.stages & shader_stage_bit(shader_stage::compute))) {
+		const std::pair<shader_stage, D3D12_ROOT_SIGNATURE_FLAGS> deny[] = {
+		    {shader_stage::vertex, D3D12_ROOT_SIGNATURE_FLAG_DENY_VERTEX_SHADER_ROOT_ACCESS},
+		    {shader_stage::hull, D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS},
+		    {shader_stage::domain, D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS},
+		    {shader_stage::geometry, D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS},
+		    {shader_stage::pixel, D3D12_ROOT_SIGNATURE_FLAG_DENY_PIXEL_SHADER_ROOT_ACCESS},
+		    {shader_stage::mesh, D3D12_ROOT_SIGNATURE_FLAG_DENY_MESH_SHADER_ROOT_ACCESS},
+		};
+		for(const auto& [stage, flag] : deny) {
+			if(!(p.stages & shader_stage_bit(stage)))
+				rsd.Flags |= flag;
+		}
+		rsd.Flags |= D3D12_ROOT_SIGNATURE_FLAG_DENY_AMPLIFICATION_SHADER_ROOT_ACCESS;
+	}
+	return get(rsd);
+}
+
+}        // namespace emt
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "dx_config.h"
+#include <emt/graphics/pipeline_cache_file.h>
+#include <emt/graphics/shader_reflection.h>
+#include <mutex>
+#include <string>
+
+namespace emt
+{
+class dx_pipeline_cache;
+
+// Root signature cache : D3D12_ROOT_SIGNATURE_DESC1 의 canonical hash -> ID3D12RootSignature
+//  - 같은 layout 은 같은 object (PSO 변형과 root signature 교체가 줄어듦)
+//  - serialize 된 blob 은 disk 에 남겨 다음 실행에서 Serialize 를 건너뜀
+// 만든 root signature 는 pipeline cache 에 등록되어 PSO 도 disk 에 남음
+class dx_root_signature_cache
+{
+public:
+	dx_root_signature_cache() = default;
+	~dx_root_signature_cache() { release(); }
+
+	void initialize(ID3D12Device* device, dx_pipeline_cache* pipelines, const char* path);
+	void release();
+	bool save();
+
+	// 반환된 root signature 는 cache 소유 (Release 하지 말 것)
+	ID3D12RootSignature* get(const D3D12_ROOT_SIGNATURE_DESC1& desc);
+	// shader reflection 에서 만든 최소 root signature (plan_root_layout)
+	// plan : binding 이름 -> root parameter / table offset, 필요 없으면 nullptr
+	ID3D12RootSignature* get(std::span<const shader_reflection* const> shaders, root_layout_plan* plan = nullptr);
+
+	// device 없이 계산 가능, pointer 가 아닌 내용만 사용
+	static uint64_t hash(const D3D12_ROOT_SIGNATURE_DESC1& desc);
+
+	struct stats
+	{
+		uint32_t hits;              // 메모리에서 찾음
+		uint32_t blob_loads;        // disk blob 으로 생성
+		uint32_t serializes;        // Serialize 후 생성
+	};
+	stats    statistics() const { return m_stats; }
+	uint32_t size() const { return uint32_t(m_signatures.size()); }
+
+private:
+	ID3D12Device*              m_device{};
+	dx_pipeline_cache*         m_pipelines{};
+	D3D_ROOT_SIGNATURE_VERSION m_version{D3D_ROOT_SIGNATURE_VERSION_1_1};
+	std::string                m_path;
+	bool                       m_dirty{};
+
+	std::mutex                                         m_lock;
+	std::unordered_map<uint64_t, ID3D12RootSignature*> m_signatures;
+	blob_table                                         m_blobs;
+	stats                                              m_stats{};
+};
+
+}        // namespace emt
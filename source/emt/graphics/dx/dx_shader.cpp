@@ -1,89 +1,124 @@
 #include "dx_shader.h"
-#include <filesystem>
+#include "directx/d3d12shader.h"
+#include <emt/graphics/hash.h>
+#include <emt/engine/job_system.h>
+#include <algorithm>
+#include <bit>
+#include <string>
 
 namespace emt
 {
-void dx_shader_cache::initialize()
+// mbstowcs_s 는 MSVC 전용 : wchar_t 가 16bit 이면 surrogate pair, 32bit (linux) 면 그대로
+static std::wstring utf8_to_wide(const char* str)
 {
-	if(inited)
-		return;
-	HR(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&m_utils)));
-	HR(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&m_compiler)));
-	m_utils->CreateDefaultIncludeHandler(&m_includes);
-	inited = true;
+	std::wstring out;
+	const uint8_t* p = reinterpret_cast<const uint8_t*>(str);
+	while(*p) {
+		uint32_t cp    = *p++;
+		int      extra = cp >= 0xf0 ? 3 : cp >= 0xe0 ? 2 : cp >= 0xc0 ? 1 : 0;
+		if(extra)
+			cp &= 0x3f >> extra;
+		for(; extra > 0 && (*p & 0xc0) == 0x80; --extra)
+			cp = (cp << 6) | (*p++ & 0x3f);
+		if constexpr(sizeof(wchar_t) == 2) {
+			if(cp >= 0x10000) {
+				cp -= 0x10000;
+				out.push_back(wchar_t(0xd800 + (cp >> 10)));
+				cp = 0xdc00 + (cp & 0x3ff);
+			}
+		}
+		out.push_back(wchar_t(cp));
+	}
+	return out;
 }
 
-void dx_shader_cache::deinitialize()
+static const char* shader_profile(shader_stage stage)
 {
-	safe_release(m_includes);
-	safe_release(m_compiler);
-	safe_release(m_utils);
-	inited = false;
+	switch(stage) {
+		case shader_stage::vertex: return "vs_6_7";
+		case shader_stage::pixel: return "ps_6_7";
+		case shader_stage::geometry: return "gs_6_7";
+		case shader_stage::hull: return "hs_6_7";
+		case shader_stage::domain: return "ds_6_7";
+		case shader_stage::compute: return "cs_6_7";
+		default: return "vs_6_7";
+	}
 }
 
-void utf8_to_utf16(const char* str, wchar_t* wstr, size_t cap)
+// version + commit : compiler 가 바뀌면 disk cache 의 key 도 바뀜
+static uint64_t compiler_identity(IDxcCompiler3* compiler)
 {
-	size_t len = std::strlen(str) + 1;
-	if(len > cap)
-		len = cap;
-	// std::mbstowcs(wstr, str, len);
-	size_t converted = 0;
-	mbstowcs_s(&converted, wstr, len, str, _TRUNCATE);
+	stable_hasher     h;
+	IDxcVersionInfo*  info{};
+	IDxcVersionInfo2* info2{};
+	if(SUCCEEDED(compiler->QueryInterface(IID_PPV_ARGS(&info)))) {
+		UINT32 major = 0, minor = 0, flags = 0;
+		info->GetVersion(&major, &minor);
+		info->GetFlags(&flags);
+		h.add(major).add(minor).add(flags);
+	}
+	if(SUCCEEDED(compiler->QueryInterface(IID_PPV_ARGS(&info2)))) {
+		UINT32 commit_count = 0;
+		char*  commit_hash  = nullptr;
+		if(SUCCEEDED(info2->GetCommitInfo(&commit_count, &commit_hash))) {
+			h.add(commit_count).add_string(commit_hash);
+			CoTaskMemFree(commit_hash);
+		}
+	}
+	safe_release(info2);
+	safe_release(info);
+	return h.value();
 }
 
-const wchar_t* get_stage_str(shader_stage stage)
+// IDxcCompiler3 는 thread-safe 하지 않음 : thread 마다 하나, 처음 쓸 때 생성
+// worker 의 instance 는 thread 가 끝날 때 해제됨
+struct dxc_instance
 {
-	switch(stage) {
-		case shader_stage::vertex: return L"vs_6_7";
-		case shader_stage::pixel: return L"ps_6_7";
-		case shader_stage::geometry: return L"gs_6_7";
-		case shader_stage::hull: return L"hs_6_7";
-		case shader_stage::domain: return L"ds_6_7";
-		case shader_stage::compute: return L"cs_6_7";
-		default: return L"vs_6_7";
+	IDxcUtils*          utils{};
+	IDxcCompiler3*      compiler{};
+	IDxcIncludeHandler* includes{};
+
+	~dxc_instance() { release(); }
+	void release()
+	{
+		safe_release(includes);
+		safe_release(compiler);
+		safe_release(utils);
 	}
-}
+};
 
-void dx_shader_cache::compile_from_file(shader_stage stage,
-                                        const char*  file,
-                                        const char*  entry,
-                                        dx_shader**  pp_shader)
+static dxc_instance& thread_dxc()
 {
-	std::string filename(EMT_DATA_DIR);
-	filename.append(file);
-	if(!std::filesystem::exists(filename.c_str())) {
-		log_error("failed to find file : %s", filename.c_str());
+	thread_local dxc_instance dxc;
+	if(!dxc.compiler) {
+		HR(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&dxc.utils)));
+		HR(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxc.compiler)));
+		HR(dxc.utils->CreateDefaultIncludeHandler(&dxc.includes));
 	}
+	return dxc;
+}
 
-	wchar_t wide_file[128]{};
-	wchar_t wide_entry[32]{};
-
-	utf8_to_utf16(filename.c_str(), wide_file, std::size(wide_file));
-	utf8_to_utf16(entry, wide_entry, std::size(wide_entry));
-
-	IDxcBlobEncoding* encode{};
-
-	HR(m_utils->LoadFile(wide_file, nullptr, &encode));
-
+// reflection : DXC_OUT_REFLECTION (-Qstrip_reflect 로 bytecode 에서 뺀 부분)
+static IDxcBlob* compile_source(dxc_instance& dxc, const char* filename, const std::vector<uint8_t>& source,
+                                const char* const* args, uint32_t arg_count, IDxcBlob** reflection)
+{
 	DxcBuffer buffer{};
-	buffer.Ptr      = encode->GetBufferPointer();
-	buffer.Size     = encode->GetBufferSize();
+	buffer.Ptr      = source.data();
+	buffer.Size     = source.size();
 	buffer.Encoding = DXC_CP_UTF8;
 
-	// includer
-	// IDxcIncludeHandler* includer{};
-	// HR(m_utils->CreateDefaultIncludeHandler(&includer));
-
-	// args
-	const wchar_t* args[] = {
-	    L"-E",
-	    wide_entry,
-	    L"-T",
-	    get_stage_str(stage),
-	};
+	// 파일 이름 : default include handler 가 이 경로 기준으로 include 를 찾음
+	std::vector<std::wstring>   wide_args;
+	std::vector<const wchar_t*> arg_ptrs;
+	wide_args.reserve(arg_count + 1);
+	wide_args.push_back(utf8_to_wide(filename));
+	for(uint32_t i = 0; i < arg_count; ++i)
+		wide_args.push_back(utf8_to_wide(args[i]));
+	for(const std::wstring& a : wide_args)
+		arg_ptrs.push_back(a.c_str());
 
 	IDxcResult* res{};
-	m_compiler->Compile(&buffer, args, std::size(args), m_includes, IID_PPV_ARGS(&res));
+	HR(dxc.compiler->Compile(&buffer, arg_ptrs.data(), UINT32(arg_ptrs.size()), dxc.includes, IID_PPV_ARGS(&res)));
 
 	IDxcBlobUtf8* err{};
 	if(SUCCEEDED(res->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&err), nullptr)) && err && err->GetStringLength() > 0) {
@@ -91,25 +126,233 @@ void dx_shader_cache::compile_from_file(shader_stage stage,
 	}
 	safe_release(err);
 
-	HRESULT status{};
+	HRESULT   status{};
+	IDxcBlob* p_dxil_blob{};
 	HR(res->GetStatus(&status));
-	if(FAILED(status)) {
-		log_error("[dxc] compile failed : %s (%s:%s)", file, entry, "DXC");
+	if(SUCCEEDED(status)) {
+		res->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&p_dxil_blob), nullptr);
+		res->GetOutput(DXC_OUT_REFLECTION, IID_PPV_ARGS(reflection), nullptr);
 	}
+	safe_release(res);
+	return p_dxil_blob;
+}
 
-	IDxcBlob* p_dxil_blob{};
-	res->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&p_dxil_blob), nullptr);
+static shader_resource_type resource_type(D3D_SHADER_INPUT_TYPE type)
+{
+	switch(type) {
+		case D3D_SIT_CBUFFER: return shader_resource_type::cbv;
+		case D3D_SIT_SAMPLER: return shader_resource_type::sampler;
+		case D3D_SIT_TBUFFER:
+		case D3D_SIT_TEXTURE:
+		case D3D_SIT_STRUCTURED:
+		case D3D_SIT_BYTEADDRESS:
+		case D3D_SIT_RTACCELERATIONSTRUCTURE: return shader_resource_type::srv;
+		default: return shader_resource_type::uav;
+	}
+}
 
-	safe_release(res);
-	safe_release(encode);
+static bool reflect(dxc_instance& dxc, IDxcBlob* blob, shader_stage stage, shader_reflection* out)
+{
+	DxcBuffer buffer{};
+	buffer.Ptr  = blob->GetBufferPointer();
+	buffer.Size = blob->GetBufferSize();
+
+	ID3D12ShaderReflection* r{};
+	if(FAILED(dxc.utils->CreateReflection(&buffer, IID_PPV_ARGS(&r))))
+		return false;
+
+	D3D12_SHADER_DESC desc{};
+	r->GetDesc(&desc);
+	*out       = shader_reflection{};
+	out->stage = stage;
+	for(UINT i = 0; i < desc.BoundResources; ++i) {
+		D3D12_SHADER_INPUT_BIND_DESC bind{};
+		r->GetResourceBindingDesc(i, &bind);
+		shader_binding& b = out->bindings.emplace_back();
+		b.name            = bind.Name;
+		b.type            = resource_type(bind.Type);
+		b.slot            = bind.BindPoint;
+		b.space           = bind.Space;
+		b.count           = bind.BindCount == UINT_MAX ? 0 : bind.BindCount;        // unbounded
+		b.stages          = shader_stage_bit(stage);
+		if(b.type == shader_resource_type::cbv) {
+			D3D12_SHADER_BUFFER_DESC cb{};
+			if(SUCCEEDED(r->GetConstantBufferByName(bind.Name)->GetDesc(&cb)))
+				b.size = cb.Size;
+		}
+	}
+	if(stage == shader_stage::vertex) {
+		for(UINT i = 0; i < desc.InputParameters; ++i) {
+			D3D12_SIGNATURE_PARAMETER_DESC param{};
+			r->GetInputParameterDesc(i, &param);
+			shader_input& in  = out->inputs.emplace_back();
+			in.semantic       = param.SemanticName;
+			in.semantic_index = param.SemanticIndex;
+			in.components     = uint8_t(std::bit_width(uint32_t(param.Mask)));
+			in.system_value   = param.SystemValueType != D3D_NAME_UNDEFINED;
+			in.component      = param.ComponentType == D3D_REGISTER_COMPONENT_UINT32   ? shader_component::uint32
+			                    : param.ComponentType == D3D_REGISTER_COMPONENT_SINT32 ? shader_component::sint32
+			                                                                           : shader_component::float32;
+		}
+	}
+	safe_release(r);
+	return true;
+}
+
+void dx_shader::input_layout(std::vector<D3D12_INPUT_ELEMENT_DESC>* out) const
+{
+	static const DXGI_FORMAT formats[3][4] = {
+	    {DXGI_FORMAT_R32_FLOAT, DXGI_FORMAT_R32G32_FLOAT, DXGI_FORMAT_R32G32B32_FLOAT, DXGI_FORMAT_R32G32B32A32_FLOAT},
+	    {DXGI_FORMAT_R32_UINT, DXGI_FORMAT_R32G32_UINT, DXGI_FORMAT_R32G32B32_UINT, DXGI_FORMAT_R32G32B32A32_UINT},
+	    {DXGI_FORMAT_R32_SINT, DXGI_FORMAT_R32G32_SINT, DXGI_FORMAT_R32G32B32_SINT, DXGI_FORMAT_R32G32B32A32_SINT},
+	};
+	out->clear();
+	for(const shader_input& in : reflection.inputs) {
+		if(in.system_value || in.components == 0)
+			continue;
+		D3D12_INPUT_ELEMENT_DESC& e = out->emplace_back();
+		e.SemanticName              = in.semantic.c_str();
+		e.SemanticIndex             = in.semantic_index;
+		e.Format                    = formats[uint32_t(in.component)][std::min<uint32_t>(in.components, 4) - 1];
+		e.InputSlot                 = 0;
+		e.AlignedByteOffset         = D3D12_APPEND_ALIGNED_ELEMENT;
+		e.InputSlotClass            = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
+		e.InstanceDataStepRate      = 0;
+	}
+}
+
+void dx_shader_cache::initialize()
+{
+	if(inited)
+		return;
+	std::string cache_dir(EMT_CACHE_DIR);
+	cache_dir.append("shaders/");
+	m_disk.initialize(cache_dir.c_str(), compiler_identity(thread_dxc().compiler));
+	inited = true;
+}
+
+void dx_shader_cache::deinitialize()
+{
+	// 호출한 thread 의 instance 만, worker 의 것은 thread 종료 시
+	thread_dxc().release();
+	inited = false;
+}
+
+void dx_shader_cache::compile_from_file(shader_stage stage,
+                                        const char*  file,
+                                        const char*  entry,
+                                        dx_shader**  pp_shader)
+{
+	shader_create_info info{};
+	info.stage    = stage;
+	info.filename = file;
+	info.entry    = entry;
+	compile(info, pp_shader);
+}
+
+void dx_shader_cache::compile(const shader_create_info& info, dx_shader** pp_shader,
+                              std::vector<std::string>* dependencies)
+{
+	log_assert(inited, "dx_shader_cache::initialize must run before compiling");
+	*pp_shader = nullptr;
 
-	dx_shader* p_shader = emt_new dx_shader;
-	p_shader->blob      = p_dxil_blob;
+	std::string filename(EMT_DATA_DIR);
+	filename.append(info.filename);
+
+	std::vector<uint8_t> source;
+	if(!read_binary_file(filename.c_str(), &source)) {
+		log_error("failed to find file : %s", filename.c_str());
+		if(dependencies)
+			dependencies->assign(1, filename);
+		return;
+	}
+
+	// includes : EMT_DATA_DIR 기준 추가 include 경로
+	// reflection 은 bytecode 에서 빼고 따로 남김 : driver 로 가는 DXIL 이 작아짐
+	const char*              profile = shader_profile(info.stage);
+	std::vector<std::string> include_dirs;
+	std::vector<const char*> args = {"-E", info.entry, "-T", profile, "-Qstrip_reflect"};
+	include_dirs.reserve(info.includes.size());
+	for(const char* dir : info.includes)
+		include_dirs.push_back(std::string(EMT_DATA_DIR).append(dir));
+	for(const std::string& dir : include_dirs) {
+		args.push_back("-I");
+		args.push_back(dir.c_str());
+	}
+	// define 도 args 이므로 permutation 마다 다른 disk key
+	std::vector<std::string> define_args;
+	define_args.reserve(info.defines.size());
+	for(const shader_define& d : info.defines)
+		define_args.push_back(std::string(d.name).append("=").append(d.value ? d.value : "1"));
+	for(const std::string& d : define_args) {
+		args.push_back("-D");
+		args.push_back(d.c_str());
+	}
+
+	// cache hit (bytecode 와 reflection 둘 다) : DXC 를 거치지 않음
+	dxc_instance&        dxc = thread_dxc();
+	const uint64_t       key = m_disk.key(filename.c_str(), source.data(), source.size(),
+	                                      args.data(), uint32_t(args.size()), include_dirs, dependencies);
+	std::vector<uint8_t> cached;
+	std::vector<uint8_t> cached_reflection;
+	shader_reflection    reflection;
+	IDxcBlob*            p_dxil_blob{};
+	if(m_disk.load(key, &cached) && m_disk.load(key, &cached_reflection, "refl") &&
+	   reflection.unpack(cached_reflection.data(), cached_reflection.size())) {
+		IDxcBlobEncoding* blob{};
+		HR(dxc.utils->CreateBlob(cached.data(), UINT32(cached.size()), DXC_CP_ACP, &blob));
+		p_dxil_blob = blob;
+		log_debug("[dxc] %s [%s] [%s] cache hit (%zu bytes)", info.filename, info.entry, profile, cached.size());
+	}
+	else {
+		IDxcBlob* p_reflection{};
+		p_dxil_blob = compile_source(dxc, filename.c_str(), source, args.data(), uint32_t(args.size()), &p_reflection);
+		if(!p_dxil_blob || !p_reflection || !reflect(dxc, p_reflection, info.stage, &reflection)) {
+			log_error("[dxc] compile failed : %s (%s:%s)", info.filename, info.entry, profile);
+			safe_release(p_reflection);
+			safe_release(p_dxil_blob);
+			return;
+		}
+		safe_release(p_reflection);
+		reflection.pack(&cached_reflection);
+		m_disk.store(key, p_dxil_blob->GetBufferPointer(), p_dxil_blob->GetBufferSize());
+		m_disk.store(key, cached_reflection.data(), cached_reflection.size(), "refl");
+		log_debug("[dxc] %s [%s] [%s] (%zu bytes, %zu bindings)",
+		          info.filename, info.entry, profile,
+		          static_cast<size_t>(p_dxil_blob->GetBufferSize()), reflection.bindings.size());
+	}
+
+	dx_shader* p_shader  = emt_new dx_shader;
+	p_shader->blob       = p_dxil_blob;
+	p_shader->reflection = std::move(reflection);
 
 	*pp_shader = p_shader;
-	log_debug("[dxc] %s [%s] [%ls] (%zu bytes)",
-	          file, entry, get_stage_str(stage),
-	          static_cast<size_t>(p_dxil_blob->GetBufferSize()));
+}
+
+void dx_shader_cache::dependencies(const shader_create_info& info, std::vector<std::string>* dependencies)
+{
+	std::string filename(EMT_DATA_DIR);
+	filename.append(info.filename);
+
+	std::vector<uint8_t> source;
+	dependencies->assign(1, filename);
+	if(!read_binary_file(filename.c_str(), &source))
+		return;
+
+	std::vector<std::string> include_dirs;
+	for(const char* dir : info.includes)
+		include_dirs.push_back(std::string(EMT_DATA_DIR).append(dir));
+	m_disk.key(filename.c_str(), source.data(), source.size(), nullptr, 0, include_dirs, dependencies);
+}
+
+void dx_shader_cache::compile_batch(job_system* jobs, std::span<const shader_create_info> infos,
+                                    dx_shader** pp_shaders, job_counter* counter)
+{
+	for(size_t i = 0; i < infos.size(); ++i) {
+		const shader_create_info* info = &infos[i];
+		dx_shader**               out  = &pp_shaders[i];
+		jobs->spawn([info, out]() { compile(*info, out); }, counter);
+	}
 }
 
 }        // namespace emt
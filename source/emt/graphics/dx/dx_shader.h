@@ -1,12 +1,16 @@
 #pragma once
 
 #include "dx_config.h"
+#include <emt/graphics/dxbc_container.h>
+#include <emt/graphics/shader_disk_cache.h>
+#include <emt/graphics/shader_reflection.h>
 
 namespace emt
 {
 struct dx_shader
 {
-	IDxcBlob*             blob{};
+	IDxcBlob*             blob{};        // reflection 은 뺀 DXIL (-Qstrip_reflect)
+	shader_reflection     reflection;        // bytecode 와 같은 key 로 disk 에 남음
 	D3D12_SHADER_BYTECODE byte_code() const noexcept
 	{
 		D3D12_SHADER_BYTECODE out{};
@@ -14,6 +18,18 @@ struct dx_shader
 		out.pShaderBytecode = blob->GetBufferPointer();
 		return out;
 	}
+	// IDxcBlob 을 거치지 않는 container view (blob 보다 오래 쓰지 말 것)
+	dxbc_container container() const
+	{
+		dxbc_container out;
+		if(blob)
+			out.parse(blob->GetBufferPointer(), blob->GetBufferSize());
+		return out;
+	}
+	// vertex shader 의 input signature 로 만든 layout : slot 0, per vertex, 순서대로 붙임
+	// SemanticName 은 reflection 을 가리킴 (shader 보다 오래 쓰지 말 것)
+	void input_layout(std::vector<D3D12_INPUT_ELEMENT_DESC>* out) const;
+
 	~dx_shader() { release(); }
 	void release()
 	{
@@ -21,6 +37,8 @@ struct dx_shader
 	}
 };
 
+// compile 결과는 source / include / args 의 hash 로 disk 에 남음 -> hit 면 DXC 를 건너뜀
+// DXC 는 thread 마다 따로 : 어느 thread 에서든 동시에 compile 가능
 struct dx_shader_cache
 {
 	static void initialize();
@@ -31,12 +49,21 @@ struct dx_shader_cache
 	    const char*  file,
 	    const char*  entry,
 	    dx_shader**  pp_shader);
+	// 실패하면 *pp_shader 는 nullptr (에러는 log 에 남김)
+	// dependencies : source 와 include 된 모든 파일 (실패해도 채움)
+	static void compile(const shader_create_info& info, dx_shader** pp_shader,
+	                    std::vector<std::string>* dependencies = nullptr);
+	// compile 없이 의존 파일만 (source 를 읽고 include 를 따라감)
+	static void dependencies(const shader_create_info& info, std::vector<std::string>* dependencies);
+
+	// shader 마다 job 하나, counter 가 0 이 되면 pp_shaders[i] <- infos[i]
+	// infos 와 pp_shaders 는 jobs->wait(counter) 까지 유지해야 함
+	static void compile_batch(job_system* jobs, std::span<const shader_create_info> infos,
+	                          dx_shader** pp_shaders, job_counter* counter);
 
 private:
-	inline static bool                inited = false;
-	inline static IDxcUtils*          m_utils{};
-	inline static IDxcCompiler3*      m_compiler{};
-	inline static IDxcIncludeHandler* m_includes{};
+	inline static bool              inited = false;
+	inline static shader_disk_cache m_disk;
 };
 
 }        // namespace emt
@@ -0,0 +1,86 @@
+#include "dx_shader_permutations.h"
+#include "dx_shader.h"
+#include <emt/engine/job_system.h>
+
+namespace emt
+{
+void dx_shader_permutations::initialize(const shader_create_info& base, std::span<const char* const> features)
+{
+	release();
+	m_stage    = base.stage;
+	m_filename = base.filename;
+	m_entry    = base.entry;
+	for(const char* dir : base.includes)
+		m_includes.emplace_back(dir);
+	for(const std::string& dir : m_includes)
+		m_include_ptrs.push_back(dir.c_str());
+	for(const shader_define& d : base.defines) {
+		m_define_strings.emplace_back(d.name);
+		m_define_strings.emplace_back(d.value ? d.value : "1");
+	}
+	for(size_t i = 0; i < m_define_strings.size(); i += 2)
+		m_defines.push_back({m_define_strings[i].c_str(), m_define_strings[i + 1].c_str()});
+	for(const char* name : features)
+		m_features.add(name);
+}
+
+void dx_shader_permutations::release()
+{
+	for(auto& [key, p] : m_permutations) {
+		safe_delete(p->shader);
+		safe_delete(p);
+	}
+	m_permutations.clear();
+	m_features = shader_feature_set{};
+	m_includes.clear();
+	m_include_ptrs.clear();
+	m_define_strings.clear();
+	m_defines.clear();
+}
+
+dx_shader* dx_shader_permutations::get(uint64_t key)
+{
+	key &= m_features.mask();
+
+	permutation* p{};
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		permutation*&               slot = m_permutations[key];
+		if(!slot)
+			slot = emt_new permutation;
+		p = slot;
+	}
+
+	// compile 은 lock 밖에서 : 다른 key 는 동시에 진행
+	std::call_once(p->once, [this, p, key]() {
+		std::vector<shader_define> defines(m_defines);
+		std::vector<shader_define> features;
+		m_features.defines(key, &features);
+		defines.insert(defines.end(), features.begin(), features.end());
+
+		shader_create_info info{};
+		info.stage    = m_stage;
+		info.filename = m_filename.c_str();
+		info.entry    = m_entry.c_str();
+		info.includes = std::span<const char*>(m_include_ptrs.data(), m_include_ptrs.size());
+		info.defines  = defines;
+		dx_shader_cache::compile(info, &p->shader);
+		if(!p->shader)
+			log_error("permutation %s [%s] failed", m_filename.c_str(), m_features.describe(key).c_str());
+	});
+	return p->shader;
+}
+
+void dx_shader_permutations::prewarm(job_system* jobs, std::span<const uint64_t> keys, job_counter* counter)
+{
+	for(uint64_t key : keys)
+		jobs->spawn([this, key]() { get(key); }, counter);
+}
+
+uint32_t dx_shader_permutations::size()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return uint32_t(m_permutations.size());
+}
+
+}        // namespace emt
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "dx_config.h"
+#include <emt/graphics/shader_permutation.h>
+#include <mutex>
+#include <unordered_map>
+
+namespace emt
+{
+struct dx_shader;
+
+// 한 shader (file + entry) 의 permutation 들
+//  - key 는 shader_feature_set 의 bitset, 처음 요청할 때 compile (lazy) 하거나 prewarm
+//  - define 이 compile args 에 들어가므로 disk cache 에도 permutation 마다 따로 남음
+// get / prewarm 은 여러 thread 에서 동시에 호출 가능
+class dx_shader_permutations
+{
+public:
+	dx_shader_permutations() = default;
+	~dx_shader_permutations() { release(); }
+
+	dx_shader_permutations(const dx_shader_permutations&)            = delete;
+	dx_shader_permutations& operator=(const dx_shader_permutations&) = delete;
+
+	// base 의 문자열은 복사, base.defines 는 모든 permutation 에 공통으로 붙음
+	void initialize(const shader_create_info& base, std::span<const char* const> features);
+	void release();
+
+	uint64_t                  key(std::span<const char* const> enabled) const { return m_features.key(enabled); }
+	const shader_feature_set& features() const { return m_features; }
+
+	// 같은 key 를 동시에 요청하면 compile 은 한 번, 나머지는 기다림
+	// 실패하면 nullptr (다시 요청해도 compile 하지 않음, hot reload 로 고침)
+	dx_shader* get(uint64_t key);
+	// key 마다 job 하나, this 는 jobs->wait(counter) 까지 유지해야 함
+	void prewarm(job_system* jobs, std::span<const uint64_t> keys, job_counter* counter);
+
+	uint32_t size();        // 요청된 permutation 수
+
+private:
+	struct permutation
+	{
+		std::once_flag once;
+		dx_shader*     shader{};
+	};
+
+	shader_feature_set         m_features;
+	shader_stage               m_stage{};
+	std::string                m_filename;
+	std::string                m_entry;
+	std::vector<std::string>   m_includes;
+	std::vector<const char*>   m_include_ptrs;
+	std::vector<std::string>   m_define_strings;        // 공통 define : name, value 순서
+	std::vector<shader_define> m_defines;
+
+	std::mutex                                 m_lock;
+	std::unordered_map<uint64_t, permutation*> m_permutations;
+};
+
+}        // namespace emt
@@ -0,0 +1,227 @@
+#include "dx_shader_reloader.h"
+#include "dx_shader.h"
+#include "dx_device.h"
+#include <algorithm>
+
+namespace emt
+{
+static D3D12_SHADER_BYTECODE* stage_bytecode(D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint32_t stage)
+{
+	D3D12_SHADER_BYTECODE* stages[] = {&desc.VS, &desc.PS, &desc.DS, &desc.HS, &desc.GS};
+	return stages[stage];
+}
+
+shader_create_info dx_shader_reloader::watched_shader::info() const
+{
+	shader_create_info out{};
+	out.stage    = stage;
+	out.filename = filename.c_str();
+	out.entry    = entry.c_str();
+	out.includes = std::span<const char*>(const_cast<const char**>(include_ptrs.data()), include_ptrs.size());
+	out.defines  = defines;
+	return out;
+}
+
+bool dx_shader_reloader::initialize(dx_device* device, const char* directory)
+{
+	m_device    = device;
+	m_pipelines = device->pipelines();
+	if(!m_watcher.start(directory))
+		return false;
+	log_info("shader hot reload : watching %s", directory);
+	return true;
+}
+
+void dx_shader_reloader::release()
+{
+	// 진행 중인 job 이 slot / staged 를 건드리지 않을 때까지
+	if(m_busy && m_jobs) {
+		m_jobs->wait(&m_compile_counter);
+		m_jobs->wait(&m_pipeline_counter);
+	}
+	m_watcher.stop();
+	for(watched_shader& w : m_shaders) {
+		safe_delete(w.staged);
+	}
+	m_shaders.clear();
+	m_watched_pipelines.clear();
+	m_pending_shaders.clear();
+	m_pending_pipelines.clear();
+	m_graph     = shader_dependency_graph{};
+	m_busy      = false;
+	m_jobs      = nullptr;
+	m_pipelines = nullptr;
+	m_device    = nullptr;
+}
+
+void dx_shader_reloader::set_files(uint32_t shader, const std::vector<std::string>& files)
+{
+	std::vector<std::string> normalized;
+	normalized.reserve(files.size());
+	for(const std::string& file : files)
+		normalized.push_back(normalize_path(file));
+	m_graph.set(shader, normalized);
+}
+
+void dx_shader_reloader::watch(const shader_create_info& info, dx_shader** slot)
+{
+	log_assert(!m_busy, "watch while a reload is running");
+	watched_shader& w = m_shaders.emplace_back();
+	w.stage           = info.stage;
+	w.filename        = info.filename;
+	w.entry           = info.entry;
+	w.slot            = slot;
+	for(const char* dir : info.includes)
+		w.includes.emplace_back(dir);
+	for(const std::string& dir : w.includes)
+		w.include_ptrs.push_back(dir.c_str());
+	for(const shader_define& d : info.defines) {
+		w.define_strings.emplace_back(d.name);
+		w.define_strings.emplace_back(d.value ? d.value : "1");
+	}
+	for(size_t i = 0; i < w.define_strings.size(); i += 2)
+		w.defines.push_back({w.define_strings[i].c_str(), w.define_strings[i + 1].c_str()});
+
+	std::vector<std::string> files;
+	if(*slot)
+		dx_shader_cache::dependencies(w.info(), &files);
+	else
+		dx_shader_cache::compile(w.info(), slot, &files);
+	set_files(uint32_t(m_shaders.size() - 1), files);
+}
+
+void dx_shader_reloader::watch_pipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, ID3D12PipelineState** slot)
+{
+	log_assert(!m_busy, "watch_pipeline while a reload is running");
+	watched_pipeline& p = m_watched_pipelines.emplace_back();
+	p.desc              = desc;
+	p.slot              = slot;
+	p.layout.assign(desc.InputLayout.pInputElementDescs, desc.InputLayout.pInputElementDescs + desc.InputLayout.NumElements);
+
+	// bytecode 주소로 watch 된 shader 를 찾음
+	for(uint32_t stage = 0; stage < stage_count; ++stage) {
+		const void* code = stage_bytecode(p.desc, stage)->pShaderBytecode;
+		p.shaders[stage] = not_watched;
+		for(uint32_t i = 0; code && i < m_shaders.size(); ++i) {
+			const dx_shader* shader = *m_shaders[i].slot;
+			if(shader && shader->blob && shader->blob->GetBufferPointer() == code)
+				p.shaders[stage] = i;
+		}
+	}
+	if(!*slot) {
+		build_pipeline(uint32_t(m_watched_pipelines.size() - 1));
+		*slot    = p.staged;
+		p.staged = nullptr;
+	}
+}
+
+void dx_shader_reloader::build_pipeline(uint32_t index)
+{
+	watched_pipeline&                  p    = m_watched_pipelines[index];
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = p.desc;
+	desc.InputLayout.pInputElementDescs     = p.layout.data();
+	desc.InputLayout.NumElements            = UINT(p.layout.size());
+	for(uint32_t stage = 0; stage < stage_count; ++stage) {
+		if(p.shaders[stage] == not_watched)
+			continue;
+		const watched_shader& w      = m_shaders[p.shaders[stage]];
+		const dx_shader*      shader = w.staged ? w.staged : *w.slot;
+		if(shader)
+			*stage_bytecode(desc, stage) = shader->byte_code();
+	}
+	p.staged = m_pipelines->graphics(desc);
+}
+
+void dx_shader_reloader::start(job_system* jobs, const std::vector<uint32_t>& shaders)
+{
+	m_jobs            = jobs;
+	m_busy            = true;
+	m_pending_shaders = shaders;
+	m_pending_pipelines.clear();
+	for(uint32_t i = 0; i < m_watched_pipelines.size(); ++i) {
+		const uint32_t* begin = m_watched_pipelines[i].shaders;
+		const uint32_t* end   = begin + stage_count;
+		for(uint32_t s : shaders) {
+			if(std::find(begin, end, s) != end) {
+				m_pending_pipelines.push_back(i);
+				break;
+			}
+		}
+	}
+
+	for(uint32_t s : m_pending_shaders) {
+		watched_shader* w = &m_shaders[s];
+		jobs->spawn([w]() { dx_shader_cache::compile(w->info(), &w->staged, &w->staged_files); }, &m_compile_counter);
+	}
+	// PSO 는 모든 shader 가 끝난 뒤 (한 PSO 가 여러 shader 를 씀)
+	for(uint32_t p : m_pending_pipelines) {
+		jobs->spawn_after(&m_compile_counter, [this, p]() { build_pipeline(p); }, &m_pipeline_counter);
+	}
+	log_info("shader hot reload : recompiling %zu shaders, %zu pipelines",
+	         m_pending_shaders.size(), m_pending_pipelines.size());
+}
+
+uint32_t dx_shader_reloader::swap()
+{
+	uint32_t swapped = 0;
+	for(uint32_t s : m_pending_shaders) {
+		watched_shader& w = m_shaders[s];
+		// 실패해도 include 가 바뀌었을 수 있으므로 의존 파일은 갱신
+		if(!w.staged_files.empty())
+			set_files(s, w.staged_files);
+		w.staged_files.clear();
+		if(!w.staged)
+			continue;
+		safe_delete(*w.slot);
+		*w.slot  = w.staged;
+		w.staged = nullptr;
+		++swapped;
+	}
+	for(uint32_t p : m_pending_pipelines) {
+		watched_pipeline& w = m_watched_pipelines[p];
+		if(w.staged && w.staged != *w.slot) {
+			ID3D12PipelineState* old = *w.slot;
+			*w.slot                  = w.staged;
+			retire_pipeline(old);
+		}
+		w.staged = nullptr;
+	}
+	log_info("shader hot reload : %u / %zu shaders swapped", swapped, m_pending_shaders.size());
+	m_pending_shaders.clear();
+	m_pending_pipelines.clear();
+	m_busy = false;
+	return swapped;
+}
+
+void dx_shader_reloader::retire_pipeline(ID3D12PipelineState* pso)
+{
+	if(!pso)
+		return;
+	// 같은 desc 의 다른 slot 이 아직 쓰고 있으면 그 slot 이 교체될 때
+	for(const watched_pipeline& w : m_watched_pipelines) {
+		if(*w.slot == pso)
+			return;
+	}
+	// 이전 frame 의 list 가 아직 참조할 수 있음 -> 이번 frame 값 이후에 해제
+	if(m_pipelines->evict(pso))
+		m_device->defer_release(pso);
+}
+
+uint32_t dx_shader_reloader::update(job_system* jobs)
+{
+	if(m_busy) {
+		if(!m_compile_counter.done() || !m_pipeline_counter.done())
+			return 0;
+		return swap();
+	}
+
+	std::vector<std::string> changed;
+	if(!m_watcher.poll(&changed))
+		return 0;
+	const std::vector<uint32_t> affected = m_graph.affected(changed);
+	if(!affected.empty())
+		start(jobs, affected);
+	return 0;
+}
+
+}        // namespace emt
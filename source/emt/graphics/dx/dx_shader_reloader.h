@@ -0,0 +1,92 @@
+#pragma once
+
+#include "dx_config.h"
+#include <emt/engine/file_watcher.h>
+#include <emt/engine/job_system.h>
+#include <emt/graphics/shader_dependency_graph.h>
+#include <deque>
+
+namespace emt
+{
+class dx_device;
+class dx_pipeline_cache;
+
+// Shader hot reload
+//  1. file_watcher 가 바뀐 파일을 모음
+//  2. update 에서 그 파일에 의존하는 shader 만 job 으로 다시 compile, 이어서 PSO 생성
+//  3. 모두 끝난 뒤의 update (frame 경계) 에서 shader / PSO slot 을 한 번에 교체
+// compile 에 실패한 shader 는 이전 것을 유지
+class dx_shader_reloader
+{
+public:
+	dx_shader_reloader() = default;
+	~dx_shader_reloader() { release(); }
+
+	// PSO 는 device 의 pipeline cache 에서 만들고, 교체된 PSO 는 device 의 defer_release 로 해제
+	bool initialize(dx_device* device, const char* directory);
+	void release();
+
+	// slot 이 비어 있으면 compile, 이후 교체된 이전 shader 는 reloader 가 delete
+	// slot 은 reloader 보다 오래 살아야 함
+	void watch(const shader_create_info& info, dx_shader** slot);
+	// desc 의 shader 중 watch 된 것이 바뀌면 PSO 를 다시 만들어 slot 교체 (PSO 는 pipeline cache 소유)
+	// 교체된 PSO 는 cache 에서 빠지고 gpu 가 끝나면 해제됨 : slot 을 통해서만 사용할 것
+	// input layout 배열은 복사, semantic name 과 watch 되지 않은 shader 는 유지되어야 함
+	void watch_pipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, ID3D12PipelineState** slot);
+
+	// frame 경계 (begin_frame 전) 에서 매 frame 호출, 반환 : 이번에 교체된 shader 수
+	uint32_t update(job_system* jobs);
+	bool     busy() const { return m_busy; }
+
+private:
+	static constexpr uint32_t not_watched = ~0u;
+	static constexpr uint32_t stage_count = 5;        // VS PS DS HS GS
+
+	struct watched_shader
+	{
+		shader_stage               stage{};
+		std::string                filename;
+		std::string                entry;
+		std::vector<std::string>   includes;
+		std::vector<const char*>   include_ptrs;
+		std::vector<std::string>   define_strings;        // name, value 순서
+		std::vector<shader_define> defines;
+		dx_shader**                slot{};
+
+		dx_shader*               staged{};        // job 이 채움, 교체 전까지 보관
+		std::vector<std::string> staged_files;
+
+		shader_create_info info() const;
+	};
+	struct watched_pipeline
+	{
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC    desc{};
+		std::vector<D3D12_INPUT_ELEMENT_DESC> layout;
+		uint32_t                              shaders[stage_count];
+		ID3D12PipelineState**                 slot{};
+		ID3D12PipelineState*                  staged{};
+	};
+
+	void     start(job_system* jobs, const std::vector<uint32_t>& shaders);
+	void     build_pipeline(uint32_t index);
+	uint32_t swap();
+	void     retire_pipeline(ID3D12PipelineState* pso);
+	void     set_files(uint32_t shader, const std::vector<std::string>& files);
+
+	dx_device*                   m_device{};
+	dx_pipeline_cache*           m_pipelines{};
+	file_watcher                 m_watcher;
+	shader_dependency_graph      m_graph;
+	std::deque<watched_shader>   m_shaders;        // 주소가 바뀌지 않아야 함 (job 이 참조)
+	std::deque<watched_pipeline> m_watched_pipelines;
+
+	// 진행 중인 reload
+	job_system*           m_jobs{};
+	bool                  m_busy{};
+	std::vector<uint32_t> m_pending_shaders;
+	std::vector<uint32_t> m_pending_pipelines;
+	job_counter           m_compile_counter;
+	job_counter           m_pipeline_counter;
+};
+
+}        // namespace emt
@@ -0,0 +1,59 @@
+#include "dx_state_tracker.h"
+
+namespace emt
+{
+void dx_state_tracker::track(ID3D12Resource* resource)
+{
+	if(m_tracker.contains(resource))
+		return;
+	// planar format (depth-stencil 등) 의 plane 은 아직 구분하지 않음
+	const D3D12_RESOURCE_DESC desc   = resource->GetDesc();
+	const bool                buffer = desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER;
+	uint32_t                  count  = 1;
+	if(!buffer) {
+		const uint32_t arrays = desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? 1 : desc.DepthOrArraySize;
+		count                 = uint32_t(desc.MipLevels) * arrays;
+	}
+	const bool decays = buffer || (desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_SIMULTANEOUS_ACCESS);
+	m_tracker.track(resource, count, decays);
+}
+
+void dx_state_tracker::require(ID3D12Resource* resource, resource_state state, uint32_t subresource)
+{
+	track(resource);
+	m_tracker.require(resource, state, subresource);
+}
+
+void dx_state_tracker::uav(ID3D12Resource* resource)
+{
+	track(resource);
+	m_tracker.uav(resource);
+}
+
+void dx_state_tracker::flush(ID3D12GraphicsCommandList* cmd)
+{
+	m_tracker.flush([this](const state_barrier* barriers, uint32_t count) {
+		add_to(&m_batch, barriers, count);
+	});
+	m_batch.record(cmd);
+}
+
+bool dx_state_tracker::resolve(resource_state_registry* registry, dx_barrier_batch* fixups)
+{
+	m_fixups.clear();
+	if(m_tracker.resolve(registry, &m_fixups) == 0)
+		return false;
+	add_to(fixups, m_fixups.data(), uint32_t(m_fixups.size()));
+	return true;
+}
+
+void dx_state_tracker::add_to(dx_barrier_batch* batch, const state_barrier* barriers, uint32_t count)
+{
+	for(uint32_t i = 0; i < count; ++i) {
+		const state_barrier& sb  = barriers[i];
+		ID3D12Resource*      res = static_cast<ID3D12Resource*>(const_cast<void*>(sb.resource));
+		batch->add(res, sb.subresource, sb.before, sb.after);
+	}
+}
+
+}        // namespace emt
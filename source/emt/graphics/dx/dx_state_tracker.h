@@ -0,0 +1,38 @@
+#pragma once
+
+#include "dx_config.h"
+#include "dx_barrier_batch.h"
+#include <emt/graphics/resource_state_tracker.h>
+#include <vector>
+
+namespace emt
+{
+// resource_state_tracker bound to one ID3D12GraphicsCommandList.
+// require() only queues, flush() records everything queued in one barrier call.
+// Not thread safe : one tracker per list, resolve() on the submitting thread.
+class dx_state_tracker
+{
+public:
+	void reset() { m_tracker.reset(); }
+	bool empty() const { return m_tracker.empty(); }
+
+	void require(ID3D12Resource* resource, resource_state state, uint32_t subresource = all_subresources);
+	void uav(ID3D12Resource* resource);
+
+	// draw / dispatch / copy 직전
+	void flush(ID3D12GraphicsCommandList* cmd);
+
+	// submit 직전, 반환값이 true 면 fixups 를 이 list 보다 먼저 실행해야 함
+	bool resolve(resource_state_registry* registry, dx_barrier_batch* fixups);
+
+	static void add_to(dx_barrier_batch* batch, const state_barrier* barriers, uint32_t count);
+
+private:
+	void track(ID3D12Resource* resource);
+
+	resource_state_tracker     m_tracker;
+	std::vector<state_barrier> m_fixups;
+	dx_barrier_batch           m_batch;
+};
+
+}        // namespace emt
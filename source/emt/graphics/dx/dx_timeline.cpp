@@ -0,0 +1,102 @@
+#include "dx_timeline.h"
+
+namespace emt
+{
+void dx_timeline::initialize(ID3D12Device* device, ID3D12CommandQueue* queue, const wchar_t* name)
+{
+	release();
+	m_queue = queue;
+	HR(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)));
+	if(name)
+		m_fence->SetName(name);
+	m_event = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
+	m_state = fence_timeline{};
+}
+
+void dx_timeline::release()
+{
+	if(m_fence) {
+		// 남은 callback 은 gpu 가 끝난 뒤에만 실행
+		wait_idle();
+	}
+	safe_release(m_fence);
+	if(m_event) {
+		::CloseHandle(m_event);
+		m_event = nullptr;
+	}
+	m_queue = nullptr;
+}
+
+uint64_t dx_timeline::signal()
+{
+	const uint64_t value = m_state.signal();
+	HR(m_queue->Signal(m_fence, value));
+	return value;
+}
+
+bool dx_timeline::is_complete(uint64_t value)
+{
+	if(m_state.is_complete(value))
+		return true;
+	return poll() >= value;
+}
+
+void dx_timeline::wait(uint64_t value)
+{
+	// wait_any 로 남은 auto-reset 신호가 있을 수 있으므로 값으로 재확인
+	while(m_fence->GetCompletedValue() < value) {
+		HR(m_fence->SetEventOnCompletion(value, m_event));
+		::WaitForSingleObject(m_event, INFINITE);
+	}
+	poll();
+}
+
+void dx_timeline::wait_idle()
+{
+	if(!m_queue || !m_fence)
+		return;
+	wait(signal());
+}
+
+void dx_timeline::gpu_wait(ID3D12CommandQueue* waiter, uint64_t value) const
+{
+	if(value == 0 || m_state.is_complete(value))
+		return;
+	HR(waiter->Wait(m_fence, value));
+}
+
+uint64_t dx_timeline::poll()
+{
+	m_state.update(m_fence->GetCompletedValue());
+	return m_state.completed();
+}
+
+void dx_timeline::on_complete(uint64_t value, fence_timeline::callback cb)
+{
+	m_state.on_complete(value, std::move(cb));
+}
+
+uint32_t dx_timeline::wait_any(dx_timeline* const* timelines, const uint64_t* values, uint32_t count)
+{
+	log_assert(count > 0 && count <= MAXIMUM_WAIT_OBJECTS, "invalid timeline count");
+
+	HANDLE events[MAXIMUM_WAIT_OBJECTS]{};
+	for(;;) {
+		for(uint32_t i = 0; i < count; ++i) {
+			if(timelines[i]->is_complete(values[i]))
+				return i;
+			HR(timelines[i]->m_fence->SetEventOnCompletion(values[i], timelines[i]->m_event));
+			events[i] = timelines[i]->m_event;
+		}
+		::WaitForMultipleObjects(count, events, FALSE, INFINITE);
+	}
+}
+
+void dx_timeline::wait_all(dx_timeline* const* timelines, const uint64_t* values, uint32_t count)
+{
+	for(uint32_t i = 0; i < count; ++i) {
+		timelines[i]->wait(values[i]);
+	}
+}
+
+}        // namespace emt
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "dx_config.h"
+#include <emt/graphics/fence_timeline.h>
+
+namespace emt
+{
+// One ID3D12Fence timeline per command queue.
+// All gpu progress tracking (frames, uploads, idle waits, deferred work) goes through this.
+class dx_timeline
+{
+public:
+	dx_timeline() = default;
+	~dx_timeline() { release(); }
+
+	void initialize(ID3D12Device* device, ID3D12CommandQueue* queue, const wchar_t* name);
+	void release();
+
+	// queue 에 다음 값을 signal 하고 그 값을 반환
+	uint64_t signal();
+	bool     is_complete(uint64_t value);
+	void     wait(uint64_t value);
+	void     wait_idle();
+	// 다른 queue 가 gpu 상에서 이 timeline 의 value 를 기다리게 함 (cpu 대기 없음)
+	void gpu_wait(ID3D12CommandQueue* waiter, uint64_t value) const;
+
+	// GetCompletedValue 를 읽어 완료된 callback 실행, 완료 값 반환
+	uint64_t poll();
+	void     on_complete(uint64_t value, fence_timeline::callback cb);
+
+	uint64_t next_value() const { return m_state.next_value(); }
+	uint64_t last_signaled() const { return m_state.last_signaled(); }
+	uint64_t completed() const { return m_state.completed(); }
+
+	ID3D12Fence*        fence() const { return m_fence; }
+	ID3D12CommandQueue* queue() const { return m_queue; }
+
+	// 반환값은 완료된 timeline 의 index
+	static uint32_t wait_any(dx_timeline* const* timelines, const uint64_t* values, uint32_t count);
+	static void     wait_all(dx_timeline* const* timelines, const uint64_t* values, uint32_t count);
+
+private:
+	fence_timeline      m_state;
+	ID3D12CommandQueue* m_queue{};
+	ID3D12Fence*        m_fence{};
+	HANDLE              m_event{};
+};
+
+}        // namespace emt
@@ -0,0 +1,63 @@
+#include "dx_upload_ring.h"
+
+namespace emt
+{
+void dx_upload_ring::initialize(ID3D12Device* device, uint64_t capacity)
+{
+	release();
+	D3D12_HEAP_PROPERTIES hp = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	D3D12_RESOURCE_DESC   rd = CD3DX12_RESOURCE_DESC::Buffer(capacity);
+	HR(device->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &rd,
+	                                   D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&m_buffer)));
+	m_buffer->SetName(L"UPLOAD RING");
+
+	// upload heap 은 unmap 없이 계속 mapped 상태로 사용
+	CD3DX12_RANGE range(0, 0);
+	HR(m_buffer->Map(0, &range, reinterpret_cast<void**>(&m_cpu)));
+	m_gpu = m_buffer->GetGPUVirtualAddress();
+	m_ring.initialize(capacity);
+}
+
+void dx_upload_ring::release()
+{
+	if(m_buffer && m_cpu) {
+		m_buffer->Unmap(0, nullptr);
+	}
+	safe_release(m_buffer);
+	m_cpu = nullptr;
+	m_gpu = 0;
+	m_timelines.clear();
+	m_ring.initialize(0);
+}
+
+uint32_t dx_upload_ring::register_timeline(dx_timeline* timeline)
+{
+	m_timelines.push_back(timeline);
+	return static_cast<uint32_t>(m_timelines.size() - 1);
+}
+
+bool dx_upload_ring::allocate(uint64_t size, uint64_t align, uint32_t timeline, dx_staging* out)
+{
+	ring_fence fence{};
+	fence.timeline = timeline;
+	fence.value    = m_timelines[timeline]->next_value();
+
+	const uint64_t offset = m_ring.allocate(size, align, fence);
+	if(offset == ring_allocator::invalid)
+		return false;
+
+	out->resource = m_buffer;
+	out->offset   = offset;
+	out->cpu      = m_cpu + offset;
+	out->gpu      = m_gpu + offset;
+	return true;
+}
+
+void dx_upload_ring::retire()
+{
+	m_ring.retire([this](const ring_fence& fence) {
+		return m_timelines[fence.timeline]->is_complete(fence.value);
+	});
+}
+
+}        // namespace emt
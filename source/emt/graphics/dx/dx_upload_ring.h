@@ -0,0 +1,50 @@
+#pragma once
+
+#include "dx_config.h"
+#include "dx_timeline.h"
+#include <emt/graphics/ring_allocator.h>
+#include <vector>
+
+namespace emt
+{
+struct dx_staging
+{
+	ID3D12Resource*           resource{};
+	uint64_t                  offset{};
+	uint8_t*                  cpu{};
+	D3D12_GPU_VIRTUAL_ADDRESS gpu{};
+};
+
+// One persistently mapped UPLOAD buffer, suballocated FIFO.
+// Each allocation retires on the timeline of the queue that reads it.
+class dx_upload_ring
+{
+public:
+	dx_upload_ring() = default;
+	~dx_upload_ring() { release(); }
+
+	void initialize(ID3D12Device* device, uint64_t capacity);
+	void release();
+
+	// 반환값이 allocate 의 timeline index
+	uint32_t register_timeline(dx_timeline* timeline);
+
+	// 소비하는 queue 의 next_value 에 묶임, 가득 차면 false
+	bool allocate(uint64_t size, uint64_t align, uint32_t timeline, dx_staging* out);
+	void retire();
+
+	bool              empty() const { return m_ring.empty(); }
+	const ring_fence& oldest() const { return m_ring.oldest(); }
+	dx_timeline*      timeline(uint32_t index) const { return m_timelines[index]; }
+	uint64_t          capacity() const { return m_ring.capacity(); }
+	uint64_t          used() const { return m_ring.used(); }
+
+private:
+	ring_allocator            m_ring;
+	std::vector<dx_timeline*> m_timelines;
+	ID3D12Resource*           m_buffer{};
+	uint8_t*                  m_cpu{};
+	D3D12_GPU_VIRTUAL_ADDRESS m_gpu{};
+};
+
+}        // namespace emt
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <string.h>
+#include <string_view>
+
+#if defined(_WIN32)
+#	include <emt/graphics/dx/directx/D3D12TokenizedProgramFormat.hpp>
+#endif
+
+namespace emt
+{
+// DXBC container (DXIL 도 같은 container) 를 byte span 위에서 바로 읽음
+//  - header-only, 할당 / DXC / COM 없음 : linux 에서도 cache 검증, hash, signature 추출 가능
+//  - 모든 읽기는 memcpy : 정렬되지 않은 (mmap, cache file 안의) 주소도 됨
+//  - 반환되는 span / string_view 는 원본 byte 를 가리킴 (원본보다 오래 쓰지 말 것)
+//
+// container : "DXBC" [digest 16] [major 2] [minor 2] [total size 4] [part count 4] [part offset 4 * count]
+// part      : [fourcc 4] [size 4] [data size]
+namespace dxbc
+{
+constexpr uint32_t fourcc(char a, char b, char c, char d)
+{
+	return uint32_t(uint8_t(a)) | uint32_t(uint8_t(b)) << 8 | uint32_t(uint8_t(c)) << 16 | uint32_t(uint8_t(d)) << 24;
+}
+
+constexpr uint32_t container = fourcc('D', 'X', 'B', 'C');
+constexpr uint32_t dxil      = fourcc('D', 'X', 'I', 'L');        // program header + LLVM bitcode
+constexpr uint32_t rdat      = fourcc('R', 'D', 'A', 'T');        // library runtime data
+constexpr uint32_t psv0      = fourcc('P', 'S', 'V', '0');        // pipeline state validation
+constexpr uint32_t isg1      = fourcc('I', 'S', 'G', '1');        // input signature
+constexpr uint32_t osg1      = fourcc('O', 'S', 'G', '1');        // output signature
+constexpr uint32_t psg1      = fourcc('P', 'S', 'G', '1');        // patch constant signature
+constexpr uint32_t isgn      = fourcc('I', 'S', 'G', 'N');        // SM 5 이하 signature
+constexpr uint32_t osgn      = fourcc('O', 'S', 'G', 'N');
+constexpr uint32_t hash      = fourcc('H', 'A', 'S', 'H');        // shader hash (MD5)
+constexpr uint32_t stat      = fourcc('S', 'T', 'A', 'T');        // reflection (-Qstrip_reflect 로 빠짐)
+constexpr uint32_t ildb      = fourcc('I', 'L', 'D', 'B');        // debug info
+constexpr uint32_t shex      = fourcc('S', 'H', 'E', 'X');        // SM 5 token program
+constexpr uint32_t shdr      = fourcc('S', 'H', 'D', 'R');
+
+constexpr size_t header_size = 32;
+constexpr size_t digest_size = 16;
+
+inline uint32_t read_u32(const uint8_t* p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+// version token : [31:16] program type, [7:4] major, [3:0] minor (D3D12TokenizedProgramFormat.hpp 와 같음)
+constexpr uint32_t program_type(uint32_t version) { return version >> 16; }
+constexpr uint32_t program_major(uint32_t version) { return (version >> 4) & 0xf; }
+constexpr uint32_t program_minor(uint32_t version) { return version & 0xf; }
+
+// program type -> stage, library / raytracing / amplification 은 false
+inline bool program_stage(uint32_t type, shader_stage* out)
+{
+	switch(type) {
+		case 0: *out = shader_stage::pixel; return true;
+		case 1: *out = shader_stage::vertex; return true;
+		case 2: *out = shader_stage::geometry; return true;
+		case 3: *out = shader_stage::hull; return true;
+		case 4: *out = shader_stage::domain; return true;
+		case 5: *out = shader_stage::compute; return true;
+		case 13: *out = shader_stage::mesh; return true;
+		default: return false;
+	}
+}
+
+#if defined(_WIN32)
+static_assert(D3D10_SB_PIXEL_SHADER == 0 && D3D10_SB_VERTEX_SHADER == 1 && D3D11_SB_COMPUTE_SHADER == 5 &&
+              D3D12_SB_MESH_SHADER == 13);
+static_assert(program_type(ENCODE_D3D10_SB_TOKENIZED_PROGRAM_VERSION_TOKEN(D3D11_SB_HULL_SHADER, 6, 7)) == 3 &&
+              program_major(ENCODE_D3D10_SB_TOKENIZED_PROGRAM_VERSION_TOKEN(D3D11_SB_HULL_SHADER, 6, 7)) == 6 &&
+              program_minor(ENCODE_D3D10_SB_TOKENIZED_PROGRAM_VERSION_TOKEN(D3D11_SB_HULL_SHADER, 6, 7)) == 7);
+#endif
+}        // namespace dxbc
+
+struct dxbc_part
+{
+	uint32_t                 fourcc{};
+	std::span<const uint8_t> data;
+};
+
+// DXIL part 의 program header
+struct dxbc_program
+{
+	uint32_t                 version{};             // version token
+	uint32_t                 dxil_version{};        // 0x106 : DXIL 1.6
+	std::span<const uint8_t> bitcode;
+};
+
+class dxbc_container
+{
+public:
+	dxbc_container() = default;
+
+	// nullptr : valid, 아니면 이유 (header, part offset / size 가 모두 span 안인지 확인)
+	const char* parse(const void* data, size_t size)
+	{
+		m_bytes = {};
+		m_count = 0;
+		const uint8_t* p = static_cast<const uint8_t*>(data);
+		if(!p || size < dxbc::header_size)
+			return "too small";
+		if(dxbc::read_u32(p) != dxbc::container)
+			return "not a DXBC container";
+		const uint32_t total = dxbc::read_u32(p + 24);
+		const uint32_t count = dxbc::read_u32(p + 28);
+		if(total > size || total < dxbc::header_size)
+			return "size mismatch";
+		if(count > (total - dxbc::header_size) / 4)
+			return "part table out of range";
+		for(uint32_t i = 0; i < count; ++i) {
+			const uint32_t offset = dxbc::read_u32(p + dxbc::header_size + i * 4);
+			if(offset < dxbc::header_size + count * 4 || offset > total - 8)
+				return "part offset out of range";
+			if(dxbc::read_u32(p + offset + 4) > total - offset - 8)
+				return "part size out of range";
+		}
+		m_bytes = {p, total};
+		m_count = count;
+		return nullptr;
+	}
+
+	bool                     valid() const { return !m_bytes.empty(); }
+	std::span<const uint8_t> bytes() const { return m_bytes; }
+	uint32_t                 part_count() const { return m_count; }
+
+	// 전체의 checksum (validator 가 서명, 0 이면 서명 안 됨)
+	std::span<const uint8_t> digest() const { return m_bytes.subspan(4, dxbc::digest_size); }
+	bool                     signed_digest() const
+	{
+		for(uint8_t b : digest()) {
+			if(b)
+				return true;
+		}
+		return false;
+	}
+
+	dxbc_part part(uint32_t index) const
+	{
+		const uint32_t offset = dxbc::read_u32(m_bytes.data() + dxbc::header_size + index * 4);
+		dxbc_part      out;
+		out.fourcc = dxbc::read_u32(m_bytes.data() + offset);
+		out.data   = m_bytes.subspan(offset + 8, dxbc::read_u32(m_bytes.data() + offset + 4));
+		return out;
+	}
+
+	bool find(uint32_t fourcc, dxbc_part* out) const
+	{
+		for(uint32_t i = 0; i < m_count; ++i) {
+			if(dxbc::read_u32(m_bytes.data() + dxbc::read_u32(m_bytes.data() + dxbc::header_size + i * 4)) == fourcc) {
+				*out = part(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// HASH part : [flags 4] [digest 16], flags & 1 이면 source 까지 포함한 hash
+	bool shader_hash(std::span<const uint8_t>* digest, bool* includes_source = nullptr) const
+	{
+		dxbc_part p;
+		if(!find(dxbc::hash, &p) || p.data.size() < 4 + dxbc::digest_size)
+			return false;
+		*digest = p.data.subspan(4, dxbc::digest_size);
+		if(includes_source)
+			*includes_source = dxbc::read_u32(p.data.data()) & 1;
+		return true;
+	}
+
+	// DXIL part : [version 4] [size in dword 4] ["DXIL" 4] [dxil version 4] [bitcode offset 4] [bitcode size 4]
+	// bitcode offset 은 "DXIL" 위치 기준
+	bool program(dxbc_program* out) const
+	{
+		dxbc_part p;
+		if(!find(dxbc::dxil, &p) || p.data.size() < 24)
+			return false;
+		const uint8_t* d = p.data.data();
+		if(dxbc::read_u32(d + 8) != dxbc::dxil)
+			return false;
+		const uint32_t offset = dxbc::read_u32(d + 16);
+		const uint32_t size   = dxbc::read_u32(d + 20);
+		if(offset > p.data.size() - 8 || size > p.data.size() - 8 - offset)
+			return false;
+		out->version      = dxbc::read_u32(d);
+		out->dxil_version = dxbc::read_u32(d + 12);
+		out->bitcode      = p.data.subspan(8 + offset, size);
+		return true;
+	}
+
+	class iterator
+	{
+	public:
+		iterator(const dxbc_container* c, uint32_t i) :
+		    m_container(c),
+		    m_index(i) {}
+		dxbc_part operator*() const { return m_container->part(m_index); }
+		iterator& operator++()
+		{
+			++m_index;
+			return *this;
+		}
+		bool operator!=(const iterator& o) const { return m_index != o.m_index; }
+
+	private:
+		const dxbc_container* m_container;
+		uint32_t              m_index;
+	};
+	iterator begin() const { return {this, 0}; }
+	iterator end() const { return {this, m_count}; }
+
+private:
+	std::span<const uint8_t> m_bytes;
+	uint32_t                 m_count{};
+};
+
+struct dxbc_signature_element
+{
+	std::string_view semantic;
+	uint32_t         semantic_index{};
+	uint32_t         system_value{};          // D3D_NAME
+	uint32_t         component_type{};        // D3D_REGISTER_COMPONENT_TYPE : 1 uint, 2 sint, 3 float
+	uint32_t         register_index{};
+	uint32_t         stream{};
+	uint32_t         min_precision{};
+	uint8_t          mask{};
+	uint8_t          rw_mask{};        // input : always read, output : never written
+};
+
+// ISG1 / OSG1 / PSG1 (element 32 byte) 와 ISGN / OSGN (24 byte)
+// part : [count 4] [element offset 4] element ... , 이름은 part 시작 기준 offset 의 C 문자열
+class dxbc_signature
+{
+public:
+	bool parse(const dxbc_part& part)
+	{
+		m_data  = {};
+		m_count = 0;
+		if(part.fourcc == dxbc::isg1 || part.fourcc == dxbc::osg1 || part.fourcc == dxbc::psg1)
+			m_stride = 32;
+		else if(part.fourcc == dxbc::isgn || part.fourcc == dxbc::osgn)
+			m_stride = 24;
+		else
+			return false;
+		if(part.data.size() < 8)
+			return false;
+		const uint32_t count  = dxbc::read_u32(part.data.data());
+		const uint32_t offset = dxbc::read_u32(part.data.data() + 4);
+		if(offset > part.data.size() || count > (part.data.size() - offset) / m_stride)
+			return false;
+		m_data  = part.data;
+		m_first = offset;
+		m_count = count;
+		return true;
+	}
+
+	uint32_t size() const { return m_count; }
+
+	// 이름 offset 이 범위 밖이거나 끝나지 않으면 false
+	bool element(uint32_t index, dxbc_signature_element* out) const
+	{
+		const uint8_t* e = m_data.data() + m_first + size_t(index) * m_stride;
+		if(m_stride == 32) {
+			out->stream = dxbc::read_u32(e);
+			e += 4;
+		}
+		const uint32_t name = dxbc::read_u32(e);
+		out->semantic_index = dxbc::read_u32(e + 4);
+		out->system_value   = dxbc::read_u32(e + 8);
+		out->component_type = dxbc::read_u32(e + 12);
+		out->register_index = dxbc::read_u32(e + 16);
+		out->mask           = e[20];
+		out->rw_mask        = e[21];
+		out->min_precision  = m_stride == 32 ? dxbc::read_u32(e + 24) : 0;
+		if(name >= m_data.size())
+			return false;
+		const char* str = reinterpret_cast<const char*>(m_data.data() + name);
+		const void* nul = memchr(str, 0, m_data.size() - name);
+		if(!nul)
+			return false;
+		out->semantic = std::string_view(str, static_cast<const char*>(nul) - str);
+		return true;
+	}
+
+private:
+	std::span<const uint8_t> m_data;
+	uint32_t                 m_first{};
+	uint32_t                 m_count{};
+	uint32_t                 m_stride{};
+};
+
+}        // namespace emt
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <deque>
+#include <functional>
+#include <algorithm>
+
+namespace emt
+{
+// Monotonic value bookkeeping of one queue timeline.
+// signal() hands out the next value, update() is fed the value the gpu reached
+// and runs the callbacks registered for every value that retired, in value order.
+// The backend only has to supply the completed value, so a simulated clock works as well.
+class fence_timeline
+{
+public:
+	typedef std::function<void()> callback;
+
+	uint64_t next_value() const { return m_signaled + 1; }
+	uint64_t last_signaled() const { return m_signaled; }
+	uint64_t completed() const { return m_completed; }
+	size_t   pending_callbacks() const { return m_callbacks.size(); }
+
+	uint64_t signal() { return ++m_signaled; }
+
+	bool is_complete(uint64_t value) const { return value <= m_completed; }
+
+	// run cb once value retires; immediately if it already did
+	void on_complete(uint64_t value, callback cb)
+	{
+		if(is_complete(value)) {
+			cb();
+			return;
+		}
+		// 대부분 뒤에 붙으므로 upper_bound 는 거의 end()
+		auto it = std::upper_bound(m_callbacks.begin(), m_callbacks.end(), value,
+		                           [](uint64_t v, const entry& e) { return v < e.value; });
+		m_callbacks.insert(it, entry{value, std::move(cb)});
+	}
+
+	// returns the number of callbacks dispatched
+	uint32_t update(uint64_t completed)
+	{
+		if(completed > m_signaled) {
+			// a value we never handed out (device removed / foreign signal) : clamp
+			completed = m_signaled;
+		}
+		if(completed > m_completed)
+			m_completed = completed;
+
+		uint32_t count = 0;
+		while(!m_callbacks.empty() && m_callbacks.front().value <= m_completed) {
+			callback cb = std::move(m_callbacks.front().cb);
+			m_callbacks.pop_front();
+			cb();
+			++count;
+		}
+		return count;
+	}
+
+private:
+	struct entry
+	{
+		uint64_t value;
+		callback cb;
+	};
+	std::deque<entry> m_callbacks;
+	uint64_t          m_signaled  = 0;
+	uint64_t          m_completed = 0;
+};
+
+}        // namespace emt
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <vector>
+#include <utility>
+
+namespace emt
+{
+// Ring of per-frame slots, each guarded by the fence value of its last submit.
+// Only bookkeeping lives here : the owner decides what a slot carries (allocators, ...)
+// and where fence values come from, so the ring can be driven without a device.
+//
+// Resizing never waits : grown slots start retired (fence 0), shrunk slots are
+// parked until their fence value completes and handed back through collect_retired().
+template<typename T>
+class frame_ring
+{
+public:
+	struct slot
+	{
+		T        payload{};
+		uint64_t fence_value = 0;
+	};
+
+	uint32_t size() const { return static_cast<uint32_t>(m_slots.size()); }
+	uint32_t index() const { return m_index; }
+	uint32_t retired_count() const { return static_cast<uint32_t>(m_retired.size()); }
+	bool     empty() const { return m_slots.empty(); }
+
+	slot&       current() { return m_slots[m_index]; }
+	const slot& current() const { return m_slots[m_index]; }
+	slot&       at(uint32_t i) { return m_slots[i]; }
+	const slot& at(uint32_t i) const { return m_slots[i]; }
+
+	// fence value the current slot must reach before its payload can be reused
+	uint64_t wait_value() const { return m_slots[m_index].fence_value; }
+
+	void push(T payload)
+	{
+		m_slots.push_back(slot{std::move(payload), 0});
+	}
+
+	// record the submit of the current slot and move on to the next one
+	void advance(uint64_t fence_value)
+	{
+		m_slots[m_index].fence_value = fence_value;
+		m_index                      = (m_index + 1) % size();
+	}
+
+	// drop slots past count; they stay alive until collect_retired() sees their fence complete
+	void shrink(uint32_t count)
+	{
+		if(count == 0 || count >= size())
+			return;
+		for(uint32_t i = count; i < size(); ++i) {
+			m_retired.push_back(std::move(m_slots[i]));
+		}
+		m_slots.resize(count);
+		if(m_index >= count)
+			m_index = 0;
+	}
+
+	// release parked slots whose fence value is <= completed
+	template<typename Fn>
+	void collect_retired(uint64_t completed, Fn&& on_release)
+	{
+		for(size_t i = 0; i < m_retired.size();) {
+			if(m_retired[i].fence_value <= completed) {
+				on_release(m_retired[i].payload);
+				m_retired[i] = std::move(m_retired.back());
+				m_retired.pop_back();
+			}
+			else {
+				++i;
+			}
+		}
+	}
+
+	// release everything, live and parked; the caller must have waited for the gpu
+	template<typename Fn>
+	void clear(Fn&& on_release)
+	{
+		for(auto& s : m_slots)
+			on_release(s.payload);
+		for(auto& s : m_retired)
+			on_release(s.payload);
+		m_slots.clear();
+		m_retired.clear();
+		m_index = 0;
+	}
+
+private:
+	std::vector<slot> m_slots;
+	std::vector<slot> m_retired;
+	uint32_t          m_index = 0;
+};
+
+}        // namespace emt
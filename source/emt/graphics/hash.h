@@ -0,0 +1,59 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <string.h>
+#include <type_traits>
+
+namespace emt
+{
+// FNV-1a 64 : 실행 / build 가 바뀌어도 같은 값 (disk cache key 용)
+// pointer 값은 절대 넣지 않음, 가리키는 내용을 넣을 것
+class stable_hasher
+{
+public:
+	static constexpr uint64_t offset_basis = 0xcbf29ce484222325ull;
+	static constexpr uint64_t prime        = 0x100000001b3ull;
+
+	explicit stable_hasher(uint64_t seed = offset_basis) :
+	    m_value(seed) {}
+
+	stable_hasher& add(const void* data, size_t size)
+	{
+		const uint8_t* p = static_cast<const uint8_t*>(data);
+		uint64_t       h = m_value;
+		for(size_t i = 0; i < size; ++i) {
+			h ^= p[i];
+			h *= prime;
+		}
+		m_value = h;
+		return *this;
+	}
+
+	// padding 이 없는 값 (정수, enum, float, padding 없는 struct)
+	template<typename T>
+	stable_hasher& add(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>, "hash the pointed data instead");
+		return add(&value, sizeof(T));
+	}
+
+	// nullptr 와 "" 를 구분, 길이도 같이 넣어 연결된 문자열이 섞이지 않게 함
+	stable_hasher& add_string(const char* str)
+	{
+		const uint32_t len = str ? uint32_t(strlen(str)) + 1 : 0;
+		add(len);
+		return add(str, len);
+	}
+
+	uint64_t value() const { return m_value; }
+
+private:
+	uint64_t m_value;
+};
+
+inline uint64_t stable_hash(const void* data, size_t size, uint64_t seed = stable_hasher::offset_basis)
+{
+	return stable_hasher(seed).add(data, size).value();
+}
+
+}        // namespace emt
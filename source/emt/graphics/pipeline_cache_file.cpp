@@ -0,0 +1,165 @@
+#include "pipeline_cache_file.h"
+#include "hash.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace emt
+{
+void pack_pipeline_cache(uint64_t identity, const void* payload, size_t size, std::vector<uint8_t>* out)
+{
+	pipeline_cache_header header{};
+	header.magic        = pipeline_cache_magic;
+	header.version      = pipeline_cache_version;
+	header.identity     = identity;
+	header.payload_size = size;
+	header.payload_hash = stable_hash(payload, size);
+
+	out->resize(sizeof(header) + size);
+	memcpy(out->data(), &header, sizeof(header));
+	if(size)
+		memcpy(out->data() + sizeof(header), payload, size);
+}
+
+const char* unpack_pipeline_cache(const void* data, size_t size, uint64_t identity,
+                                  const uint8_t** payload, size_t* payload_size)
+{
+	*payload      = nullptr;
+	*payload_size = 0;
+
+	pipeline_cache_header header{};
+	if(size < sizeof(header))
+		return "file too small";
+	memcpy(&header, data, sizeof(header));
+	if(header.magic != pipeline_cache_magic)
+		return "not a pipeline cache";
+	if(header.version != pipeline_cache_version)
+		return "version mismatch";
+	if(header.identity != identity)
+		return "adapter or driver changed";
+	if(header.payload_size != size - sizeof(header))
+		return "truncated payload";
+
+	const uint8_t* p = static_cast<const uint8_t*>(data) + sizeof(header);
+	if(stable_hash(p, size_t(header.payload_size)) != header.payload_hash)
+		return "corrupted payload";
+
+	*payload      = p;
+	*payload_size = size_t(header.payload_size);
+	return nullptr;
+}
+
+bool load_pipeline_cache(const char* path, uint64_t identity, std::vector<uint8_t>* payload)
+{
+	payload->clear();
+
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if(!file)
+		return false;
+	const std::streamoff size = file.tellg();
+	if(size <= 0)
+		return false;
+
+	std::vector<uint8_t> data(static_cast<size_t>(size));
+	file.seekg(0);
+	if(!file.read(reinterpret_cast<char*>(data.data()), size))
+		return false;
+
+	const uint8_t* p{};
+	size_t         p_size{};
+	if(const char* error = unpack_pipeline_cache(data.data(), data.size(), identity, &p, &p_size)) {
+		log_warn("pipeline cache ignored (%s) : %s", error, path);
+		return false;
+	}
+	payload->assign(p, p + p_size);
+	return true;
+}
+
+bool save_pipeline_cache(const char* path, uint64_t identity, const void* payload, size_t size)
+{
+	std::vector<uint8_t> data;
+	pack_pipeline_cache(identity, payload, size, &data);
+
+	std::error_code             ec;
+	const std::filesystem::path target(path);
+	if(target.has_parent_path())
+		std::filesystem::create_directories(target.parent_path(), ec);
+
+	// 같은 파일을 여러 thread 가 동시에 쓸 수 있음 (shader cache) : thread 마다 다른 임시 파일
+	std::filesystem::path temp = target;
+	temp += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+	{
+		std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+		if(!file || !file.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()))) {
+			log_error("failed to write pipeline cache : %s", path);
+			return false;
+		}
+	}
+	std::filesystem::rename(temp, target, ec);
+	if(ec) {
+		log_error("failed to replace pipeline cache : %s (%s)", path, ec.message().c_str());
+		std::filesystem::remove(temp, ec);
+		return false;
+	}
+	return true;
+}
+
+void pack_blob_table(const blob_table& blobs, std::vector<uint8_t>* out)
+{
+	std::vector<uint64_t> keys;
+	keys.reserve(blobs.size());
+	size_t total = sizeof(uint64_t);
+	for(const auto& [key, blob] : blobs) {
+		keys.push_back(key);
+		total += sizeof(uint64_t) * 2 + blob.size();
+	}
+	std::sort(keys.begin(), keys.end());
+
+	out->resize(total);
+	uint8_t* p     = out->data();
+	auto     write = [&p](const void* src, size_t size) {
+		memcpy(p, src, size);
+		p += size;
+	};
+	const uint64_t count = keys.size();
+	write(&count, sizeof(count));
+	for(uint64_t key : keys) {
+		const std::vector<uint8_t>& blob = blobs.at(key);
+		const uint64_t              size = blob.size();
+		write(&key, sizeof(key));
+		write(&size, sizeof(size));
+		write(blob.data(), blob.size());
+	}
+}
+
+bool unpack_blob_table(const void* data, size_t size, blob_table* blobs)
+{
+	const uint8_t* p    = static_cast<const uint8_t*>(data);
+	const uint8_t* end  = p + size;
+	auto           read = [&p, end](void* dst, size_t bytes) {
+		if(size_t(end - p) < bytes)
+			return false;
+		memcpy(dst, p, bytes);
+		p += bytes;
+		return true;
+	};
+
+	uint64_t count = 0;
+	if(!read(&count, sizeof(count)))
+		return false;
+	blob_table table;
+	for(uint64_t i = 0; i < count; ++i) {
+		uint64_t key = 0, blob_size = 0;
+		if(!read(&key, sizeof(key)) || !read(&blob_size, sizeof(blob_size)) || blob_size > uint64_t(end - p))
+			return false;
+		table[key].assign(p, p + blob_size);
+		p += blob_size;
+	}
+	if(p != end)
+		return false;
+	*blobs = std::move(table);
+	return true;
+}
+
+}        // namespace emt
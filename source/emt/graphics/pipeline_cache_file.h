@@ -0,0 +1,40 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <unordered_map>
+#include <vector>
+
+namespace emt
+{
+// Pipeline cache file : header + payload (ID3D12PipelineLibrary::Serialize 결과)
+// identity 는 adapter / driver 에서 만든 값, 다르면 payload 를 쓰지 않음
+// payload 는 driver 가 다시 검증하지만 잘린 / 깨진 파일은 여기서 먼저 거름
+struct pipeline_cache_header
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t identity;
+	uint64_t payload_size;
+	uint64_t payload_hash;
+};
+
+constexpr uint32_t pipeline_cache_magic   = 0x43505445;        // "ETPC"
+constexpr uint32_t pipeline_cache_version = 1;
+
+void pack_pipeline_cache(uint64_t identity, const void* payload, size_t size, std::vector<uint8_t>* out);
+// nullptr : valid, payload 는 data 안을 가리킴. 아니면 이유
+const char* unpack_pipeline_cache(const void* data, size_t size, uint64_t identity,
+                                  const uint8_t** payload, size_t* payload_size);
+
+// 파일이 없거나 맞지 않으면 false (payload 비움)
+bool load_pipeline_cache(const char* path, uint64_t identity, std::vector<uint8_t>* payload);
+// 임시 파일에 쓰고 교체 : 중간에 종료되어도 이전 파일이 남음
+bool save_pipeline_cache(const char* path, uint64_t identity, const void* payload, size_t size);
+
+// 같은 파일 형식의 payload 로 쓰는 hash -> blob 표 (root signature 등)
+// [count] { [hash] [size] [bytes] } ... hash 순서로 기록 -> 같은 내용이면 같은 파일
+using blob_table = std::unordered_map<uint64_t, std::vector<uint8_t>>;
+void pack_blob_table(const blob_table& blobs, std::vector<uint8_t>* out);
+bool unpack_blob_table(const void* data, size_t size, blob_table* blobs);
+
+}        // namespace emt
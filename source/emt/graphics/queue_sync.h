@@ -0,0 +1,88 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <deque>
+#include <vector>
+
+namespace emt
+{
+// Cross-queue dependency bookkeeping with vector clocks.
+// Each queue knows, at its current submit point, the latest value of every other
+// queue it is already ordered after. require() only asks for a gpu wait when
+// that knowledge (direct or inherited through an earlier wait) is not enough,
+// so chains like compute -> graphics -> compute never wait twice.
+// No api calls are made here : the caller issues the actual queue wait.
+class queue_sync
+{
+public:
+	explicit queue_sync(uint32_t queue_count) :
+	    m_count(queue_count),
+	    m_clock(queue_count * queue_count, 0),
+	    m_completed(queue_count, 0),
+	    m_snapshots(queue_count)
+	{
+	}
+
+	uint32_t queue_count() const { return m_count; }
+
+	// queue 가 value 를 signal 했음 : 지금까지의 지식을 그 value 에 묶어 둠
+	void on_signal(uint32_t queue, uint64_t value)
+	{
+		known(queue, queue) = value;
+		snapshot s{value, std::vector<uint64_t>(m_clock.begin() + queue * m_count,
+		                                        m_clock.begin() + (queue + 1) * m_count)};
+		m_snapshots[queue].push_back(std::move(s));
+	}
+
+	// true : waiter 는 signaler 의 value 를 gpu 에서 기다려야 함 (기다린 것으로 기록됨)
+	bool require(uint32_t waiter, uint32_t signaler, uint64_t value)
+	{
+		if(waiter == signaler || value == 0)
+			return false;
+		if(value <= m_completed[signaler] || value <= known(waiter, signaler))
+			return false;
+
+		known(waiter, signaler) = value;
+		// signaler 가 value 시점에 알고 있던 것도 함께 상속
+		for(const snapshot& s : m_snapshots[signaler]) {
+			if(s.value > value)
+				break;
+			if(s.value == value) {
+				for(uint32_t q = 0; q < m_count; ++q) {
+					if(q != waiter && s.clock[q] > known(waiter, q))
+						known(waiter, q) = s.clock[q];
+				}
+				break;
+			}
+		}
+		return true;
+	}
+
+	// cpu 가 완료를 확인한 값은 이후 모든 submit 보다 앞서므로 대기 불필요
+	void retire(uint32_t queue, uint64_t completed)
+	{
+		if(completed > m_completed[queue])
+			m_completed[queue] = completed;
+		auto& list = m_snapshots[queue];
+		while(!list.empty() && list.front().value <= completed)
+			list.pop_front();
+	}
+
+	uint64_t known(uint32_t waiter, uint32_t signaler) const { return m_clock[waiter * m_count + signaler]; }
+
+private:
+	uint64_t& known(uint32_t waiter, uint32_t signaler) { return m_clock[waiter * m_count + signaler]; }
+
+	struct snapshot
+	{
+		uint64_t              value;
+		std::vector<uint64_t> clock;
+	};
+
+	uint32_t                          m_count;
+	std::vector<uint64_t>             m_clock;        // [waiter][signaler]
+	std::vector<uint64_t>             m_completed;
+	std::vector<std::deque<snapshot>> m_snapshots;
+};
+
+}        // namespace emt
@@ -0,0 +1,326 @@
+#include "render_graph.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace emt
+{
+static constexpr uint32_t no_pass = ~0u;
+
+void render_graph::reset()
+{
+	m_passes.clear();
+	m_accesses.clear();
+	m_resources.clear();
+	m_order.clear();
+	m_barriers.clear();
+	m_final_barriers.clear();
+}
+
+rg_handle render_graph::import_resource(const char* name, resource_state initial, resource_state final)
+{
+	resource r{};
+	r.name     = name;
+	r.imported = true;
+	r.initial  = initial;
+	r.final    = final;
+	r.first    = initial;
+	r.producers.push_back(no_pass);
+	m_resources.push_back(std::move(r));
+	return rg_handle{uint32_t(m_resources.size() - 1), 0};
+}
+
+rg_handle render_graph::create_resource(const char* name)
+{
+	resource r{};
+	r.name = name;
+	r.producers.push_back(no_pass);
+	m_resources.push_back(std::move(r));
+	return rg_handle{uint32_t(m_resources.size() - 1), 0};
+}
+
+uint32_t render_graph::add_pass(const char* name, bool never_cull)
+{
+	pass p{};
+	p.name       = name;
+	p.never_cull = never_cull;
+	m_passes.push_back(p);
+	return uint32_t(m_passes.size() - 1);
+}
+
+void render_graph::read(uint32_t pass, rg_handle handle, resource_state state)
+{
+	log_assert(pass < m_passes.size() && handle.resource < m_resources.size(), "invalid render graph read");
+	m_accesses.push_back(access{pass, handle.resource, handle.version, state, false});
+}
+
+rg_handle render_graph::write(uint32_t pass, rg_handle handle, resource_state state)
+{
+	log_assert(pass < m_passes.size() && handle.resource < m_resources.size(), "invalid render graph write");
+	resource& r = m_resources[handle.resource];
+	// 한 version 에서 두 갈래로 쓰면 순서를 정할 수 없음
+	log_assert(handle.version + 1 == r.producers.size(), "render graph write from a stale version");
+
+	m_accesses.push_back(access{pass, handle.resource, handle.version, state, true});
+	r.producers.push_back(pass);
+	return rg_handle{handle.resource, handle.version + 1};
+}
+
+const rg_barrier* render_graph::barriers(uint32_t pass, uint32_t* count) const
+{
+	const render_graph::pass& p = m_passes[pass];
+	*count                      = p.alive ? p.barrier_count : 0;
+	return *count ? m_barriers.data() + p.barrier_offset : nullptr;
+}
+
+bool render_graph::compile()
+{
+	m_sorted = m_accesses;
+	std::stable_sort(m_sorted.begin(), m_sorted.end(),
+	                 [](const access& a, const access& b) { return a.pass < b.pass; });
+
+	for(pass& p : m_passes) {
+		p.first_access   = 0;
+		p.access_count   = 0;
+		p.barrier_offset = 0;
+		p.barrier_count  = 0;
+		p.alive          = false;
+	}
+	for(uint32_t i = 0; i < m_sorted.size(); ++i) {
+		pass& p = m_passes[m_sorted[i].pass];
+		if(p.access_count == 0)
+			p.first_access = i;
+		++p.access_count;
+	}
+
+	add_edges();
+	cull();
+	if(!sort())
+		return false;
+	derive_barriers();
+	return true;
+}
+
+void render_graph::add_edges()
+{
+	m_edges.clear();
+
+	// (resource, version) 별 reader 목록
+	m_reads.clear();
+	for(const access& a : m_sorted) {
+		if(!a.write)
+			m_reads.push_back(a);
+	}
+	auto by_version = [](const access& a, const access& b) {
+		return a.resource != b.resource ? a.resource < b.resource : a.version < b.version;
+	};
+	std::stable_sort(m_reads.begin(), m_reads.end(), by_version);
+
+	for(const access& a : m_sorted) {
+		const uint32_t producer = m_resources[a.resource].producers[a.version];
+		if(producer != no_pass && producer != a.pass)
+			m_edges.push_back(edge{producer, a.pass, true});
+		if(!a.write)
+			continue;
+
+		// write-after-read : 이전 version 의 reader 가 먼저 끝나야 함 (결과는 필요 없음)
+		auto range = std::equal_range(m_reads.begin(), m_reads.end(), a, by_version);
+		for(auto it = range.first; it != range.second; ++it) {
+			if(it->pass != a.pass)
+				m_edges.push_back(edge{it->pass, a.pass, false});
+		}
+	}
+}
+
+void render_graph::cull()
+{
+	const uint32_t pass_count = uint32_t(m_passes.size());
+
+	// 들어오는 edge 로 정렬해 뒤에서부터 필요한 pass 를 따라감
+	std::sort(m_edges.begin(), m_edges.end(), [](const edge& a, const edge& b) { return a.to < b.to; });
+	m_edge_offsets.assign(pass_count + 1, 0);
+	for(const edge& e : m_edges)
+		++m_edge_offsets[e.to + 1];
+	for(uint32_t i = 0; i < pass_count; ++i)
+		m_edge_offsets[i + 1] += m_edge_offsets[i];
+
+	std::vector<uint32_t>& stack = m_order;        // sort 전까지 빌려 씀
+	stack.clear();
+	for(uint32_t i = 0; i < pass_count; ++i) {
+		pass& p = m_passes[i];
+		p.alive = p.never_cull;
+		for(uint32_t a = 0; a < p.access_count && !p.alive; ++a) {
+			const access& acc = m_sorted[p.first_access + a];
+			p.alive           = acc.write && m_resources[acc.resource].imported;
+		}
+		if(p.alive)
+			stack.push_back(i);
+	}
+
+	while(!stack.empty()) {
+		const uint32_t to = stack.back();
+		stack.pop_back();
+		for(uint32_t e = m_edge_offsets[to]; e < m_edge_offsets[to + 1]; ++e) {
+			const edge& ed = m_edges[e];
+			if(ed.needs && !m_passes[ed.from].alive) {
+				m_passes[ed.from].alive = true;
+				stack.push_back(ed.from);
+			}
+		}
+	}
+}
+
+bool render_graph::sort()
+{
+	const uint32_t pass_count = uint32_t(m_passes.size());
+
+	std::sort(m_edges.begin(), m_edges.end(), [](const edge& a, const edge& b) { return a.from < b.from; });
+	m_edge_offsets.assign(pass_count + 1, 0);
+	m_in_degree.assign(pass_count, 0);
+	for(const edge& e : m_edges) {
+		++m_edge_offsets[e.from + 1];
+		if(m_passes[e.from].alive && m_passes[e.to].alive)
+			++m_in_degree[e.to];
+	}
+	for(uint32_t i = 0; i < pass_count; ++i)
+		m_edge_offsets[i + 1] += m_edge_offsets[i];
+
+	// 준비된 pass 중 먼저 선언된 것부터 : 같은 graph 는 항상 같은 순서
+	std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+	uint32_t                                                                      alive_count = 0;
+	for(uint32_t i = 0; i < pass_count; ++i) {
+		if(!m_passes[i].alive)
+			continue;
+		++alive_count;
+		if(m_in_degree[i] == 0)
+			ready.push(i);
+	}
+
+	m_order.clear();
+	while(!ready.empty()) {
+		const uint32_t from = ready.top();
+		ready.pop();
+		m_order.push_back(from);
+		for(uint32_t e = m_edge_offsets[from]; e < m_edge_offsets[from + 1]; ++e) {
+			const uint32_t to = m_edges[e].to;
+			if(m_passes[to].alive && --m_in_degree[to] == 0)
+				ready.push(to);
+		}
+	}
+
+	if(m_order.size() != alive_count) {
+		log_error("render graph : dependency cycle (%u of %u passes sorted)", uint32_t(m_order.size()), alive_count);
+		m_order.clear();
+		return false;
+	}
+	return true;
+}
+
+void render_graph::derive_barriers()
+{
+	// pass 안에서 같은 resource 를 여러 번 선언하면 하나로 합침 (write 상태 우선)
+	m_steps.clear();
+	for(uint32_t position = 0; position < m_order.size(); ++position) {
+		const pass&    p     = m_passes[m_order[position]];
+		const uint32_t begin = uint32_t(m_steps.size());
+		for(uint32_t a = 0; a < p.access_count; ++a) {
+			const access& acc   = m_sorted[p.first_access + a];
+			step*         found = nullptr;
+			for(uint32_t s = begin; s < m_steps.size() && !found; ++s) {
+				if(m_steps[s].resource == acc.resource)
+					found = &m_steps[s];
+			}
+			if(!found) {
+				m_steps.push_back(step{acc.resource, position, acc.state, acc.write});
+			}
+			else if(acc.write) {
+				found->state = acc.state;
+				found->write = true;
+			}
+			else if(!found->write) {
+				found->state = found->state | acc.state;
+			}
+		}
+	}
+	std::stable_sort(m_steps.begin(), m_steps.end(),
+	                 [](const step& a, const step& b) { return a.resource < b.resource; });
+
+	m_barriers.clear();
+	m_barrier_positions.clear();
+	m_final_barriers.clear();
+	auto emit = [this](uint32_t position, uint32_t resource, resource_state before, resource_state after) {
+		m_barrier_positions.push_back(position);
+		m_barriers.push_back(rg_barrier{resource, before, after});
+	};
+
+	for(uint32_t begin = 0; begin < m_steps.size();) {
+		const uint32_t res = m_steps[begin].resource;
+		uint32_t       end = begin;
+		while(end < m_steps.size() && m_steps[end].resource == res)
+			++end;
+
+		resource&      r     = m_resources[res];
+		bool           known = r.imported;
+		resource_state cur   = r.initial;
+
+		for(uint32_t i = begin; i < end; ++i) {
+			const step& s = m_steps[i];
+			if(!s.write && is_read_state(s.state)) {
+				// 다음 write 전까지의 read 는 한 번의 transition 으로
+				resource_state merged = s.state;
+				uint32_t       j      = i + 1;
+				for(; j < end && !m_steps[j].write && is_read_state(m_steps[j].state); ++j)
+					merged = merged | m_steps[j].state;
+
+				if(!known) {
+					r.first = merged;
+					known   = true;
+					cur     = merged;
+				}
+				else if(!is_read_state(cur) || (cur & merged) != merged) {
+					emit(s.position, res, cur, merged);
+					cur = merged;
+				}
+				i = j - 1;
+				continue;
+			}
+
+			if(!known) {
+				r.first = s.state;
+				known   = true;
+			}
+			else if(cur != s.state) {
+				emit(s.position, res, cur, s.state);
+			}
+			else if(s.state == resource_state::unordered_access) {
+				emit(s.position, res, cur, cur);
+			}
+			cur = s.state;
+		}
+
+		if(r.imported && cur != r.final)
+			m_final_barriers.push_back(rg_barrier{res, cur, r.final});
+		begin = end;
+	}
+
+	// pass 실행 순서로 모아 pass 마다 한 번에 제출할 수 있게
+	std::vector<uint32_t>& index = m_in_degree;        // sort 이후 비어 있음
+	index.resize(m_barriers.size());
+	for(uint32_t i = 0; i < index.size(); ++i)
+		index[i] = i;
+	std::stable_sort(index.begin(), index.end(),
+	                 [this](uint32_t a, uint32_t b) { return m_barrier_positions[a] < m_barrier_positions[b]; });
+
+	std::vector<rg_barrier> ordered;
+	ordered.reserve(m_barriers.size());
+	for(uint32_t i : index) {
+		pass& p = m_passes[m_order[m_barrier_positions[i]]];
+		if(p.barrier_count == 0)
+			p.barrier_offset = uint32_t(ordered.size());
+		++p.barrier_count;
+		ordered.push_back(m_barriers[i]);
+	}
+	m_barriers.swap(ordered);
+}
+
+}        // namespace emt
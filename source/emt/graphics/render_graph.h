@@ -0,0 +1,135 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <vector>
+
+namespace emt
+{
+// One version of a graph resource. write() returns the next version, so passes
+// may be declared in any order : the dependencies come from the versions alone.
+struct rg_handle
+{
+	static constexpr uint32_t invalid = ~0u;
+
+	uint32_t resource = invalid;
+	uint32_t version  = 0;
+
+	bool valid() const { return resource != invalid; }
+};
+
+// before == after == unordered_access : uav barrier
+struct rg_barrier
+{
+	uint32_t       resource;
+	resource_state before;
+	resource_state after;
+};
+
+// Backend independent render graph compiler.
+// compile() culls passes that do not contribute to an imported resource (or are
+// marked never_cull), sorts the rest topologically (declaration order on ties)
+// and derives the transitions each pass needs. Consecutive reads are merged into
+// one combined read state, so a resource read by several passes transitions once.
+// Names are not copied and must outlive the frame.
+class render_graph
+{
+public:
+	// passes 와 resources 를 비움 (capacity 는 유지)
+	void reset();
+
+	// external resource : initial 상태에서 시작해 frame 끝에 final 로 되돌림
+	rg_handle import_resource(const char* name, resource_state initial, resource_state final);
+	// transient : 첫 사용 상태로 생성된다고 가정 (first_state)
+	rg_handle create_resource(const char* name);
+
+	uint32_t  add_pass(const char* name, bool never_cull = false);
+	void      read(uint32_t pass, rg_handle handle, resource_state state);
+	rg_handle write(uint32_t pass, rg_handle handle, resource_state state);
+
+	// false : dependency cycle
+	bool compile();
+
+	// compile 결과
+	const std::vector<uint32_t>& order() const { return m_order; }
+	const rg_barrier*            barriers(uint32_t pass, uint32_t* count) const;
+	const std::vector<rg_barrier>& final_barriers() const { return m_final_barriers; }
+	bool                         culled(uint32_t pass) const { return !m_passes[pass].alive; }
+	resource_state               first_state(uint32_t resource) const { return m_resources[resource].first; }
+	uint32_t                     barrier_count() const { return uint32_t(m_barriers.size() + m_final_barriers.size()); }
+
+	uint32_t    pass_count() const { return uint32_t(m_passes.size()); }
+	uint32_t    resource_count() const { return uint32_t(m_resources.size()); }
+	const char* pass_name(uint32_t pass) const { return m_passes[pass].name; }
+	const char* resource_name(uint32_t resource) const { return m_resources[resource].name; }
+	bool        imported(uint32_t resource) const { return m_resources[resource].imported; }
+
+private:
+	struct access
+	{
+		uint32_t       pass;
+		uint32_t       resource;
+		uint32_t       version;        // write 는 입력 version (출력은 version + 1)
+		resource_state state;
+		bool           write;
+	};
+
+	struct pass
+	{
+		const char*  name;
+		bool         never_cull;
+		bool         alive;
+		uint32_t     first_access;
+		uint32_t     access_count;
+		uint32_t     barrier_offset;
+		uint32_t     barrier_count;
+	};
+
+	struct resource
+	{
+		const char*           name;
+		bool                  imported;
+		resource_state        initial;
+		resource_state        final;
+		resource_state        first;
+		std::vector<uint32_t> producers;        // [version] -> pass, version 0 은 외부
+	};
+
+	// execution order 로 펼친 resource 사용 (pass 안의 중복은 합침)
+	struct step
+	{
+		uint32_t       resource;
+		uint32_t       position;
+		resource_state state;
+		bool           write;
+	};
+
+	struct edge
+	{
+		uint32_t from;
+		uint32_t to;
+		bool     needs;        // from 의 결과가 to 에 필요 (culling 전파)
+	};
+
+	void add_edges();
+	void cull();
+	bool sort();
+	void derive_barriers();
+
+	std::vector<pass>     m_passes;
+	std::vector<access>   m_accesses;        // 선언 순서, compile 에서 pass 별로 정렬
+	std::vector<resource> m_resources;
+
+	// compile scratch, frame 사이에 재사용
+	std::vector<edge>       m_edges;
+	std::vector<uint32_t>   m_edge_offsets;
+	std::vector<uint32_t>   m_in_degree;
+	std::vector<uint32_t>   m_order;
+	std::vector<access>     m_sorted;
+	std::vector<access>     m_reads;
+	std::vector<step>       m_steps;
+	std::vector<rg_barrier> m_barriers;
+	std::vector<uint32_t>   m_barrier_positions;
+	std::vector<rg_barrier> m_final_barriers;
+};
+
+}        // namespace emt
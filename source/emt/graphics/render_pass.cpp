@@ -0,0 +1,75 @@
+#include "render_pass.h"
+
+namespace emt
+{
+render_pass_access render_pass_begin_access(load_operator load, store_operator store)
+{
+	if(store == store_operator::no_access)
+		return render_pass_access::no_access;
+	switch(load) {
+		case load_operator::load:
+			return render_pass_access::preserve;
+		case load_operator::clear:
+			return render_pass_access::clear;
+		case load_operator::discard:
+			return render_pass_access::discard;
+	}
+	return render_pass_access::preserve;
+}
+
+render_pass_access render_pass_end_access(store_operator store)
+{
+	switch(store) {
+		case store_operator::store:
+			return render_pass_access::preserve;
+		case store_operator::discard:
+			return render_pass_access::discard;
+		case store_operator::no_access:
+			return render_pass_access::no_access;
+	}
+	return render_pass_access::preserve;
+}
+
+static bool has_stencil(render_target_type type)
+{
+	return type == render_target_type::stencil || type == render_target_type::depth_stencil;
+}
+
+static bool has_depth(render_target_type type)
+{
+	return type == render_target_type::depth || type == render_target_type::depth_stencil;
+}
+
+const char* validate_render_pass(const render_pass_desc& desc)
+{
+	if(desc.color_count > MAX_RENDER_PASS_COLORS)
+		return "too many color attachments";
+	if(desc.color_count == 0 && !desc.has_depth && !desc.uav_writes)
+		return "render pass without attachments";
+
+	for(uint32_t i = 0; i < desc.color_count; ++i) {
+		const render_pass_attachment& a = desc.colors[i];
+		if(a.type != render_target_type::color)
+			return "color slot holds a depth/stencil attachment";
+		// no_access 는 시작과 끝이 같이 no_access 여야 함 (load 할 것이 없음)
+		if(a.store == store_operator::no_access && a.load != load_operator::discard)
+			return "no_access attachment must not be loaded or cleared";
+	}
+
+	if(desc.has_depth) {
+		const render_pass_attachment& d = desc.depth;
+		if(d.type == render_target_type::color)
+			return "depth slot holds a color attachment";
+		if(!has_depth(d.type) && (d.load != load_operator::discard || d.store != store_operator::no_access))
+			return "stencil only attachment must leave depth as no_access";
+		if(!has_stencil(d.type) && (d.stencil_load != load_operator::discard || d.stencil_store != store_operator::no_access))
+			return "depth only attachment must leave stencil as no_access";
+		if(d.store == store_operator::no_access && d.load != load_operator::discard)
+			return "no_access depth must not be loaded or cleared";
+		if(d.stencil_store == store_operator::no_access && d.stencil_load != load_operator::discard)
+			return "no_access stencil must not be loaded or cleared";
+	}
+	return nullptr;
+}
+
+}        // namespace emt
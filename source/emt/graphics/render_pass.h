@@ -0,0 +1,48 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+
+namespace emt
+{
+// What the gpu has to do with an attachment at the start / end of a pass.
+// discard lets tile based and bandwidth limited gpus skip the load or the store.
+enum class render_pass_access : uint32_t {
+	preserve,
+	clear,
+	discard,
+	no_access
+};
+
+struct render_pass_attachment
+{
+	render_target_type type  = render_target_type::color;
+	load_operator      load  = load_operator::load;
+	store_operator     store = store_operator::store;
+
+	float   clear_color[4] = {0.f, 0.f, 0.f, 1.f};
+	float   clear_depth    = 1.f;
+	uint8_t clear_stencil  = 0;
+
+	// depth_stencil 의 stencil 쪽 (depth 는 load/store)
+	load_operator  stencil_load  = load_operator::discard;
+	store_operator stencil_store = store_operator::discard;
+};
+
+struct render_pass_desc
+{
+	render_pass_attachment colors[MAX_RENDER_PASS_COLORS];
+	uint32_t               color_count = 0;
+	render_pass_attachment depth{render_target_type::depth_stencil, load_operator::discard, store_operator::discard};
+	bool                   has_depth  = false;
+	bool                   uav_writes = false;        // pass 안에서 UAV 쓰기가 있음
+};
+
+// load -> beginning access, store -> ending access
+// store::no_access 는 pass 에서 아예 쓰지 않는 attachment : 시작도 no_access
+render_pass_access render_pass_begin_access(load_operator load, store_operator store);
+render_pass_access render_pass_end_access(store_operator store);
+
+// nullptr : valid, 아니면 이유
+const char* validate_render_pass(const render_pass_desc& desc);
+
+}        // namespace emt
@@ -0,0 +1,163 @@
+#include "resource_state_tracker.h"
+
+namespace emt
+{
+// common 에서 barrier 없이 바로 쓸 수 있는 상태 (implicit promotion)
+static bool promotable(resource_state state, bool decays, bool texture_promotion)
+{
+	if(state == resource_state::common)
+		return false;
+	if(decays) {
+		// buffer : depth 를 제외한 모든 상태
+		return (state & (resource_state::depth_write | resource_state::depth_read)) == resource_state::common;
+	}
+	if(!texture_promotion)
+		return false;
+	const resource_state texture_mask = resource_state::shader_read | resource_state::copy_src | resource_state::copy_dst;
+	return (state & texture_mask) == state;
+}
+
+// ===== resource_state_registry =====
+void resource_state_registry::set(const void* resource, uint32_t subresource_count, resource_state state, bool decays)
+{
+	entry& e = m_entries[resource];
+	e.states.assign(subresource_count, state);
+	e.decays = decays;
+}
+
+void resource_state_registry::remove(const void* resource)
+{
+	m_entries.erase(resource);
+}
+
+resource_state resource_state_registry::state(const void* resource, uint32_t subresource) const
+{
+	auto it = m_entries.find(resource);
+	if(it == m_entries.end() || subresource >= it->second.states.size())
+		return resource_state::common;
+	return it->second.states[subresource];
+}
+
+// ===== resource_state_tracker =====
+void resource_state_tracker::reset()
+{
+	m_entries.clear();
+	m_pending.clear();
+}
+
+void resource_state_tracker::track(const void* resource, uint32_t subresource_count, bool decays)
+{
+	entry& e = m_entries[resource];
+	if(e.subs.empty()) {
+		e.subs.resize(subresource_count ? subresource_count : 1);
+		e.decays = decays;
+	}
+}
+
+void resource_state_tracker::require(const void* resource, resource_state state, uint32_t subresource)
+{
+	auto it = m_entries.find(resource);
+	log_assert(it != m_entries.end(), "resource must be tracked before require");
+	entry& e = it->second;
+
+	if(subresource != all_subresources) {
+		log_assert(subresource < e.subs.size(), "subresource out of range");
+		require_one(resource, e, subresource, state);
+		return;
+	}
+
+	// 모든 subresource 가 같은 상태면 barrier 하나로
+	const resource_state cur     = e.subs[0].current;
+	bool                 uniform = true;
+	for(const sub_state& s : e.subs) {
+		uniform = uniform && s.current == cur;
+	}
+	if(!uniform || e.subs.size() == 1) {
+		for(uint32_t i = 0; i < e.subs.size(); ++i)
+			require_one(resource, e, i, state);
+		return;
+	}
+
+	const uint32_t before = uint32_t(m_pending.size());
+	for(uint32_t i = 0; i < e.subs.size(); ++i)
+		require_one(resource, e, i, state);
+	if(m_pending.size() > before) {
+		m_pending.resize(before + 1);
+		m_pending.back().subresource = all_subresources;
+	}
+}
+
+void resource_state_tracker::require_one(const void* resource, entry& e, uint32_t index, resource_state state)
+{
+	sub_state& s = e.subs[index];
+	if(s.current == unknown) {
+		s.first   = state;
+		s.current = state;
+		return;
+	}
+	if(s.current == state)
+		return;
+
+	resource_state target = state;
+	if(is_read_state(s.current) && is_read_state(state)) {
+		// 이미 포함된 read 는 그대로, 아니면 합친 read 상태로
+		if((s.current & state) == state)
+			return;
+		target = s.current | state;
+	}
+	m_pending.push_back(state_barrier{resource, index, s.current, target});
+	s.current          = target;
+	s.explicit_barrier = true;
+}
+
+void resource_state_tracker::uav(const void* resource)
+{
+	m_pending.push_back(state_barrier{resource, all_subresources, resource_state::unordered_access,
+	                                  resource_state::unordered_access});
+}
+
+uint32_t resource_state_tracker::resolve(resource_state_registry* registry, std::vector<state_barrier>* fixups)
+{
+	log_assert(m_pending.empty(), "flush the tracker before resolving it");
+	const size_t first_fixup = fixups->size();
+
+	for(auto& [resource, e] : m_entries) {
+		resource_state_registry::entry& g = registry->m_entries[resource];
+		if(g.states.size() != e.subs.size()) {
+			// 등록되지 않은 (또는 다시 만들어진) resource : 새로 생성된 것으로 봄
+			g.states.assign(e.subs.size(), resource_state::common);
+			g.decays = e.decays;
+		}
+
+		// list 시작 시 상태 맞추기, 전부 같은 전환이면 하나로
+		// (g.states 는 loop 안에서 끝 상태로 바뀌므로 비교 기준은 미리 읽어 둠)
+		const size_t         begin        = fixups->size();
+		const resource_state first_global = g.states[0];
+		bool                 uniform      = true;
+		for(uint32_t i = 0; i < e.subs.size(); ++i) {
+			sub_state&           s      = e.subs[i];
+			const resource_state global = g.states[i];
+			if(s.first == unknown)
+				continue;
+			uniform = uniform && s.first == e.subs[0].first && global == first_global;
+
+			const bool promoted = global == resource_state::common &&
+			                      promotable(s.first, e.decays, registry->m_texture_promotion);
+			if(global != s.first && !promoted)
+				fixups->push_back(state_barrier{resource, i, global, s.first});
+
+			// 끝 상태 반영 : buffer 는 항상, texture 는 promotion 된 read 상태만 decay
+			resource_state final = s.current;
+			if(e.decays || (promoted && !s.explicit_barrier && is_read_state(final)))
+				final = resource_state::common;
+			g.states[i] = final;
+		}
+		if(uniform && e.subs.size() > 1 && fixups->size() == begin + e.subs.size()) {
+			fixups->resize(begin + 1);
+			fixups->back().subresource = all_subresources;
+		}
+	}
+	return uint32_t(fixups->size() - first_fixup);
+}
+
+}        // namespace emt
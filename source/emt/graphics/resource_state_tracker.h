@@ -0,0 +1,105 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <unordered_map>
+#include <vector>
+
+namespace emt
+{
+constexpr uint32_t all_subresources = ~0u;
+
+// before == after == unordered_access : uav barrier
+struct state_barrier
+{
+	const void*    resource;
+	uint32_t       subresource;        // all_subresources : 한 번에 전부
+	resource_state before;
+	resource_state after;
+};
+
+// State of every resource between command lists, as the queue will see it.
+// Only changed at submit time (resource_state_tracker::resolve) in submit order.
+// Resources that decay (buffers) always return to common after a submit.
+class resource_state_registry
+{
+public:
+	// 생성 시 등록 (같은 주소의 이전 기록은 덮어씀)
+	void set(const void* resource, uint32_t subresource_count, resource_state state, bool decays);
+	void remove(const void* resource);
+
+	// 모르는 resource 는 common
+	resource_state state(const void* resource, uint32_t subresource = 0) const;
+	size_t         size() const { return m_entries.size(); }
+
+	// texture 의 common -> read/copy 암시적 promotion 을 가정할지 (legacy barrier 만 해당)
+	void set_texture_promotion(bool enable) { m_texture_promotion = enable; }
+	bool texture_promotion() const { return m_texture_promotion; }
+
+private:
+	friend class resource_state_tracker;
+	struct entry
+	{
+		std::vector<resource_state> states;
+		bool                        decays = false;
+	};
+	std::unordered_map<const void*, entry> m_entries;
+	bool                                   m_texture_promotion = true;
+};
+
+// Per command list tracker : callers only say which state they need.
+// Transitions are queued and handed out by flush() as one batch (call it right
+// before a draw / dispatch / copy). The state a resource is in when the list
+// starts is unknown while recording, so the first use of each subresource is
+// remembered and resolve() patches it against the registry at submit time.
+class resource_state_tracker
+{
+public:
+	void reset();
+	bool empty() const { return m_entries.empty(); }
+
+	bool contains(const void* resource) const { return m_entries.find(resource) != m_entries.end(); }
+	// require 전에 한 번 : subresource 수와 decay 여부 (buffer)
+	void track(const void* resource, uint32_t subresource_count, bool decays);
+
+	void require(const void* resource, resource_state state, uint32_t subresource = all_subresources);
+	void uav(const void* resource);
+
+	// record(const state_barrier*, uint32_t count) : 쌓인 barrier 를 한 번에 기록
+	template<typename Fn>
+	uint32_t flush(Fn&& record)
+	{
+		const uint32_t count = uint32_t(m_pending.size());
+		if(count) {
+			record(m_pending.data(), count);
+			m_pending.clear();
+		}
+		return count;
+	}
+	uint32_t pending_count() const { return uint32_t(m_pending.size()); }
+
+	// submit 직전 (submit 순서대로) : list 앞에 필요한 barrier 를 fixups 에 추가하고
+	// list 끝 상태를 registry 에 반영, 추가한 수 반환
+	uint32_t resolve(resource_state_registry* registry, std::vector<state_barrier>* fixups);
+
+private:
+	static constexpr resource_state unknown = resource_state(~0u);
+
+	struct sub_state
+	{
+		resource_state current          = unknown;
+		resource_state first            = unknown;        // list 시작 시 필요한 상태
+		bool           explicit_barrier = false;          // 첫 사용 이후 barrier 가 있었음
+	};
+	struct entry
+	{
+		std::vector<sub_state> subs;
+		bool                   decays = false;
+	};
+
+	void require_one(const void* resource, entry& e, uint32_t index, resource_state state);
+
+	std::unordered_map<const void*, entry> m_entries;
+	std::vector<state_barrier>             m_pending;
+};
+
+}        // namespace emt
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <deque>
+#include <utility>
+
+namespace emt
+{
+// Objects waiting for a timeline value before they may be destroyed.
+// Values come from one timeline and are pushed in non-decreasing order,
+// so retiring is a pop from the front.
+template<typename T>
+class retire_queue
+{
+public:
+	void push(uint64_t fence_value, T item, uint64_t bytes = 0)
+	{
+		m_items.push_back(entry{fence_value, bytes, std::move(item)});
+		m_pending_bytes += bytes;
+	}
+
+	// release every item whose value is <= completed, returns the bytes freed
+	template<typename Fn>
+	uint64_t collect(uint64_t completed, Fn&& on_release)
+	{
+		uint64_t freed = 0;
+		while(!m_items.empty() && m_items.front().fence_value <= completed) {
+			entry e = std::move(m_items.front());
+			m_items.pop_front();
+			on_release(e.item);
+			freed += e.bytes;
+		}
+		m_pending_bytes -= freed;
+		return freed;
+	}
+
+	uint64_t pending_bytes() const { return m_pending_bytes; }
+	size_t   size() const { return m_items.size(); }
+	bool     empty() const { return m_items.empty(); }
+
+private:
+	struct entry
+	{
+		uint64_t fence_value;
+		uint64_t bytes;
+		T        item;
+	};
+	std::deque<entry> m_items;
+	uint64_t          m_pending_bytes = 0;
+};
+
+}        // namespace emt
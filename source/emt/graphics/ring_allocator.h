@@ -0,0 +1,106 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <deque>
+
+namespace emt
+{
+// Which timeline (queue) consumes an allocation and at which value it is done with it
+struct ring_fence
+{
+	uint32_t timeline = 0;
+	uint64_t value    = 0;
+};
+
+// FIFO suballocator over [0, capacity) units (bytes, descriptors, ...).
+// Every allocation is tagged with the ring_fence of its consumer; retire() frees
+// from the oldest end while the predicate reports the tag complete.
+// Allocations never straddle the end : the skipped end of the range and any
+// alignment padding are accounted to the allocation that caused them.
+class ring_allocator
+{
+public:
+	static constexpr uint64_t invalid = ~0ull;
+
+	void initialize(uint64_t capacity)
+	{
+		m_capacity = capacity;
+		m_head     = 0;
+		m_tail     = 0;
+		m_used     = 0;
+		m_blocks.clear();
+	}
+
+	// align must be a power of two, returns invalid when the ring is full
+	uint64_t allocate(uint64_t size, uint64_t align, ring_fence fence)
+	{
+		if(size == 0 || size > m_capacity)
+			return invalid;
+		if(align == 0)
+			align = 1;
+
+		uint64_t offset = (m_head + (align - 1)) & ~(align - 1);
+		uint64_t end    = offset + size;
+		uint64_t waste  = offset - m_head;
+
+		if(end > m_capacity) {
+			// 끝에서 잘라내고 0 부터 다시
+			waste  = m_capacity - m_head;
+			offset = 0;
+			end    = size;
+		}
+		// 살아있는 구간은 항상 [tail, tail + used) 이고 head 는 그 끝이므로 크기 비교로 충분
+		if(m_used + waste + size > m_capacity)
+			return invalid;
+
+		uint64_t bytes = waste + size;
+		m_used += bytes;
+		m_head = end == m_capacity ? 0 : end;
+
+		if(!m_blocks.empty() && m_blocks.back().fence.timeline == fence.timeline &&
+		   m_blocks.back().fence.value == fence.value) {
+			m_blocks.back().size += bytes;
+		}
+		else {
+			m_blocks.push_back(block{bytes, fence});
+		}
+		return offset;
+	}
+
+	// is_complete(const ring_fence&) -> bool
+	template<typename Fn>
+	uint64_t retire(Fn&& is_complete)
+	{
+		uint64_t freed = 0;
+		while(!m_blocks.empty() && is_complete(m_blocks.front().fence)) {
+			freed += m_blocks.front().size;
+			m_tail = (m_tail + m_blocks.front().size) % m_capacity;
+			m_blocks.pop_front();
+		}
+		m_used -= freed;
+		if(m_used == 0)
+			m_head = m_tail = 0;
+		return freed;
+	}
+
+	// the allocation that blocks the ring the longest, meaningful only when !empty()
+	const ring_fence& oldest() const { return m_blocks.front().fence; }
+
+	bool     empty() const { return m_blocks.empty(); }
+	uint64_t capacity() const { return m_capacity; }
+	uint64_t used() const { return m_used; }
+
+private:
+	struct block
+	{
+		uint64_t   size;
+		ring_fence fence;
+	};
+	std::deque<block> m_blocks;
+	uint64_t          m_capacity = 0;
+	uint64_t          m_head     = 0;
+	uint64_t          m_tail     = 0;
+	uint64_t          m_used     = 0;
+};
+
+}        // namespace emt
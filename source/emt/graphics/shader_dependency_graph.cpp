@@ -0,0 +1,53 @@
+#include "shader_dependency_graph.h"
+#include <algorithm>
+
+namespace emt
+{
+void shader_dependency_graph::set(uint32_t shader, const std::vector<std::string>& files)
+{
+	remove(shader);
+	std::vector<std::string>& list = m_files[shader];
+	list                           = files;
+	std::sort(list.begin(), list.end());
+	list.erase(std::unique(list.begin(), list.end()), list.end());
+	for(const std::string& file : list)
+		m_dependents[file].push_back(shader);
+}
+
+void shader_dependency_graph::remove(uint32_t shader)
+{
+	auto it = m_files.find(shader);
+	if(it == m_files.end())
+		return;
+	for(const std::string& file : it->second) {
+		auto d = m_dependents.find(file);
+		if(d == m_dependents.end())
+			continue;
+		std::vector<uint32_t>& shaders = d->second;
+		shaders.erase(std::remove(shaders.begin(), shaders.end(), shader), shaders.end());
+		if(shaders.empty())
+			m_dependents.erase(d);
+	}
+	m_files.erase(it);
+}
+
+std::vector<uint32_t> shader_dependency_graph::affected(const std::vector<std::string>& changed) const
+{
+	std::vector<uint32_t> out;
+	for(const std::string& file : changed) {
+		auto it = m_dependents.find(file);
+		if(it != m_dependents.end())
+			out.insert(out.end(), it->second.begin(), it->second.end());
+	}
+	std::sort(out.begin(), out.end());
+	out.erase(std::unique(out.begin(), out.end()), out.end());
+	return out;
+}
+
+const std::vector<std::string>* shader_dependency_graph::files(uint32_t shader) const
+{
+	auto it = m_files.find(shader);
+	return it == m_files.end() ? nullptr : &it->second;
+}
+
+}        // namespace emt
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace emt
+{
+// shader -> compile 에 쓰인 파일 (source + include 전체), 역방향 file -> shader
+// 파일 목록은 compile 때 모은 include 의 closure 이므로 간접 include 도 바로 찾음
+// 경로는 normalize_path 형식이어야 함
+class shader_dependency_graph
+{
+public:
+	// shader 의 파일 목록 교체 (다시 compile 되면 include 가 바뀔 수 있음)
+	void set(uint32_t shader, const std::vector<std::string>& files);
+	void remove(uint32_t shader);
+
+	// 바뀐 파일에 의존하는 shader (정렬, 중복 없음)
+	std::vector<uint32_t> affected(const std::vector<std::string>& changed) const;
+
+	const std::vector<std::string>* files(uint32_t shader) const;
+
+private:
+	std::unordered_map<uint32_t, std::vector<std::string>> m_files;
+	std::unordered_map<std::string, std::vector<uint32_t>>  m_dependents;
+};
+
+}        // namespace emt
@@ -0,0 +1,185 @@
+#include "shader_disk_cache.h"
+#include "dxbc_container.h"
+#include "hash.h"
+#include "pipeline_cache_file.h"
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+namespace emt
+{
+namespace fs = std::filesystem;
+
+bool read_binary_file(const char* path, std::vector<uint8_t>* out)
+{
+	out->clear();
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if(!file)
+		return false;
+	const std::streamoff size = file.tellg();
+	if(size < 0)
+		return false;
+	out->resize(static_cast<size_t>(size));
+	file.seekg(0);
+	return size == 0 || bool(file.read(reinterpret_cast<char*>(out->data()), size));
+}
+
+// 줄 머리의 #include "name" / <name>
+static void scan_includes(const uint8_t* text, size_t size, std::vector<std::string>* names)
+{
+	const char* p   = reinterpret_cast<const char*>(text);
+	const char* end = p + size;
+	while(p < end) {
+		const char* line = p;
+		while(p < end && *p != '\n')
+			++p;
+		const char* line_end = p;
+		if(p < end)
+			++p;
+
+		const char* c = line;
+		while(c < line_end && (*c == ' ' || *c == '\t'))
+			++c;
+		if(c == line_end || *c != '#')
+			continue;
+		++c;
+		while(c < line_end && (*c == ' ' || *c == '\t'))
+			++c;
+		if(size_t(line_end - c) < 7 || memcmp(c, "include", 7) != 0)
+			continue;
+		c += 7;
+		while(c < line_end && (*c == ' ' || *c == '\t'))
+			++c;
+		if(c == line_end || (*c != '"' && *c != '<'))
+			continue;
+		const char  close = *c == '"' ? '"' : '>';
+		const char* name  = ++c;
+		while(c < line_end && *c != close)
+			++c;
+		if(c < line_end)
+			names->emplace_back(name, c);
+	}
+}
+
+void shader_disk_cache::initialize(const char* directory, uint64_t compiler_identity)
+{
+	m_directory         = directory ? directory : "";
+	m_compiler_identity = compiler_identity;
+	if(!enabled())
+		return;
+	std::error_code ec;
+	fs::create_directories(m_directory, ec);
+	if(ec) {
+		log_warn("shader cache disabled, cannot create %s (%s)", directory, ec.message().c_str());
+		m_directory.clear();
+	}
+}
+
+void shader_disk_cache::add_include_dir(const char* directory)
+{
+	m_include_dirs.emplace_back(directory);
+}
+
+uint64_t shader_disk_cache::key(const char* file, const void* source, size_t size,
+                                const char* const* args, uint32_t arg_count,
+                                std::span<const std::string> include_dirs,
+                                std::vector<std::string>*    dependencies) const
+{
+	stable_hasher h;
+	h.add(m_compiler_identity);
+	h.add(arg_count);
+	for(uint32_t i = 0; i < arg_count; ++i)
+		h.add_string(args[i]);
+	h.add(uint64_t(size)).add(source, size);
+
+	// include 는 발견 순서대로 (순서도 결정적), 같은 파일은 한 번만
+	struct pending
+	{
+		fs::path             dir;
+		std::vector<uint8_t> text;
+	};
+	std::vector<pending>            stack;
+	std::unordered_set<std::string> visited;
+	std::vector<std::string>        names;
+	std::vector<uint8_t>            text(static_cast<const uint8_t*>(source), static_cast<const uint8_t*>(source) + size);
+
+	stack.push_back(pending{fs::path(file).parent_path(), std::move(text)});
+	if(dependencies)
+		dependencies->assign(1, file);
+	while(!stack.empty()) {
+		pending cur = std::move(stack.back());
+		stack.pop_back();
+
+		names.clear();
+		scan_includes(cur.text.data(), cur.text.size(), &names);
+		for(const std::string& name : names) {
+			h.add_string(name.c_str());
+
+			fs::path        found;
+			std::error_code ec;
+			if(fs::exists(cur.dir / name, ec))
+				found = cur.dir / name;
+			for(size_t i = 0; found.empty() && i < include_dirs.size(); ++i) {
+				if(fs::exists(fs::path(include_dirs[i]) / name, ec))
+					found = fs::path(include_dirs[i]) / name;
+			}
+			for(size_t i = 0; found.empty() && i < m_include_dirs.size(); ++i) {
+				if(fs::exists(fs::path(m_include_dirs[i]) / name, ec))
+					found = fs::path(m_include_dirs[i]) / name;
+			}
+			if(found.empty()) {
+				h.add(uint32_t(0));        // 없는 include : 생기면 key 가 바뀜
+				continue;
+			}
+
+			const std::string canonical = fs::weakly_canonical(found, ec).generic_string();
+			if(!visited.insert(canonical).second)
+				continue;
+			if(dependencies)
+				dependencies->push_back(found.string());
+			std::vector<uint8_t> include;
+			read_binary_file(found.string().c_str(), &include);
+			h.add(uint32_t(1)).add(uint64_t(include.size())).add(include.data(), include.size());
+			stack.push_back(pending{found.parent_path(), std::move(include)});
+		}
+	}
+	return h.value();
+}
+
+std::string shader_disk_cache::path_of(uint64_t key, const char* extension) const
+{
+	char name[32]{};
+	snprintf(name, sizeof(name), "%016llx.%s", static_cast<unsigned long long>(key), extension);
+	return (fs::path(m_directory) / name).string();
+}
+
+bool shader_disk_cache::load(uint64_t key, std::vector<uint8_t>* bytecode, const char* extension) const
+{
+	if(!enabled())
+		return false;
+	const std::string path = path_of(key, extension);
+	std::error_code   ec;
+	if(!fs::exists(path, ec))
+		return false;
+	if(!load_pipeline_cache(path.c_str(), key, bytecode))
+		return false;
+	// bytecode 는 container 구조까지 확인 : 깨진 part table 을 driver 에 넘기지 않음
+	if(strcmp(extension, "dxil") == 0) {
+		dxbc_container container;
+		if(const char* error = container.parse(bytecode->data(), bytecode->size())) {
+			log_warn("shader cache ignored (%s) : %s", error, path.c_str());
+			bytecode->clear();
+			return false;
+		}
+	}
+	return true;
+}
+
+bool shader_disk_cache::store(uint64_t key, const void* bytecode, size_t size, const char* extension) const
+{
+	if(!enabled())
+		return false;
+	return save_pipeline_cache(path_of(key, extension).c_str(), key, bytecode, size);
+}
+
+}        // namespace emt
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <string>
+#include <vector>
+
+namespace emt
+{
+// Content addressed shader bytecode cache (DXC 없이 동작, linux 에서도 build)
+// key = hash(source, include 되는 모든 파일의 내용, compile args, compiler identity)
+// 파일 : <directory>/<key 16 hex>.<extension>, pipeline cache file 형식 (identity = key)
+// include 는 #include 줄을 직접 따라감 : #if 안의 include 도 포함 (key 가 더 자주 바뀔 뿐)
+class shader_disk_cache
+{
+public:
+	void initialize(const char* directory, uint64_t compiler_identity);
+	// 포함하는 파일의 directory 다음으로 찾을 경로
+	void add_include_dir(const char* directory);
+
+	// file 은 include 의 기준 경로, source 는 이미 읽은 file 내용
+	// include_dirs : 이번 compile 에만 추가되는 include 경로 (-I)
+	// dependencies : file 과 찾은 include 전체 (hot reload 용, 찾은 그대로의 경로)
+	// 여러 thread 에서 동시에 key / load / store 가능
+	uint64_t key(const char* file, const void* source, size_t size,
+	             const char* const* args, uint32_t arg_count,
+	             std::span<const std::string> include_dirs = {},
+	             std::vector<std::string>*    dependencies = nullptr) const;
+
+	// extension : 같은 key 로 bytecode 외의 결과도 남김 (reflection 등)
+	bool load(uint64_t key, std::vector<uint8_t>* bytecode, const char* extension = "dxil") const;
+	bool store(uint64_t key, const void* bytecode, size_t size, const char* extension = "dxil") const;
+
+	std::string path_of(uint64_t key, const char* extension = "dxil") const;
+	bool        enabled() const { return !m_directory.empty(); }
+
+private:
+	std::string              m_directory;
+	std::vector<std::string> m_include_dirs;
+	uint64_t                 m_compiler_identity{};
+};
+
+bool read_binary_file(const char* path, std::vector<uint8_t>* out);
+
+}        // namespace emt
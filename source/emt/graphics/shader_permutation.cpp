@@ -0,0 +1,55 @@
+#include "shader_permutation.h"
+
+namespace emt
+{
+uint32_t shader_feature_set::add(const char* name)
+{
+	for(uint32_t i = 0; i < size(); ++i) {
+		if(m_names[i] == name)
+			return i;
+	}
+	log_assert(size() < max_features, "too many shader features");
+	m_names.emplace_back(name);
+	return size() - 1;
+}
+
+uint64_t shader_feature_set::bit(const char* name) const
+{
+	for(uint32_t i = 0; i < size(); ++i) {
+		if(m_names[i] == name)
+			return 1ull << i;
+	}
+	log_warn("unknown shader feature : %s", name);
+	return 0;
+}
+
+uint64_t shader_feature_set::key(std::span<const char* const> enabled) const
+{
+	uint64_t key = 0;
+	for(const char* name : enabled)
+		key |= bit(name);
+	return key;
+}
+
+void shader_feature_set::defines(uint64_t key, std::vector<shader_define>* out) const
+{
+	out->clear();
+	out->reserve(size());
+	for(uint32_t i = 0; i < size(); ++i)
+		out->push_back({m_names[i].c_str(), (key >> i) & 1 ? "1" : "0"});
+}
+
+std::string shader_feature_set::describe(uint64_t key) const
+{
+	std::string out;
+	for(uint32_t i = 0; i < size(); ++i) {
+		if(!((key >> i) & 1))
+			continue;
+		if(!out.empty())
+			out.push_back('|');
+		out.append(m_names[i]);
+	}
+	return out.empty() ? "-" : out;
+}
+
+}        // namespace emt
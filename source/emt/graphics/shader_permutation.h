@@ -0,0 +1,35 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <string>
+#include <vector>
+
+namespace emt
+{
+// Shader 의 feature switch 목록 : permutation 은 켜진 feature 의 bitset (최대 64)
+// 모든 feature 를 0 / 1 로 define -> shader 는 #if FEATURE 로 분기 (동적 branch 없음)
+class shader_feature_set
+{
+public:
+	static constexpr uint32_t max_features = 64;
+
+	// 반환 : bit index, 같은 이름은 같은 index
+	uint32_t add(const char* name);
+	// 없는 이름이면 0 (log_warn)
+	uint64_t bit(const char* name) const;
+	uint64_t key(std::span<const char* const> enabled) const;
+
+	// key 에 없는 bit 는 무시, 문자열은 이 set 이 소유
+	void defines(uint64_t key, std::vector<shader_define>* out) const;
+	// 로그용 "A|B" (없으면 "-")
+	std::string describe(uint64_t key) const;
+
+	uint32_t    size() const { return uint32_t(m_names.size()); }
+	const char* name(uint32_t index) const { return m_names[index].c_str(); }
+	uint64_t    mask() const { return size() == max_features ? ~0ull : (1ull << size()) - 1; }
+
+private:
+	std::vector<std::string> m_names;
+};
+
+}        // namespace emt
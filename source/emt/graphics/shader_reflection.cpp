@@ -0,0 +1,251 @@
+#include "shader_reflection.h"
+#include "dxbc_container.h"
+#include <algorithm>
+#include <bit>
+#include <string.h>
+
+namespace emt
+{
+static constexpr uint32_t reflection_version = 1;
+
+namespace
+{
+struct writer
+{
+	std::vector<uint8_t>* out;
+
+	void bytes(const void* data, size_t size)
+	{
+		const uint8_t* p = static_cast<const uint8_t*>(data);
+		out->insert(out->end(), p, p + size);
+	}
+	template<typename T>
+	void value(T v) { bytes(&v, sizeof(T)); }
+	void string(const std::string& s)
+	{
+		value(uint32_t(s.size()));
+		bytes(s.data(), s.size());
+	}
+};
+
+struct reader
+{
+	const uint8_t* p;
+	const uint8_t* end;
+
+	bool bytes(void* dst, size_t size)
+	{
+		if(size_t(end - p) < size)
+			return false;
+		memcpy(dst, p, size);
+		p += size;
+		return true;
+	}
+	template<typename T>
+	bool value(T* v) { return bytes(v, sizeof(T)); }
+	bool string(std::string* s)
+	{
+		uint32_t size = 0;
+		if(!value(&size) || size_t(end - p) < size)
+			return false;
+		s->assign(reinterpret_cast<const char*>(p), size);
+		p += size;
+		return true;
+	}
+};
+}        // namespace
+
+void shader_reflection::pack(std::vector<uint8_t>* out) const
+{
+	out->clear();
+	writer w{out};
+	w.value(reflection_version);
+	w.value(uint32_t(stage));
+	w.value(uint32_t(bindings.size()));
+	for(const shader_binding& b : bindings) {
+		w.string(b.name);
+		w.value(b.type);
+		w.value(b.slot);
+		w.value(b.space);
+		w.value(b.count);
+		w.value(b.size);
+		w.value(b.stages);
+	}
+	w.value(uint32_t(inputs.size()));
+	for(const shader_input& i : inputs) {
+		w.string(i.semantic);
+		w.value(i.semantic_index);
+		w.value(i.component);
+		w.value(i.components);
+		w.value(uint8_t(i.system_value));
+	}
+}
+
+bool shader_reflection::unpack(const void* data, size_t size)
+{
+	const uint8_t* p = static_cast<const uint8_t*>(data);
+	reader         r{p, p + size};
+	uint32_t       version = 0, stage_value = 0, count = 0;
+	bindings.clear();
+	inputs.clear();
+	if(!r.value(&version) || version != reflection_version || !r.value(&stage_value) || !r.value(&count))
+		return false;
+	stage = shader_stage(stage_value);
+	for(uint32_t i = 0; i < count; ++i) {
+		shader_binding& b = bindings.emplace_back();
+		if(!r.string(&b.name) || !r.value(&b.type) || !r.value(&b.slot) || !r.value(&b.space) ||
+		   !r.value(&b.count) || !r.value(&b.size) || !r.value(&b.stages))
+			return false;
+	}
+	if(!r.value(&count))
+		return false;
+	for(uint32_t i = 0; i < count; ++i) {
+		shader_input& in = inputs.emplace_back();
+		uint8_t       sv = 0;
+		if(!r.string(&in.semantic) || !r.value(&in.semantic_index) || !r.value(&in.component) ||
+		   !r.value(&in.components) || !r.value(&sv))
+			return false;
+		in.system_value = sv != 0;
+	}
+	return r.p == r.end;
+}
+
+bool read_input_signature(const dxbc_container& container, std::vector<shader_input>* out)
+{
+	out->clear();
+	dxbc_part      part;
+	dxbc_signature signature;
+	if(!(container.find(dxbc::isg1, &part) || container.find(dxbc::isgn, &part)) || !signature.parse(part))
+		return false;
+	for(uint32_t i = 0; i < signature.size(); ++i) {
+		dxbc_signature_element e;
+		if(!signature.element(i, &e))
+			return false;
+		shader_input& in  = out->emplace_back();
+		in.semantic       = e.semantic;
+		in.semantic_index = e.semantic_index;
+		in.components     = uint8_t(std::bit_width(uint32_t(e.mask)));
+		in.system_value   = e.system_value != 0;        // D3D_NAME_UNDEFINED
+		in.component      = e.component_type == 1   ? shader_component::uint32
+		                    : e.component_type == 2 ? shader_component::sint32
+		                                            : shader_component::float32;
+	}
+	return true;
+}
+
+uint32_t root_layout_plan::dword_cost() const
+{
+	uint32_t cost = 0;
+	for(const root_parameter_plan& p : parameters)
+		cost += p.kind == root_parameter_kind::cbv ? 2 : 1;
+	return cost;
+}
+
+const root_binding_location* root_layout_plan::find(const char* name) const
+{
+	for(size_t i = 0; i < bindings.size(); ++i) {
+		if(bindings[i].name == name)
+			return &locations[i];
+	}
+	return nullptr;
+}
+
+// 같은 parameter 에 들어갈 binding 은 정렬 후 이웃하도록
+static uint64_t group_key(const shader_binding& b, uint32_t visibility)
+{
+	const bool     root_cbv  = b.type == shader_resource_type::cbv && b.count == 1;
+	const bool     sampler   = b.type == shader_resource_type::sampler;
+	const bool     unbounded = b.count == 0;
+	const uint32_t vis_order = visibility == root_layout_plan::all_stages ? 0 : visibility;
+	return (uint64_t(!root_cbv) << 63) | (uint64_t(sampler) << 62) | (uint64_t(vis_order) << 1) | uint64_t(unbounded);
+}
+
+void plan_root_layout(std::span<const shader_reflection* const> reflections, root_layout_plan* out)
+{
+	*out = root_layout_plan{};
+
+	// stage 끼리 같은 register 는 하나로
+	std::vector<shader_binding>& merged = out->bindings;
+	for(const shader_reflection* r : reflections) {
+		if(!r)
+			continue;
+		out->stages |= shader_stage_bit(r->stage);
+		if(r->stage == shader_stage::vertex) {
+			for(const shader_input& in : r->inputs)
+				out->input_assembler |= !in.system_value;
+		}
+		for(const shader_binding& b : r->bindings) {
+			auto it = std::find_if(merged.begin(), merged.end(), [&b](const shader_binding& m) {
+				return m.type == b.type && m.space == b.space && m.slot == b.slot;
+			});
+			if(it == merged.end()) {
+				merged.push_back(b);
+				merged.back().stages |= shader_stage_bit(r->stage);
+				continue;
+			}
+			it->stages |= b.stages | shader_stage_bit(r->stage);
+			it->count = (it->count == 0 || b.count == 0) ? 0 : std::max(it->count, b.count);
+			it->size  = std::max(it->size, b.size);
+		}
+	}
+
+	auto visibility = [](const shader_binding& b) {
+		return std::popcount(b.stages) == 1 ? b.stages : root_layout_plan::all_stages;
+	};
+	std::sort(merged.begin(), merged.end(), [&](const shader_binding& a, const shader_binding& b) {
+		const uint64_t ka = group_key(a, visibility(a)), kb = group_key(b, visibility(b));
+		if(ka != kb)
+			return ka < kb;
+		if(a.type != b.type)
+			return a.type < b.type;
+		if(a.space != b.space)
+			return a.space < b.space;
+		return a.slot < b.slot;
+	});
+
+	out->locations.resize(merged.size());
+	uint64_t prev_key = ~0ull;
+	for(size_t i = 0; i < merged.size(); ++i) {
+		const shader_binding& b   = merged[i];
+		const uint32_t        vis = visibility(b);
+		const uint64_t        key = group_key(b, vis);
+
+		// root CBV 와 unbounded table 은 binding 하나에 parameter 하나
+		const bool root_cbv = !(key >> 63);
+		if(root_cbv || key != prev_key || b.count == 0) {
+			root_parameter_plan& p = out->parameters.emplace_back();
+			p.kind                 = root_cbv ? root_parameter_kind::cbv : root_parameter_kind::table;
+			p.stages               = vis;
+			p.first_range          = uint32_t(out->ranges.size());
+		}
+		prev_key = key;
+
+		const uint32_t       parameter = uint32_t(out->parameters.size() - 1);
+		root_parameter_plan& p         = out->parameters.back();
+		if(root_cbv) {
+			p.binding         = uint32_t(i);
+			out->locations[i] = {parameter, 0};
+			continue;
+		}
+
+		// 이어지는 register 는 range 하나로
+		root_range_plan* last = p.range_count ? &out->ranges.back() : nullptr;
+		if(last && last->type == b.type && last->space == b.space && last->count != 0 &&
+		   last->slot + last->count == b.slot) {
+			last->count += b.count;
+		}
+		else {
+			root_range_plan& r = out->ranges.emplace_back();
+			r.type             = b.type;
+			r.slot             = b.slot;
+			r.space            = b.space;
+			r.count            = b.count;
+			r.offset           = p.descriptor_count;
+			++p.range_count;
+		}
+		out->locations[i] = {parameter, p.descriptor_count};
+		p.descriptor_count += b.count;
+	}
+}
+
+}        // namespace emt
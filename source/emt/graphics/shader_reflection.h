@@ -0,0 +1,120 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace emt
+{
+enum class shader_resource_type : uint8_t {
+	cbv,
+	srv,
+	uav,
+	sampler
+};
+
+enum class shader_component : uint8_t {
+	float32,
+	uint32,
+	sint32
+};
+
+struct shader_binding
+{
+	std::string          name;
+	shader_resource_type type{};
+	uint32_t             slot{};          // register
+	uint32_t             space{};
+	uint32_t             count{1};        // 0 : unbounded array
+	uint32_t             size{};          // cbuffer byte 수
+	uint32_t             stages{};        // shader_stage_bit 의 합
+};
+
+struct shader_input
+{
+	std::string      semantic;
+	uint32_t         semantic_index{};
+	shader_component component{};
+	uint8_t          components{};          // 1 ~ 4
+	bool             system_value{};        // SV_VertexID 등 : input assembler 에서 오지 않음
+};
+
+// Shader reflection (API 독립) : compile 때 뽑아 bytecode 옆에 disk 로 남김
+struct shader_reflection
+{
+	shader_stage                stage{};
+	std::vector<shader_binding> bindings;
+	std::vector<shader_input>   inputs;        // vertex shader 만
+
+	void pack(std::vector<uint8_t>* out) const;
+	bool unpack(const void* data, size_t size);
+};
+
+class dxbc_container;
+
+// container 의 ISG1 / ISGN 에서 vertex input 만 (DXC / reflection 없이, linux 에서도)
+bool read_input_signature(const dxbc_container& container, std::vector<shader_input>* out);
+
+inline uint32_t shader_stage_bit(shader_stage stage)
+{
+	return 1u << uint32_t(stage);
+}
+
+// Reflection 에서 만든 최소 root signature 계획
+//  - 배열이 아닌 cbuffer : root CBV (table 을 거치지 않음, SetGraphicsRootConstantBufferView 한 번)
+//  - 나머지 : visibility 별 descriptor table 하나, sampler 는 따로, unbounded 배열은 자기 table
+//  - 한 stage 만 쓰는 binding 은 그 stage 로 visibility 를 좁힘
+//  - 쓰지 않는 graphics stage 는 deny flag
+enum class root_parameter_kind : uint8_t {
+	cbv,
+	table
+};
+
+struct root_range_plan
+{
+	shader_resource_type type{};
+	uint32_t             slot{};
+	uint32_t             space{};
+	uint32_t             count{};        // 0 : unbounded
+	uint32_t             offset{};       // table 안의 descriptor 위치
+};
+
+struct root_parameter_plan
+{
+	root_parameter_kind kind{};
+	uint32_t            stages{};        // 한 stage 의 bit, 아니면 all_stages
+	uint32_t            first_range{};
+	uint32_t            range_count{};
+	uint32_t            descriptor_count{};        // table 의 크기, unbounded 면 앞쪽 크기만
+	uint32_t            binding{};                 // cbv : root_layout_plan::bindings 의 index
+};
+
+// binding 이 놓인 자리 : root CBV 면 offset 0
+struct root_binding_location
+{
+	uint32_t parameter;
+	uint32_t offset;
+};
+
+struct root_layout_plan
+{
+	static constexpr uint32_t all_stages = ~0u;
+
+	std::vector<shader_binding>        bindings;         // 모든 stage 를 합친 것
+	std::vector<root_binding_location> locations;        // bindings 와 같은 순서
+	std::vector<root_parameter_plan>   parameters;
+	std::vector<root_range_plan>       ranges;
+	uint32_t                           stages{};                 // 사용된 stage 의 bit
+	bool                               input_assembler{};        // vertex input 이 있음
+
+	// root signature 크기 (DWORD), 64 를 넘으면 만들 수 없음
+	uint32_t dword_cost() const;
+	// nullptr : 없음
+	const root_binding_location* find(const char* name) const;
+};
+
+// reflections : 한 pipeline 의 stage 들 (nullptr 는 건너뜀)
+void plan_root_layout(std::span<const shader_reflection* const> reflections, root_layout_plan* out);
+
+}        // namespace emt
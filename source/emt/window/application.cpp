@@ -4,6 +4,7 @@
 #include <emt/core/logger.h>
 #include <emt/engine/scene.h>
 #include <emt/engine/timer.h>
+#include <emt/engine/job_system.h>
 #include <emt/graphics/dx/dx_context_core.h>
 
 namespace emt
@@ -59,6 +60,7 @@ application::application(int args, char* argv[], int cx, int cy) :
 	m_cy = rc.bottom - rc.top;
 
 	m_context = new dx_context_core(m_cx, m_cy, m_hwnd);
+	m_jobs    = new job_system();
 
 	::ShowWindow(m_hwnd, SW_SHOW);
 	log_info("%s window created with Vulkan", wc.lpszClassName);
@@ -66,6 +68,7 @@ application::application(int args, char* argv[], int cx, int cy) :
 
 application::~application()
 {
+	safe_delete(m_jobs);
 	safe_delete(m_context);
 	::DestroyWindow(m_hwnd);
 }
@@ -74,6 +77,7 @@ int application::execute_scene(scene* p_scene)
 {
 	scene* current_scene = p_scene;
 	if(current_scene) {
+		current_scene->m_jobs = m_jobs;
 		current_scene->init();
 	}
 
@@ -96,6 +100,8 @@ int application::execute_scene(scene* p_scene)
 		timer.begin_frame();
 
 		if(m_context) {
+			// 끝난 shader reload 는 frame 경계에서 교체
+			static_cast<dx_context_core*>(m_context)->shader_reloader()->update(m_jobs);
 			m_context->begin_frame();
 
 			if(current_scene) {
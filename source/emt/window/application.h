@@ -26,8 +26,9 @@ public:
 private:
 	static LRESULT WINAPI static_wnd_proc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp);
 
-	HWND     m_hwnd;
-	context* m_context;
+	HWND        m_hwnd;
+	context*    m_context;
+	job_system* m_jobs{};
 	bool     m_runtime_loop;
 	uint32_t m_cx;
 	uint32_t m_cy;
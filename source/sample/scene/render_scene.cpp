@@ -3,6 +3,7 @@
 #include <emt/graphics/dx/dx_device.h>
 #include <emt/graphics/dx/dx_buffer.h>
 #include <emt/graphics/dx/dx_shader.h>
+#include <emt/engine/job_system.h>
 
 namespace emt
 {
@@ -20,19 +21,22 @@ void render_scene::init()
 	    {{1, 1, 0}, {1, 0, 0}},
 	};
 
-	buffer_create_info info{};
-	info.data = vertices;
-	info.size = std::size(vertices) * sizeof(vertex);
-	info.type = buffer_type::vertex;
+	uint32_t indices[] = {0, 1, 2};
 
-	m_device->create_buffer(&info, &m_vtx_buffer);
+	buffer_create_info infos[2]{};
+	infos[0].data = vertices;
+	infos[0].size = std::size(vertices) * sizeof(vertex);
+	infos[0].type = buffer_type::vertex;
 
-	uint32_t indices[] = {0, 1, 2};
-	info.data          = indices;
-	info.size          = std::size(indices) * sizeof(uint32_t);
-	info.type          = buffer_type::index;
+	infos[1].data = indices;
+	infos[1].size = std::size(indices) * sizeof(uint32_t);
+	infos[1].type = buffer_type::index;
 
-	m_device->create_buffer(&info, &m_idx_buffer);
+	// 한 번의 submit 으로 모두 생성
+	dx_buffer* buffers[2]{};
+	m_device->create_resources(infos, buffers);
+	m_vtx_buffer = buffers[0];
+	m_idx_buffer = buffers[1];
 
 	shader_create_info shader_info{};
 	shader_info.entry    = "main";
@@ -40,7 +44,12 @@ void render_scene::init()
 	shader_info.filename = "shader/vertex.hlsl";
 	shader_info.includes = {};
 
-	dx_shader_cache::compile_from_file(shader_stage::vertex, "shader/vertex.hlsl", "main", &m_vs_shader);
+	// worker 에서 compile, 기다리는 동안 main thread 도 job 을 실행
+	job_counter shaders;
+	dx_shader_cache::compile_batch(m_jobs, {&shader_info, 1}, &m_vs_shader, &shaders);
+	m_jobs->wait(&shaders);
+	// 저장하면 다시 compile 되어 m_vs_shader 가 교체됨
+	m_context->shader_reloader()->watch(shader_info, &m_vs_shader);
 }
 
 void render_scene::update_frame(float dt)
@@ -50,16 +59,23 @@ void render_scene::update_frame(float dt)
 
 void render_scene::render_frame()
 {
-	auto     m_cmd              = m_context->get_current_command_list();
-	uint32_t m_image_index      = m_context->backbuffer_index();
-	auto     render_target_view = m_context->rtv_handle(m_image_index);
+	dx_render_graph* graph  = m_context->graph();
+	dx_render_target target = m_context->backbuffer_target();
+
+	uint32_t clear = graph->add_pass("clear", [=](ID3D12GraphicsCommandList* m_cmd) {
+		render_pass_desc desc;
+		desc.color_count              = 1;
+		desc.colors[0].load           = load_operator::clear;
+		desc.colors[0].store          = store_operator::store;
+		desc.colors[0].clear_color[0] = 0.6f;
+		desc.colors[0].clear_color[1] = 0.6f;
+		desc.colors[0].clear_color[2] = 0.1f;
 
-	const float color[] = {0.6, 0.6, 0.1, 1.f};
-	int         x       = 150;
-	int         y       = 30;
-	D3D12_RECT  rc      = {x, y, ((LONG)m_context->width() / 2) + x, ((LONG)m_context->height() / 2) + y};
-	m_cmd->ClearRenderTargetView(render_target_view, color, 1, &rc);
-	m_cmd->OMSetRenderTargets(1, &render_target_view, TRUE, nullptr);
+		dx_render_pass pass;
+		if(pass.begin(m_cmd, desc, &target))
+			pass.end();
+	});
+	graph->write(clear, m_context->backbuffer(), resource_state::render_target);
 }
 
 void render_scene::release()
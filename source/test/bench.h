@@ -0,0 +1,40 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <emt/engine/timer.h>
+#include <cstdio>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// headless benchmark : 결과는 stdout 에 표로만 출력 (통과/실패 판정은 하지 않음)
+//  - "--quick" : ctest 에서 돌릴 때, 반복 수를 줄여 build 가 깨지지 않았는지만 확인
+namespace emt::bench
+{
+inline bool quick(int argc, char** argv)
+{
+	for(int i = 1; i < argc; ++i) {
+		if(strcmp(argv[i], "--quick") == 0)
+			return true;
+	}
+	return false;
+}
+
+// 1, 2, 4, ... hardware threads (마지막 값은 hardware 수 그대로)
+inline std::vector<uint32_t> thread_counts(uint32_t min_count = 1)
+{
+	const uint32_t        hw = std::max(std::thread::hardware_concurrency(), min_count);
+	std::vector<uint32_t> counts;
+	for(uint32_t n = min_count; n < hw; n *= 2) {
+		counts.push_back(n);
+	}
+	counts.push_back(hw);
+	return counts;
+}
+
+inline double elapsed_ns(time_point start)
+{
+	return std::chrono::duration<double, std::nano>(mono_clock::now() - start).count();
+}
+}        // namespace emt::bench
@@ -0,0 +1,160 @@
+#include "bench.h"
+#include <emt/graphics/descriptor_chunk.h>
+#include <atomic>
+
+// descriptor_chunk_source 의 acquire / refill 을 thread 수별로 측정
+//  - acquire : 모든 thread 가 source 에서 chunk 만 받음, span 이 작을수록 refill (lock) 이 잦음
+//  - cache   : thread 마다 descriptor_chunk_cache 로 1 ~ 4 개씩 (recording thread 와 같은 모양)
+// 매 round 끝에 받은 범위가 겹치지 않는지 확인 (겹치거나 invalid 면 exit code 1)
+using namespace emt;
+
+static constexpr uint32_t k_chunk_size       = 32;
+static constexpr uint32_t k_chunks_per_round = 1024;        // thread 마다
+
+// heap 의 transient ring 대신 : lock 안에서만 호출되므로 plain counter
+struct linear_heap
+{
+	uint32_t capacity = 0;
+	uint32_t used     = 0;
+
+	uint32_t reserve(uint32_t count)
+	{
+		if(capacity - used < count)
+			return descriptor_chunk_source::invalid;
+		const uint32_t first = used;
+		used += count;
+		return first;
+	}
+};
+
+struct range
+{
+	uint32_t first;
+	uint32_t count;
+};
+
+// 모든 thread 의 범위를 표시, 두 번 표시된 index 가 있으면 false
+static bool disjoint(const std::vector<std::vector<range>>& ranges, uint32_t capacity)
+{
+	std::vector<uint8_t> used(capacity, 0);
+	for(const auto& list : ranges) {
+		for(const range& r : list) {
+			if(r.first == descriptor_chunk_source::invalid || r.first + r.count > capacity)
+				return false;
+			for(uint32_t i = r.first; i < r.first + r.count; ++i) {
+				if(used[i]++)
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+// go 이후 모든 thread 가 fn(thread) 를 끝낼 때까지의 시간
+template<typename Fn>
+static double run_threads(uint32_t count, Fn&& fn)
+{
+	std::atomic<bool>        go{false};
+	std::vector<std::thread> threads;
+	for(uint32_t t = 0; t < count; ++t) {
+		threads.emplace_back([&, t]() {
+			while(!go.load(std::memory_order_acquire)) {
+			}
+			fn(t);
+		});
+	}
+	const auto start = mono_clock::now();
+	go.store(true, std::memory_order_release);
+	for(auto& t : threads) {
+		t.join();
+	}
+	return bench::elapsed_ns(start);
+}
+
+static bool bench_acquire(uint32_t rounds, uint32_t chunks_per_span)
+{
+	std::printf("source acquire (%u descriptors per chunk, %u chunks per span)\n", k_chunk_size, chunks_per_span);
+	for(uint32_t threads : bench::thread_counts()) {
+		// span 끝에서 넘친 fetch_add 와 chunk 하나로 줄인 reserve 의 여유분
+		linear_heap heap;
+		heap.capacity = threads * (k_chunks_per_round + chunks_per_span) * k_chunk_size * 2;
+
+		descriptor_chunk_source         source;
+		std::vector<std::vector<range>> ranges(threads);
+		double                          total = 0.0;
+		uint32_t                        spans = 0;
+		bool                            ok    = true;
+		for(uint32_t r = 0; r < rounds && ok; ++r) {
+			// begin_frame 과 같이 : ring 이 돌아오고 source 는 새 span 부터
+			heap.used = 0;
+			source.initialize(k_chunk_size, chunks_per_span, [&heap](uint32_t count) { return heap.reserve(count); });
+			for(auto& list : ranges) {
+				list.clear();
+			}
+			total += run_threads(threads, [&](uint32_t t) {
+				for(uint32_t i = 0; i < k_chunks_per_round; ++i) {
+					ranges[t].push_back({source.acquire(), k_chunk_size});
+				}
+			});
+			spans += source.spans();
+			ok = disjoint(ranges, heap.capacity);
+		}
+		const double count = double(rounds) * threads * k_chunks_per_round;
+		std::printf("  %3u threads                : %8.1f ns/chunk, %6.1f spans/round%s\n", threads, total / count,
+		            double(spans) / rounds, ok ? "" : " (overlap or heap full)");
+		if(!ok)
+			return false;
+	}
+	return true;
+}
+
+static bool bench_cache(uint32_t rounds)
+{
+	static constexpr uint32_t k_allocations = k_chunks_per_round * 16;        // 평균 2.5 개 -> chunk 약 1300 개
+	static constexpr uint32_t k_span        = 16;
+	std::printf("chunk cache allocate (1 ~ 4 descriptors, %u chunks per span)\n", k_span);
+	for(uint32_t threads : bench::thread_counts()) {
+		linear_heap heap;
+		heap.capacity = threads * k_allocations * 4 * 2;
+
+		descriptor_chunk_source             source;
+		std::vector<descriptor_chunk_cache> caches(threads);
+		std::vector<std::vector<range>>     ranges(threads);
+		double                              total = 0.0;
+		bool                                ok    = true;
+		for(uint32_t r = 0; r < rounds && ok; ++r) {
+			heap.used = 0;
+			source.initialize(k_chunk_size, k_span, [&heap](uint32_t count) { return heap.reserve(count); });
+			for(uint32_t t = 0; t < threads; ++t) {
+				caches[t].bind(&source);
+				caches[t].reset();
+				ranges[t].clear();
+			}
+			total += run_threads(threads, [&](uint32_t t) {
+				for(uint32_t i = 0; i < k_allocations; ++i) {
+					const uint32_t count = 1 + (i + t) % 4;
+					ranges[t].push_back({caches[t].allocate(count), count});
+				}
+			});
+			ok = disjoint(ranges, heap.capacity);
+		}
+		const double count = double(rounds) * threads * k_allocations;
+		std::printf("  %3u threads                : %8.1f ns/allocate%s\n", threads, total / count,
+		            ok ? "" : " (overlap or heap full)");
+		if(!ok)
+			return false;
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	const uint32_t rounds = bench::quick(argc, argv) ? 2 : 200;
+	std::printf("hardware threads : %u\n", std::thread::hardware_concurrency());
+	// chunks per span 1 : 매 acquire 가 refill (lock)
+	for(uint32_t span : {1u, 16u, 256u}) {
+		if(!bench_acquire(rounds, span))
+			return 1;
+	}
+	return bench_cache(rounds) ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include "bench.h"
+#include <emt/engine/job_system.h>
+#include <atomic>
+
+// job_system 의 spawn / local pop / steal 비용을 thread 수별로 측정
+//  - deque     : work_stealing_deque 단독 (owner push/pop, thief steal)
+//  - spawn     : main thread 가 빈 job 을 spawn + wait, 다른 thread 가 가져간 비율은 steal
+//  - fan-out   : job 안에서 자식을 spawn -> 대부분 자기 queue 에서 pop
+using namespace emt;
+
+static constexpr uint32_t k_batch = 2048;        // queue (4096) 가 넘치면 바로 실행되므로 그 아래로
+
+typedef work_stealing_deque<uint32_t*, 4096> deque_type;
+
+static void bench_deque_local(uint32_t rounds)
+{
+	static uint32_t items[k_batch];
+	deque_type      queue;
+	const auto      start = mono_clock::now();
+	for(uint32_t r = 0; r < rounds; ++r) {
+		for(uint32_t i = 0; i < k_batch; ++i) {
+			queue.push(&items[i]);
+		}
+		while(queue.pop()) {
+		}
+	}
+	const double ns = bench::elapsed_ns(start) / (double(rounds) * k_batch);
+	std::printf("deque local push+pop        : %8.1f ns/item\n", ns);
+}
+
+static void bench_deque_steal(uint32_t rounds)
+{
+	static uint32_t items[k_batch];
+	std::printf("deque steal (owner fills, thieves drain)\n");
+	for(uint32_t thieves : bench::thread_counts()) {
+		deque_type            queue;
+		std::atomic<uint32_t> go{0};
+		std::atomic<uint32_t> taken{0};
+		std::atomic<uint32_t> idle{thieves};        // 이번 round 를 끝낸 thief 수
+		std::atomic<bool>     stop{false};
+
+		std::vector<std::thread> threads;
+		for(uint32_t t = 0; t < thieves; ++t) {
+			threads.emplace_back([&]() {
+				uint32_t seen = 0;
+				while(!stop.load(std::memory_order_acquire)) {
+					if(go.load(std::memory_order_acquire) == seen)
+						continue;
+					seen = go.load(std::memory_order_relaxed);
+					// 모두 가져갈 때까지 steal, 그 뒤로는 다음 round 의 push 전까지 queue 를 건드리지 않음
+					while(taken.load(std::memory_order_relaxed) != k_batch) {
+						if(queue.steal())
+							taken.fetch_add(1, std::memory_order_relaxed);
+					}
+					idle.fetch_add(1, std::memory_order_release);
+				}
+			});
+		}
+
+		double total = 0.0;
+		for(uint32_t r = 0; r < rounds; ++r) {
+			// 이전 round 의 thief 가 모두 빠져나간 뒤에만 push / reset
+			while(idle.load(std::memory_order_acquire) != thieves) {
+			}
+			for(uint32_t i = 0; i < k_batch; ++i) {
+				queue.push(&items[i]);
+			}
+			taken.store(0, std::memory_order_relaxed);
+			idle.store(0, std::memory_order_relaxed);
+			const auto start = mono_clock::now();
+			go.fetch_add(1, std::memory_order_release);
+			while(taken.load(std::memory_order_acquire) != k_batch) {
+			}
+			total += bench::elapsed_ns(start);
+		}
+		while(idle.load(std::memory_order_acquire) != thieves) {
+		}
+		stop.store(true, std::memory_order_release);
+		for(auto& t : threads) {
+			t.join();
+		}
+		std::printf("  %3u thieves                : %8.1f ns/steal\n", thieves, total / (double(rounds) * k_batch));
+	}
+}
+
+static void bench_spawn(uint32_t rounds)
+{
+	std::printf("job_system spawn + wait (empty jobs from the main thread)\n");
+	for(uint32_t threads : bench::thread_counts(2)) {
+		job_system            jobs(threads - 1);
+		std::atomic<uint32_t> stolen{0};
+		auto                  count_stolen = [&stolen]() {
+			if(job_system::thread_index() != 0)
+				stolen.fetch_add(1, std::memory_order_relaxed);
+		};
+
+		const auto start = mono_clock::now();
+		for(uint32_t r = 0; r < rounds; ++r) {
+			job_counter counter;
+			for(uint32_t i = 0; i < k_batch; ++i) {
+				jobs.spawn(count_stolen, &counter);
+			}
+			jobs.wait(&counter);
+		}
+		const double count = double(rounds) * k_batch;
+		std::printf("  %3u threads                : %8.1f ns/job, %5.1f%% stolen\n", threads,
+		            bench::elapsed_ns(start) / count, 100.0 * stolen.load() / count);
+	}
+}
+
+static void bench_fan_out(uint32_t rounds)
+{
+	// root 마다 자식 64 개 : 자식은 root 를 실행한 thread 의 queue 에 들어감
+	static constexpr uint32_t k_children = 64;
+	static constexpr uint32_t k_roots    = k_batch / k_children;
+	std::printf("job_system fan-out (%u roots x %u children, local pop)\n", k_roots, k_children);
+	for(uint32_t threads : bench::thread_counts(2)) {
+		job_system jobs(threads - 1);
+		auto       root = [&jobs]() {
+			job_counter children;
+			for(uint32_t c = 0; c < k_children; ++c) {
+				jobs.spawn([]() {}, &children);
+			}
+			jobs.wait(&children);
+		};
+
+		const auto start = mono_clock::now();
+		for(uint32_t r = 0; r < rounds; ++r) {
+			job_counter roots;
+			for(uint32_t i = 0; i < k_roots; ++i) {
+				jobs.spawn(root, &roots);
+			}
+			jobs.wait(&roots);
+		}
+		const double count = double(rounds) * k_roots * (k_children + 1);
+		std::printf("  %3u threads                : %8.1f ns/job\n", threads, bench::elapsed_ns(start) / count);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const uint32_t rounds = bench::quick(argc, argv) ? 4 : 512;
+	std::printf("hardware threads : %u\n", std::thread::hardware_concurrency());
+	bench_deque_local(rounds);
+	bench_deque_steal(rounds);
+	bench_spawn(rounds);
+	bench_fan_out(rounds);
+	return 0;
+}
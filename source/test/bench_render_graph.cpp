@@ -0,0 +1,82 @@
+#include "bench.h"
+#include <emt/graphics/render_graph.h>
+
+// render_graph 선언 + compile 비용 (pass 수별)
+//  - pass 마다 앞쪽 resource 두 개를 읽고 하나를 씀, 일부는 culling 되도록 import 에 닿지 않음
+//  - 같은 graph 를 매 frame 다시 선언 (reset 은 capacity 를 유지)
+using namespace emt;
+
+struct graph_shape
+{
+	std::vector<uint32_t> reads;        // pass 마다 두 개
+	std::vector<bool>     to_output;
+};
+
+static graph_shape make_shape(uint32_t pass_count)
+{
+	graph_shape shape;
+	uint32_t    rng  = 0x12345678u;
+	auto        next = [&rng]() {
+		rng ^= rng << 13;
+		rng ^= rng >> 17;
+		rng ^= rng << 5;
+		return rng;
+	};
+	for(uint32_t i = 0; i < pass_count; ++i) {
+		shape.reads.push_back(i ? next() % i : 0);
+		shape.reads.push_back(i ? next() % i : 0);
+		shape.to_output.push_back(next() % 8 == 0);
+	}
+	return shape;
+}
+
+static void declare(render_graph& g, const graph_shape& shape, std::vector<rg_handle>& outputs)
+{
+	const uint32_t pass_count = uint32_t(shape.to_output.size());
+	rg_handle      backbuffer = g.import_resource("backbuffer", resource_state::present, resource_state::present);
+
+	outputs.clear();
+	for(uint32_t i = 0; i < pass_count; ++i) {
+		const uint32_t pass = g.add_pass("pass");
+		if(i > 0) {
+			g.read(pass, outputs[shape.reads[i * 2 + 0]], resource_state::shader_read);
+			g.read(pass, outputs[shape.reads[i * 2 + 1]], resource_state::shader_read);
+		}
+		const resource_state state = i % 3 ? resource_state::render_target : resource_state::unordered_access;
+		outputs.push_back(g.write(pass, g.create_resource("target"), state));
+		if(shape.to_output[i])
+			backbuffer = g.write(pass, backbuffer, resource_state::render_target);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const uint32_t frames = bench::quick(argc, argv) ? 2 : 200;
+	std::printf("render graph declare + compile\n");
+
+	render_graph           g;
+	std::vector<rg_handle> outputs;
+	for(uint32_t pass_count : {100u, 500u, 1000u, 2000u}) {
+		const graph_shape shape = make_shape(pass_count);
+
+		double declare_ns = 0.0;
+		double compile_ns = 0.0;
+		bool   ok         = true;
+		for(uint32_t f = 0; f < frames; ++f) {
+			g.reset();
+			auto start = mono_clock::now();
+			declare(g, shape, outputs);
+			declare_ns += bench::elapsed_ns(start);
+
+			start = mono_clock::now();
+			ok    = g.compile() && ok;
+			compile_ns += bench::elapsed_ns(start);
+		}
+		std::printf("  %5u passes : declare %8.1f us, compile %8.1f us, %4u alive, %5u barriers%s\n", pass_count,
+		            declare_ns / frames / 1000.0, compile_ns / frames / 1000.0, uint32_t(g.order().size()),
+		            g.barrier_count(), ok ? "" : " (cycle)");
+		if(!ok)
+			return 1;
+	}
+	return 0;
+}
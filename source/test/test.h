@@ -0,0 +1,40 @@
+#pragma once
+
+#include <emt/core/typedef.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// headless test : device 없이 CPU 쪽 logic 만 확인
+//  - TEST_CASE 로 등록, main 은 test_main.cpp (인자로 이름 일부를 주면 그것만 실행)
+//  - CHECK 는 실패해도 계속 진행, 실패가 하나라도 있으면 exit code 1
+namespace emt::test
+{
+typedef void (*test_function)();
+
+struct test_case
+{
+	const char*   name;
+	test_function function;
+};
+
+std::vector<test_case>& registry();
+void                    report(const char* expr, const char* file, int line);
+
+struct registrar
+{
+	registrar(const char* name, test_function function) { registry().push_back({name, function}); }
+};
+}        // namespace emt::test
+
+#define TEST_CASE(name)                                               \
+	static void                name();                                \
+	static emt::test::registrar name##_registrar(#name, name);        \
+	static void                name()
+
+#define CHECK(cond)                                              \
+	do {                                                         \
+		if(!(cond)) {                                            \
+			emt::test::report(#cond, __FILE__, __LINE__);        \
+		}                                                        \
+	} while(0)
@@ -0,0 +1,123 @@
+#include "test.h"
+#include <emt/graphics/dx/dx_barrier_batch.h>
+
+using namespace emt;
+
+// resource 는 dereference 하지 않음 : 주소만 다르면 됨
+static ID3D12Resource* fake_resource(uintptr_t id)
+{
+	return reinterpret_cast<ID3D12Resource*>(id * 0x100);
+}
+
+static dx_barrier_batch::entry barrier(uintptr_t id, uint32_t subresource, resource_state before, resource_state after,
+                                       bool buffer)
+{
+	return dx_barrier_batch::entry{fake_resource(id), subresource, before, after, buffer};
+}
+
+TEST_CASE(legacy_state_merges_reads)
+{
+	CHECK(dx_resource_state(resource_state::common) == D3D12_RESOURCE_STATE_COMMON);
+	CHECK(dx_resource_state(resource_state::shader_read | resource_state::copy_src) ==
+	      (D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_COPY_SOURCE));
+	CHECK(dx_resource_state(resource_state::vertex_buffer) == dx_resource_state(resource_state::constant_buffer));
+}
+
+TEST_CASE(enhanced_scope_layouts)
+{
+	const dx_barrier_scope common = dx_barrier_scope_of(resource_state::common);
+	CHECK(common.sync == D3D12_BARRIER_SYNC_NONE);
+	CHECK(common.access == D3D12_BARRIER_ACCESS_NO_ACCESS);
+	CHECK(common.layout == D3D12_BARRIER_LAYOUT_COMMON);
+
+	const dx_barrier_scope rt = dx_barrier_scope_of(resource_state::render_target);
+	CHECK(rt.sync == D3D12_BARRIER_SYNC_RENDER_TARGET);
+	CHECK(rt.access == D3D12_BARRIER_ACCESS_RENDER_TARGET);
+	CHECK(rt.layout == D3D12_BARRIER_LAYOUT_RENDER_TARGET);
+
+	// 합친 read : layout 이 하나로 정해지지 않으면 generic read, depth read 가 있으면 depth layout
+	const dx_barrier_scope merged = dx_barrier_scope_of(resource_state::shader_read | resource_state::copy_src);
+	CHECK(merged.access == (D3D12_BARRIER_ACCESS_SHADER_RESOURCE | D3D12_BARRIER_ACCESS_COPY_SOURCE));
+	CHECK(merged.layout == D3D12_BARRIER_LAYOUT_GENERIC_READ);
+	const dx_barrier_scope depth = dx_barrier_scope_of(resource_state::depth_read | resource_state::shader_read);
+	CHECK(depth.layout == D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ);
+}
+
+TEST_CASE(legacy_translation)
+{
+	const dx_barrier_batch::entry entries[] = {
+	    barrier(1, all_subresources, resource_state::unordered_access, resource_state::unordered_access, true),
+	    barrier(2, 0, resource_state::vertex_buffer, resource_state::constant_buffer, true),        // 같은 legacy 상태
+	    barrier(3, 3, resource_state::render_target, resource_state::shader_read, false),
+	};
+	std::vector<D3D12_RESOURCE_BARRIER> out;
+	dx_barrier_batch::translate_legacy(entries, 3, &out);
+	CHECK(out.size() == 2);
+	if(out.size() != 2)
+		return;
+
+	CHECK(out[0].Type == D3D12_RESOURCE_BARRIER_TYPE_UAV);
+	CHECK(out[0].UAV.pResource == fake_resource(1));
+
+	CHECK(out[1].Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION);
+	CHECK(out[1].Transition.pResource == fake_resource(3));
+	CHECK(out[1].Transition.Subresource == 3);
+	CHECK(out[1].Transition.StateBefore == D3D12_RESOURCE_STATE_RENDER_TARGET);
+	CHECK(out[1].Transition.StateAfter == D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
+}
+
+TEST_CASE(legacy_promotion_and_decay_states)
+{
+	// registry 의 common 은 legacy 에서 COMMON (= PRESENT) 으로 : decay 된 buffer 에서 시작하는 보정
+	const dx_barrier_batch::entry entries[] = {
+	    barrier(1, all_subresources, resource_state::common, resource_state::render_target, false),
+	    barrier(2, all_subresources, resource_state::shader_read, resource_state::common, false),
+	};
+	std::vector<D3D12_RESOURCE_BARRIER> out;
+	dx_barrier_batch::translate_legacy(entries, 2, &out);
+	CHECK(out.size() == 2);
+	if(out.size() != 2)
+		return;
+	CHECK(out[0].Transition.StateBefore == D3D12_RESOURCE_STATE_COMMON);
+	CHECK(out[0].Transition.Subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+	CHECK(out[1].Transition.StateAfter == D3D12_RESOURCE_STATE_COMMON);
+}
+
+TEST_CASE(enhanced_translation_splits_buffers_and_textures)
+{
+	const dx_barrier_batch::entry entries[] = {
+	    barrier(1, all_subresources, resource_state::unordered_access, resource_state::unordered_access, true),
+	    barrier(2, all_subresources, resource_state::shader_read, resource_state::shader_read, true),        // 생략
+	    barrier(3, all_subresources, resource_state::copy_dst, resource_state::shader_read, true),
+	    barrier(4, 2, resource_state::render_target, resource_state::shader_read, false),
+	    barrier(5, all_subresources, resource_state::common, resource_state::copy_dst, false),
+	};
+	std::vector<D3D12_BUFFER_BARRIER>  buffers;
+	std::vector<D3D12_TEXTURE_BARRIER> textures;
+	dx_barrier_batch::translate_enhanced(entries, 5, &buffers, &textures);
+
+	CHECK(buffers.size() == 2);
+	if(buffers.size() == 2) {
+		// uav -> uav 는 access 가 같아도 유지 (uav barrier)
+		CHECK(buffers[0].pResource == fake_resource(1));
+		CHECK(buffers[0].AccessBefore == D3D12_BARRIER_ACCESS_UNORDERED_ACCESS);
+		CHECK(buffers[0].AccessAfter == D3D12_BARRIER_ACCESS_UNORDERED_ACCESS);
+		CHECK(buffers[1].pResource == fake_resource(3));
+		CHECK(buffers[1].SyncBefore == D3D12_BARRIER_SYNC_COPY);
+		CHECK(buffers[1].AccessAfter == D3D12_BARRIER_ACCESS_SHADER_RESOURCE);
+	}
+
+	CHECK(textures.size() == 2);
+	if(textures.size() == 2) {
+		CHECK(textures[0].pResource == fake_resource(4));
+		CHECK(textures[0].LayoutBefore == D3D12_BARRIER_LAYOUT_RENDER_TARGET);
+		CHECK(textures[0].LayoutAfter == D3D12_BARRIER_LAYOUT_SHADER_RESOURCE);
+		CHECK(textures[0].Subresources.IndexOrFirstMipLevel == 2);
+		// common 에서 : 이전 submit 의 작업과 sync 없음 (enhanced 는 promotion 이 없어 항상 명시)
+		CHECK(textures[1].SyncBefore == D3D12_BARRIER_SYNC_NONE);
+		CHECK(textures[1].AccessBefore == D3D12_BARRIER_ACCESS_NO_ACCESS);
+		CHECK(textures[1].LayoutBefore == D3D12_BARRIER_LAYOUT_COMMON);
+		CHECK(textures[1].LayoutAfter == D3D12_BARRIER_LAYOUT_COPY_DEST);
+		CHECK(textures[1].Subresources.IndexOrFirstMipLevel == all_subresources);
+	}
+}
@@ -0,0 +1,144 @@
+#include "test.h"
+#include <emt/graphics/bindless_allocator.h>
+
+using namespace emt;
+
+TEST_CASE(handles_map_to_heap_indices_from_first)
+{
+	bindless_allocator bindless;
+	bindless.initialize(100, 4);
+	bindless_handle a = bindless.allocate();
+	bindless_handle b = bindless.allocate();
+	CHECK(a && b);
+	CHECK(a.slot() == 0);
+	CHECK(b.slot() == 1);
+	CHECK(bindless.index(a) == 100);
+	CHECK(bindless.index(b) == 101);
+	CHECK(a.generation() == 1);
+	CHECK(bindless.size() == 2);
+	CHECK(!bindless_handle{});
+	CHECK(!bindless.valid(bindless_handle{}));
+}
+
+TEST_CASE(full_heap_returns_invalid_handle)
+{
+	bindless_allocator bindless;
+	bindless.initialize(0, 2);
+	CHECK(bindless.allocate());
+	CHECK(bindless.allocate());
+	CHECK(!bindless.allocate());
+	CHECK(bindless.size() == 2);
+}
+
+TEST_CASE(free_invalidates_the_handle_immediately)
+{
+	bindless_allocator bindless;
+	bindless.initialize(0, 4);
+	bindless_handle a = bindless.allocate();
+	CHECK(bindless.valid(a));
+	bindless.free(a, 1);
+	CHECK(!bindless.valid(a));
+	CHECK(bindless.size() == 0);
+	CHECK(bindless.pending() == 1);
+
+	// 두 번째 free 는 무시 (generation 이 이미 바뀜)
+	bindless.free(a, 2);
+	CHECK(bindless.pending() == 1);
+}
+
+TEST_CASE(slot_is_reused_only_after_the_retire_value_completes)
+{
+	bindless_allocator bindless;
+	bindless.initialize(0, 1);
+	bindless_handle a = bindless.allocate();
+	bindless.free(a, 5);
+
+	// gpu 가 아직 5 를 지나지 않음 -> slot 은 비어 있지 않음
+	CHECK(!bindless.allocate());
+	bindless.collect(4);
+	CHECK(bindless.pending() == 1);
+	CHECK(!bindless.allocate());
+
+	bindless.collect(5);
+	CHECK(bindless.pending() == 0);
+	bindless_handle b = bindless.allocate();
+	CHECK(b);
+	CHECK(b.slot() == a.slot());
+	CHECK(b.generation() == a.generation() + 1);
+	CHECK(b != a);
+
+	// 같은 slot 이라도 이전 handle 은 계속 invalid
+	CHECK(bindless.valid(b));
+	CHECK(!bindless.valid(a));
+	bindless.free(a, 6);
+	CHECK(bindless.valid(b));
+	CHECK(bindless.size() == 1);
+}
+
+TEST_CASE(collect_retires_in_value_order)
+{
+	bindless_allocator bindless;
+	bindless.initialize(0, 3);
+	bindless_handle a = bindless.allocate();
+	bindless_handle b = bindless.allocate();
+	bindless_handle c = bindless.allocate();
+	bindless.free(a, 1);
+	bindless.free(b, 2);
+	bindless.free(c, 2);
+
+	bindless.collect(1);
+	CHECK(bindless.pending() == 2);
+	// LIFO : 방금 돌아온 slot 부터
+	bindless_handle d = bindless.allocate();
+	CHECK(d.slot() == a.slot());
+	CHECK(!bindless.allocate());
+
+	bindless.collect(2);
+	CHECK(bindless.pending() == 0);
+	CHECK(bindless.allocate());
+	CHECK(bindless.allocate());
+	CHECK(!bindless.allocate());
+}
+
+TEST_CASE(generation_wraps_past_zero)
+{
+	bindless_allocator bindless;
+	bindless.initialize(0, 1);
+	bindless_handle first = bindless.allocate();
+	bindless_handle last  = first;
+	uint64_t        value = 0;
+	for(uint32_t i = 0; i < bindless_handle::generation_mask; ++i) {
+		bindless.free(last, ++value);
+		bindless.collect(value);
+		last = bindless.allocate();
+		// 0 은 invalid handle 용이므로 건너뜀
+		CHECK(last.generation() != 0);
+		CHECK(last);
+	}
+	// generation_mask 번 돌면 처음 generation 으로 돌아옴
+	CHECK(last == first);
+	CHECK(bindless.valid(last));
+}
+
+TEST_CASE(out_of_range_handle_is_invalid)
+{
+	bindless_allocator bindless;
+	bindless.initialize(0, 2);
+	bindless_handle foreign{(1u << bindless_handle::slot_bits) | 7};
+	CHECK(!bindless.valid(foreign));
+	bindless.free(foreign, 1);
+	CHECK(bindless.pending() == 0);
+}
+
+TEST_CASE(release_invalidates_everything)
+{
+	bindless_allocator bindless;
+	bindless.initialize(0, 2);
+	bindless_handle a = bindless.allocate();
+	bindless.free(bindless.allocate(), 1);
+	bindless.release();
+	CHECK(!bindless.valid(a));
+	CHECK(bindless.capacity() == 0);
+	CHECK(bindless.pending() == 0);
+	CHECK(!bindless.allocate());
+}
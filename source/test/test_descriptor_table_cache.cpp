@@ -0,0 +1,116 @@
+#include "test.h"
+#include <emt/graphics/descriptor_table_cache.h>
+
+using namespace emt;
+
+static bindless_handle handle(uint32_t generation, uint32_t slot)
+{
+	return bindless_handle{(generation << bindless_handle::slot_bits) | slot};
+}
+
+// hash 를 cache 의 것으로 계산해서 찾음
+static bool lookup(descriptor_table_cache& cache, std::span<const bindless_handle> sources, uint32_t* index)
+{
+	return cache.find(sources, descriptor_table_cache::hash(sources), index);
+}
+
+static void store(descriptor_table_cache& cache, std::span<const bindless_handle> sources, uint32_t index)
+{
+	cache.insert(sources, descriptor_table_cache::hash(sources), index);
+}
+
+TEST_CASE(same_handles_in_the_same_order_hit)
+{
+	descriptor_table_cache cache;
+	const bindless_handle  table[] = {handle(1, 4), handle(1, 9), handle(2, 0)};
+	uint32_t               index   = 0;
+	CHECK(!lookup(cache, table, &index));
+	store(cache, table, 100);
+
+	// 다른 배열, 같은 내용
+	const bindless_handle copy[] = {handle(1, 4), handle(1, 9), handle(2, 0)};
+	CHECK(lookup(cache, copy, &index));
+	CHECK(index == 100);
+	CHECK(cache.hits() == 1);
+	CHECK(cache.misses() == 1);
+	CHECK(cache.size() == 1);
+}
+
+TEST_CASE(order_and_length_are_part_of_the_key)
+{
+	descriptor_table_cache cache;
+	const bindless_handle  table[] = {handle(1, 4), handle(1, 9), handle(2, 0)};
+	store(cache, table, 100);
+
+	uint32_t              index      = 0;
+	const bindless_handle swapped[]  = {handle(1, 9), handle(1, 4), handle(2, 0)};
+	const bindless_handle prefix[]   = {handle(1, 4), handle(1, 9)};
+	const bindless_handle extended[] = {handle(1, 4), handle(1, 9), handle(2, 0), handle(1, 1)};
+	CHECK(descriptor_table_cache::hash(swapped) != descriptor_table_cache::hash(table));
+	CHECK(!lookup(cache, swapped, &index));
+	CHECK(!lookup(cache, prefix, &index));
+	CHECK(!lookup(cache, extended, &index));
+	CHECK(cache.misses() == 3);
+	CHECK(cache.hits() == 0);
+}
+
+TEST_CASE(hash_collisions_resolve_by_exact_compare)
+{
+	descriptor_table_cache cache;
+	const uint64_t         shared = 0x1234;        // 억지로 같은 hash
+	const bindless_handle  a[]    = {handle(1, 1), handle(1, 2)};
+	const bindless_handle  b[]    = {handle(1, 3)};
+	const bindless_handle  c[]    = {handle(1, 1), handle(1, 3)};
+	cache.insert(a, shared, 10);
+	cache.insert(b, shared, 20);
+
+	uint32_t index = 0;
+	CHECK(cache.find(a, shared, &index) && index == 10);
+	CHECK(cache.find(b, shared, &index) && index == 20);
+	CHECK(!cache.find(c, shared, &index));
+	// 내용이 같아도 다른 hash 로는 찾지 않음
+	CHECK(!cache.find(a, shared + 1, &index));
+	CHECK(cache.size() == 2);
+}
+
+TEST_CASE(reused_staging_slot_misses)
+{
+	// staging descriptor 가 해제된 뒤 같은 slot 에 다른 view 가 들어옴
+	bindless_allocator staging;
+	staging.initialize(0, 1);
+	const bindless_handle old_view = staging.allocate();
+	staging.free(old_view, 1);
+	staging.collect(1);
+	const bindless_handle new_view = staging.allocate();
+	CHECK(new_view.slot() == old_view.slot());
+	CHECK(new_view != old_view);
+
+	descriptor_table_cache cache;
+	const bindless_handle  before[] = {old_view};
+	const bindless_handle  after[]  = {new_view};
+	store(cache, before, 7);
+	uint32_t index = 0;
+	CHECK(!lookup(cache, after, &index));
+	CHECK(lookup(cache, before, &index) && index == 7);
+}
+
+TEST_CASE(reset_clears_entries_and_stats)
+{
+	descriptor_table_cache cache;
+	const bindless_handle  table[] = {handle(1, 4)};
+	uint32_t               index   = 0;
+	store(cache, table, 1);
+	lookup(cache, table, &index);
+	lookup(cache, {}, &index);
+	CHECK(cache.size() == 1);
+	CHECK(cache.hits() == 1 && cache.misses() == 1);
+
+	cache.reset();
+	CHECK(cache.size() == 0);
+	CHECK(cache.hits() == 0 && cache.misses() == 0);
+	CHECK(!lookup(cache, table, &index));
+
+	// reset 뒤에 넣은 것은 새 index 로
+	store(cache, table, 2);
+	CHECK(lookup(cache, table, &index) && index == 2);
+}
@@ -0,0 +1,338 @@
+#include "test.h"
+#include <emt/graphics/dxbc_container.h>
+#include <emt/graphics/shader_reflection.h>
+#include <string>
+
+using namespace emt;
+
+// compiler 없이 만든 container : header, part table, part 순서로 붙임
+static void put_u32(std::vector<uint8_t>* out, uint32_t v)
+{
+	const uint8_t* p = reinterpret_cast<const uint8_t*>(&v);
+	out->insert(out->end(), p, p + 4);
+}
+
+static void set_u32(std::vector<uint8_t>* out, size_t offset, uint32_t v)
+{
+	memcpy(out->data() + offset, &v, 4);
+}
+
+struct test_part
+{
+	uint32_t             fourcc;
+	std::vector<uint8_t> data;
+};
+
+static std::vector<uint8_t> make_container(const std::vector<test_part>& parts, uint8_t digest_fill = 0)
+{
+	std::vector<uint8_t> out;
+	put_u32(&out, dxbc::container);
+	out.insert(out.end(), dxbc::digest_size, digest_fill);
+	put_u32(&out, 1);        // major 1, minor 0
+	put_u32(&out, 0);        // total : 마지막에 채움
+	put_u32(&out, uint32_t(parts.size()));
+	const size_t table = out.size();
+	out.resize(table + parts.size() * 4);
+	for(size_t i = 0; i < parts.size(); ++i) {
+		set_u32(&out, table + i * 4, uint32_t(out.size()));
+		put_u32(&out, parts[i].fourcc);
+		put_u32(&out, uint32_t(parts[i].data.size()));
+		out.insert(out.end(), parts[i].data.begin(), parts[i].data.end());
+	}
+	set_u32(&out, 24, uint32_t(out.size()));
+	return out;
+}
+
+// DXIL part : program header + bitcode
+static std::vector<uint8_t> make_program(uint32_t version, uint32_t dxil_version, const std::vector<uint8_t>& bitcode)
+{
+	std::vector<uint8_t> out;
+	put_u32(&out, version);
+	put_u32(&out, uint32_t(24 + bitcode.size()) / 4);
+	put_u32(&out, dxbc::dxil);
+	put_u32(&out, dxil_version);
+	put_u32(&out, 16);        // "DXIL" 기준 : bitcode 는 header 바로 뒤
+	put_u32(&out, uint32_t(bitcode.size()));
+	out.insert(out.end(), bitcode.begin(), bitcode.end());
+	return out;
+}
+
+struct test_element
+{
+	const char* semantic;
+	uint32_t    semantic_index;
+	uint32_t    system_value;
+	uint32_t    component_type;
+	uint32_t    register_index;
+	uint8_t     mask;
+	uint8_t     rw_mask;
+	uint32_t    stream;
+	uint32_t    min_precision;
+};
+
+// stride 32 : ISG1 (stream, min precision 포함), 24 : ISGN
+static std::vector<uint8_t> make_signature(uint32_t stride, const std::vector<test_element>& elements)
+{
+	std::vector<uint8_t> out;
+	put_u32(&out, uint32_t(elements.size()));
+	put_u32(&out, 8);
+	const size_t names = 8 + elements.size() * stride;
+	std::string  strings;
+	for(const test_element& e : elements) {
+		if(stride == 32)
+			put_u32(&out, e.stream);
+		put_u32(&out, uint32_t(names + strings.size()));
+		strings.append(e.semantic).push_back('\0');
+		put_u32(&out, e.semantic_index);
+		put_u32(&out, e.system_value);
+		put_u32(&out, e.component_type);
+		put_u32(&out, e.register_index);
+		out.push_back(e.mask);
+		out.push_back(e.rw_mask);
+		out.push_back(0);
+		out.push_back(0);
+		if(stride == 32)
+			put_u32(&out, e.min_precision);
+	}
+	out.insert(out.end(), strings.begin(), strings.end());
+	return out;
+}
+
+static const std::vector<test_element> k_inputs = {
+    {"POSITION", 0, 0, 3, 0, 0x7, 0x7, 0, 0},
+    {"TEXCOORD", 1, 0, 3, 1, 0x3, 0x3, 0, 1},
+    {"BLENDINDICES", 0, 0, 1, 2, 0xf, 0xf, 0, 0},
+    {"SV_VertexID", 0, 6, 1, 3, 0x1, 0x1, 0, 0},
+};
+
+TEST_CASE(parse_rejects_malformed_headers)
+{
+	const std::vector<uint8_t> good = make_container({{dxbc::stat, {1, 2, 3, 4}}, {dxbc::ildb, {}}});
+	dxbc_container             c;
+	CHECK(c.parse(good.data(), good.size()) == nullptr);
+	CHECK(c.valid());
+	CHECK(c.part_count() == 2);
+	CHECK(c.bytes().size() == good.size());
+
+	// 잘린 입력 : header 보다 작거나 total size 보다 작음
+	CHECK(c.parse(nullptr, 0) != nullptr);
+	CHECK(!c.valid());
+	CHECK(c.parse(good.data(), dxbc::header_size - 1) != nullptr);
+	CHECK(c.parse(good.data(), good.size() - 1) != nullptr);
+
+	std::vector<uint8_t> magic = good;
+	magic[0]                   = 'X';
+	CHECK(c.parse(magic.data(), magic.size()) != nullptr);
+
+	std::vector<uint8_t> small = good;
+	set_u32(&small, 24, uint32_t(dxbc::header_size - 1));
+	CHECK(c.parse(small.data(), small.size()) != nullptr);
+
+	// part table 이 total 을 넘음
+	std::vector<uint8_t> count = good;
+	set_u32(&count, 28, 1000);
+	CHECK(c.parse(count.data(), count.size()) != nullptr);
+
+	// 뒤에 남는 byte 는 container 밖 : total 까지만 봄
+	std::vector<uint8_t> trailing = good;
+	trailing.push_back(0xee);
+	CHECK(c.parse(trailing.data(), trailing.size()) == nullptr);
+	CHECK(c.bytes().size() == good.size());
+}
+
+TEST_CASE(parse_rejects_bad_part_offsets_and_sizes)
+{
+	const std::vector<uint8_t> good  = make_container({{dxbc::stat, {1, 2, 3, 4}}, {dxbc::ildb, {5, 6}}});
+	const size_t               table = dxbc::header_size;
+	dxbc_container             c;
+
+	// part table 안을 가리킴
+	std::vector<uint8_t> inside = good;
+	set_u32(&inside, table + 4, uint32_t(table));
+	CHECK(c.parse(inside.data(), inside.size()) != nullptr);
+
+	// part header (8 byte) 가 total 을 넘음
+	std::vector<uint8_t> past = good;
+	set_u32(&past, table + 4, uint32_t(good.size() - 7));
+	CHECK(c.parse(past.data(), past.size()) != nullptr);
+	set_u32(&past, table + 4, ~0u);
+	CHECK(c.parse(past.data(), past.size()) != nullptr);
+
+	// 마지막 part 의 size 가 total 을 넘음
+	uint32_t last = 0;
+	memcpy(&last, good.data() + table + 4, 4);
+	std::vector<uint8_t> size = good;
+	set_u32(&size, last + 4, 3);
+	CHECK(c.parse(size.data(), size.size()) != nullptr);
+	set_u32(&size, last + 4, ~0u);
+	CHECK(c.parse(size.data(), size.size()) != nullptr);
+	set_u32(&size, last + 4, 2);
+	CHECK(c.parse(size.data(), size.size()) == nullptr);
+}
+
+TEST_CASE(parts_are_found_and_iterated_in_place)
+{
+	const std::vector<uint8_t> bitcode = {0x42, 0x43, 0xc0, 0xde, 1, 2, 3, 4};
+	std::vector<uint8_t>       hash(4 + dxbc::digest_size);
+	set_u32(&hash, 0, 1);
+	for(size_t i = 0; i < dxbc::digest_size; ++i)
+		hash[4 + i] = uint8_t(0xa0 + i);
+	const uint32_t             version = (1u << 16) | (6u << 4) | 6u;        // vs_6_6
+	const std::vector<uint8_t> dxil    = make_program(version, 0x106, bitcode);
+	const std::vector<uint8_t> bytes   = make_container({{dxbc::hash, hash}, {dxbc::dxil, dxil}, {dxbc::psv0, {9}}}, 0x11);
+
+	dxbc_container c;
+	CHECK(c.parse(bytes.data(), bytes.size()) == nullptr);
+	CHECK(c.signed_digest());
+	CHECK(c.digest().data() == bytes.data() + 4);
+
+	uint32_t              count = 0;
+	std::vector<uint32_t> fourccs;
+	for(dxbc_part p : c) {
+		fourccs.push_back(p.fourcc);
+		CHECK(p.data.data() >= bytes.data() && p.data.data() + p.data.size() <= bytes.data() + bytes.size());
+		++count;
+	}
+	CHECK(count == 3);
+	CHECK(fourccs == std::vector<uint32_t>({dxbc::hash, dxbc::dxil, dxbc::psv0}));
+
+	dxbc_part part;
+	CHECK(c.find(dxbc::psv0, &part));
+	CHECK(part.data.size() == 1 && part.data[0] == 9);
+	CHECK(!c.find(dxbc::rdat, &part));
+
+	std::span<const uint8_t> digest;
+	bool                     includes_source = false;
+	CHECK(c.shader_hash(&digest, &includes_source));
+	CHECK(includes_source);
+	CHECK(digest.size() == dxbc::digest_size && digest[0] == 0xa0 && digest[15] == 0xaf);
+
+	dxbc_program program;
+	CHECK(c.program(&program));
+	CHECK(program.version == version);
+	CHECK(program.dxil_version == 0x106);
+	CHECK(std::vector<uint8_t>(program.bitcode.begin(), program.bitcode.end()) == bitcode);
+	shader_stage stage{};
+	CHECK(dxbc::program_stage(dxbc::program_type(program.version), &stage) && stage == shader_stage::vertex);
+	CHECK(dxbc::program_major(program.version) == 6 && dxbc::program_minor(program.version) == 6);
+}
+
+TEST_CASE(missing_or_short_parts_are_reported)
+{
+	const std::vector<uint8_t> unsigned_bytes = make_container({{dxbc::hash, {1, 0, 0, 0}}});
+	dxbc_container             c;
+	CHECK(c.parse(unsigned_bytes.data(), unsigned_bytes.size()) == nullptr);
+	CHECK(!c.signed_digest());
+
+	// HASH 는 digest 가 다 들어있어야, DXIL 이 없으면 program 없음
+	std::span<const uint8_t> digest;
+	dxbc_program             program;
+	CHECK(!c.shader_hash(&digest));
+	CHECK(!c.program(&program));
+
+	// bitcode 가 part 밖을 가리킴
+	std::vector<uint8_t> dxil = make_program(0, 0x100, {1, 2, 3, 4});
+	set_u32(&dxil, 20, 5);
+	const std::vector<uint8_t> bad = make_container({{dxbc::dxil, dxil}});
+	CHECK(c.parse(bad.data(), bad.size()) == nullptr);
+	CHECK(!c.program(&program));
+
+	std::vector<uint8_t> magic = make_program(0, 0x100, {});
+	set_u32(&magic, 8, dxbc::shex);
+	const std::vector<uint8_t> not_dxil = make_container({{dxbc::dxil, magic}});
+	CHECK(c.parse(not_dxil.data(), not_dxil.size()) == nullptr);
+	CHECK(!c.program(&program));
+}
+
+TEST_CASE(signature_reads_isg1_and_isgn_layouts)
+{
+	for(uint32_t stride : {32u, 24u}) {
+		const std::vector<uint8_t> data = make_signature(stride, k_inputs);
+		dxbc_signature             signature;
+		CHECK(signature.parse({stride == 32 ? dxbc::isg1 : dxbc::isgn, data}));
+		CHECK(signature.size() == uint32_t(k_inputs.size()));
+		for(uint32_t i = 0; i < signature.size(); ++i) {
+			dxbc_signature_element e;
+			CHECK(signature.element(i, &e));
+			CHECK(e.semantic == k_inputs[i].semantic);
+			CHECK(e.semantic_index == k_inputs[i].semantic_index);
+			CHECK(e.system_value == k_inputs[i].system_value);
+			CHECK(e.component_type == k_inputs[i].component_type);
+			CHECK(e.register_index == k_inputs[i].register_index);
+			CHECK(e.mask == k_inputs[i].mask);
+			CHECK(e.rw_mask == k_inputs[i].rw_mask);
+			// ISGN 에는 없는 field
+			CHECK(e.min_precision == (stride == 32 ? k_inputs[i].min_precision : 0));
+		}
+	}
+
+	// signature 가 아닌 part, element 수가 part 를 넘음
+	const std::vector<uint8_t> data = make_signature(24, k_inputs);
+	dxbc_signature             signature;
+	CHECK(!signature.parse({dxbc::psv0, data}));
+	CHECK(!signature.parse({dxbc::isgn, std::span<const uint8_t>(data.data(), 8 + k_inputs.size() * 24 - 1)}));
+	CHECK(!signature.parse({dxbc::isgn, std::span<const uint8_t>(data.data(), 4)}));
+	std::vector<uint8_t> offset = data;
+	set_u32(&offset, 4, uint32_t(data.size() + 1));
+	CHECK(!signature.parse({dxbc::isgn, offset}));
+}
+
+TEST_CASE(signature_rejects_bad_semantic_names)
+{
+	std::vector<uint8_t> data = make_signature(32, k_inputs);
+	dxbc_signature       signature;
+	CHECK(signature.parse({dxbc::isg1, data}));
+
+	// element 0 의 이름 offset (stream 다음) 을 part 밖으로
+	std::vector<uint8_t> outside = data;
+	set_u32(&outside, 8 + 4, uint32_t(data.size()));
+	CHECK(signature.parse({dxbc::isg1, outside}));
+	dxbc_signature_element e;
+	CHECK(!signature.element(0, &e));
+	set_u32(&outside, 8 + 4, ~0u);
+	CHECK(!signature.element(0, &e));
+	CHECK(signature.element(1, &e) && e.semantic == "TEXCOORD");
+
+	// 끝의 NUL 이 잘린 이름
+	std::vector<uint8_t> unterminated = data;
+	unterminated.pop_back();
+	CHECK(signature.parse({dxbc::isg1, unterminated}));
+	CHECK(!signature.element(uint32_t(k_inputs.size() - 1), &e));
+}
+
+TEST_CASE(read_input_signature_maps_vertex_inputs)
+{
+	const std::vector<uint8_t> bytes = make_container({{dxbc::isg1, make_signature(32, k_inputs)}});
+	dxbc_container             c;
+	CHECK(c.parse(bytes.data(), bytes.size()) == nullptr);
+
+	std::vector<shader_input> inputs;
+	CHECK(read_input_signature(c, &inputs));
+	CHECK(inputs.size() == 4);
+	if(inputs.size() == 4) {
+		CHECK(inputs[0].semantic == "POSITION" && inputs[0].components == 3);
+		CHECK(inputs[0].component == shader_component::float32 && !inputs[0].system_value);
+		CHECK(inputs[1].semantic_index == 1 && inputs[1].components == 2);
+		CHECK(inputs[2].component == shader_component::uint32 && inputs[2].components == 4);
+		CHECK(inputs[3].semantic == "SV_VertexID" && inputs[3].system_value);
+	}
+
+	// SM 5 의 ISGN 도 같은 결과
+	const std::vector<uint8_t> legacy = make_container({{dxbc::isgn, make_signature(24, k_inputs)}});
+	std::vector<shader_input>  legacy_inputs;
+	CHECK(c.parse(legacy.data(), legacy.size()) == nullptr);
+	CHECK(read_input_signature(c, &legacy_inputs));
+	CHECK(legacy_inputs.size() == inputs.size());
+
+	// signature 가 없거나 이름이 깨지면 false
+	const std::vector<uint8_t> none = make_container({{dxbc::psv0, {}}});
+	CHECK(c.parse(none.data(), none.size()) == nullptr);
+	CHECK(!read_input_signature(c, &inputs));
+	CHECK(inputs.empty());
+
+	std::vector<uint8_t> broken = make_signature(32, k_inputs);
+	set_u32(&broken, 8 + 4, uint32_t(broken.size() + 100));
+	const std::vector<uint8_t> bad = make_container({{dxbc::isg1, broken}});
+	CHECK(c.parse(bad.data(), bad.size()) == nullptr);
+	CHECK(!read_input_signature(c, &inputs));
+}
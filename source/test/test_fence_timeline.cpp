@@ -0,0 +1,137 @@
+#include "test.h"
+#include <emt/graphics/fence_timeline.h>
+
+using namespace emt;
+
+// gpu 흉내 : signal 된 값을 submit 순서대로 하나씩 끝냄
+struct simulated_gpu
+{
+	fence_timeline* timeline;
+	uint64_t        reached = 0;
+
+	// n 개의 signal 을 더 끝내고 timeline 에 알림
+	uint32_t advance(uint64_t n)
+	{
+		const uint64_t remaining = timeline->last_signaled() - reached;
+		reached += std::min(n, remaining);
+		return timeline->update(reached);
+	}
+};
+
+TEST_CASE(values_start_at_one)
+{
+	fence_timeline t;
+	CHECK(t.next_value() == 1);
+	CHECK(t.last_signaled() == 0);
+	CHECK(t.completed() == 0);
+	CHECK(t.is_complete(0));
+	CHECK(!t.is_complete(1));
+}
+
+TEST_CASE(signal_advances_next_value)
+{
+	fence_timeline t;
+	CHECK(t.signal() == 1);
+	CHECK(t.signal() == 2);
+	CHECK(t.next_value() == 3);
+	CHECK(t.last_signaled() == 2);
+	CHECK(t.completed() == 0);
+}
+
+TEST_CASE(update_is_monotonic_and_clamped)
+{
+	fence_timeline t;
+	t.signal();
+	t.signal();
+	t.update(2);
+	CHECK(t.completed() == 2);
+	// 뒤로 가지 않음
+	t.update(1);
+	CHECK(t.completed() == 2);
+	// signal 하지 않은 값은 last_signaled 로 clamp
+	t.signal();
+	t.update(100);
+	CHECK(t.completed() == 3);
+	CHECK(t.is_complete(3));
+	CHECK(!t.is_complete(4));
+}
+
+TEST_CASE(callbacks_run_in_value_order)
+{
+	fence_timeline   t;
+	std::vector<int> order;
+	for(int i = 0; i < 3; ++i)
+		t.signal();
+	t.on_complete(3, [&] { order.push_back(3); });
+	t.on_complete(1, [&] { order.push_back(1); });
+	t.on_complete(2, [&] { order.push_back(2); });
+	// 같은 값은 등록 순서대로
+	t.on_complete(1, [&] { order.push_back(10); });
+	CHECK(t.pending_callbacks() == 4);
+
+	CHECK(t.update(1) == 2);
+	CHECK(order == (std::vector<int>{1, 10}));
+	CHECK(t.update(3) == 2);
+	CHECK(order == (std::vector<int>{1, 10, 2, 3}));
+	CHECK(t.pending_callbacks() == 0);
+}
+
+TEST_CASE(callback_on_completed_value_runs_immediately)
+{
+	fence_timeline t;
+	t.signal();
+	t.update(1);
+	bool ran = false;
+	t.on_complete(1, [&] { ran = true; });
+	CHECK(ran);
+	CHECK(t.pending_callbacks() == 0);
+}
+
+TEST_CASE(callback_may_register_more_callbacks)
+{
+	fence_timeline   t;
+	std::vector<int> order;
+	t.signal();
+	t.signal();
+	t.on_complete(1, [&] {
+		order.push_back(1);
+		// 이미 끝난 값 : 바로 실행, 아직인 값 : 대기
+		t.on_complete(1, [&] { order.push_back(11); });
+		t.on_complete(2, [&] { order.push_back(2); });
+	});
+	t.update(1);
+	CHECK(order == (std::vector<int>{1, 11}));
+	t.update(2);
+	CHECK(order == (std::vector<int>{1, 11, 2}));
+}
+
+TEST_CASE(simulated_frames_in_flight)
+{
+	// 3 frame in flight : frame 마다 signal, gpu 는 2 frame 늦게 따라옴
+	fence_timeline   t;
+	simulated_gpu    gpu{&t};
+	std::vector<int> retired;
+	const uint64_t   frames_in_flight = 3;
+	uint64_t         frame_values[3]{};
+
+	for(int frame = 0; frame < 20; ++frame) {
+		const uint64_t slot = frame % frames_in_flight;
+		// slot 을 다시 쓰기 전에 그 slot 의 마지막 값까지 끝나야 함
+		while(!t.is_complete(frame_values[slot]))
+			gpu.advance(1);
+		CHECK(t.completed() >= frame_values[slot]);
+
+		const uint64_t value = t.next_value();
+		t.on_complete(value, [&retired, frame] { retired.push_back(frame); });
+		frame_values[slot] = t.signal();
+		CHECK(frame_values[slot] == value);
+		CHECK(t.last_signaled() - t.completed() <= frames_in_flight);
+
+		if(frame % 2)
+			gpu.advance(1);
+	}
+	gpu.advance(~0ull);
+	CHECK(retired.size() == 20);
+	for(size_t i = 0; i < retired.size(); ++i)
+		CHECK(retired[i] == int(i));
+}
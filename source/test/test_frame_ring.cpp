@@ -0,0 +1,134 @@
+#include "test.h"
+#include <emt/graphics/frame_ring.h>
+#include <emt/graphics/fence_timeline.h>
+
+using namespace emt;
+
+// payload 는 id 만, release 된 순서를 기록
+struct released_ids
+{
+	std::vector<int> ids;
+	void             operator()(int id) { ids.push_back(id); }
+};
+
+static frame_ring<int> make_ring(int count)
+{
+	frame_ring<int> ring;
+	for(int i = 0; i < count; ++i)
+		ring.push(i);
+	return ring;
+}
+
+TEST_CASE(advance_walks_slots_in_push_order)
+{
+	frame_ring<int> ring = make_ring(3);
+	CHECK(ring.size() == 3);
+	CHECK(ring.index() == 0);
+	CHECK(ring.wait_value() == 0);        // 새 slot 은 기다릴 것이 없음
+
+	ring.advance(1);
+	CHECK(ring.index() == 1);
+	CHECK(ring.current().payload == 1);
+	ring.advance(2);
+	ring.advance(3);
+	// 한 바퀴 돌아 slot 0 : 마지막 submit 값을 기다림
+	CHECK(ring.index() == 0);
+	CHECK(ring.current().payload == 0);
+	CHECK(ring.wait_value() == 1);
+	ring.advance(4);
+	CHECK(ring.wait_value() == 2);
+	CHECK(ring.at(0).fence_value == 4);
+}
+
+TEST_CASE(grown_slots_start_retired)
+{
+	frame_ring<int> ring = make_ring(2);
+	ring.advance(1);
+	ring.advance(2);
+
+	// wait_idle 없이 늘림 : 새 slot 은 fence 0, 기존 slot 은 값 유지
+	ring.push(2);
+	CHECK(ring.size() == 3);
+	CHECK(ring.index() == 0);
+	CHECK(ring.wait_value() == 1);
+	ring.advance(3);
+	ring.advance(4);
+	CHECK(ring.current().payload == 2);
+	CHECK(ring.wait_value() == 0);
+	ring.advance(5);
+	CHECK(ring.index() == 0);
+	CHECK(ring.wait_value() == 3);
+}
+
+TEST_CASE(shrunk_slots_wait_for_their_last_fence)
+{
+	fence_timeline  timeline;
+	frame_ring<int> ring = make_ring(4);
+	for(int i = 0; i < 4; ++i)
+		ring.advance(timeline.signal());        // slot i -> value i + 1
+	ring.advance(timeline.signal());            // slot 0 -> 5
+	CHECK(ring.index() == 1);
+
+	// slot 2, 3 은 value 3, 4 에 묶여 parked, 현재 index 는 남은 범위 안
+	ring.shrink(2);
+	CHECK(ring.size() == 2);
+	CHECK(ring.retired_count() == 2);
+	CHECK(ring.index() == 1);
+
+	released_ids released;
+	ring.collect_retired(timeline.completed(), released);
+	CHECK(released.ids.empty());
+
+	timeline.update(3);
+	ring.collect_retired(timeline.completed(), released);
+	CHECK(released.ids.size() == 1 && released.ids[0] == 2);
+	CHECK(ring.retired_count() == 1);
+
+	timeline.update(4);
+	ring.collect_retired(timeline.completed(), released);
+	CHECK(released.ids.size() == 2 && released.ids[1] == 3);
+	CHECK(ring.retired_count() == 0);
+
+	// 남은 slot 은 그대로 돌아감
+	ring.advance(timeline.signal());
+	CHECK(ring.index() == 0);
+	CHECK(ring.wait_value() == 5);
+}
+
+TEST_CASE(shrink_past_the_index_restarts_at_zero)
+{
+	frame_ring<int> ring = make_ring(3);
+	ring.advance(1);
+	ring.advance(2);
+	CHECK(ring.index() == 2);
+	ring.shrink(1);
+	CHECK(ring.index() == 0);
+	CHECK(ring.wait_value() == 1);
+
+	// 0 이나 현재 이상의 크기는 무시
+	ring.shrink(0);
+	ring.shrink(5);
+	CHECK(ring.size() == 1);
+	CHECK(ring.retired_count() == 2);
+}
+
+TEST_CASE(clear_releases_live_and_parked_slots)
+{
+	frame_ring<int> ring = make_ring(3);
+	ring.advance(1);
+	ring.advance(2);
+	ring.advance(3);
+	ring.shrink(1);
+
+	released_ids released;
+	ring.clear(released);
+	CHECK(released.ids.size() == 3);
+	CHECK(ring.empty());
+	CHECK(ring.retired_count() == 0);
+	CHECK(ring.index() == 0);
+
+	// clear 뒤에 다시 채워 쓸 수 있음
+	ring.push(7);
+	CHECK(ring.current().payload == 7);
+	CHECK(ring.wait_value() == 0);
+}
@@ -0,0 +1,63 @@
+#include "test.h"
+#include <emt/engine/job_system.h>
+#include <atomic>
+
+using namespace emt;
+
+TEST_CASE(job_system_runs_every_job)
+{
+	job_system            jobs(3);
+	job_counter           counter;
+	std::atomic<uint32_t> sum{0};
+	for(uint32_t i = 1; i <= 1000; ++i) {
+		jobs.spawn([&sum, i]() { sum.fetch_add(i); }, &counter);
+	}
+	jobs.wait(&counter);
+	CHECK(counter.done());
+	CHECK(sum.load() == 500500);
+}
+
+TEST_CASE(job_system_continuation_after_dependency)
+{
+	job_system            jobs(2);
+	job_counter           first;
+	job_counter           second;
+	std::atomic<uint32_t> done_first{0};
+	std::atomic<bool>     ordered{true};
+	for(uint32_t i = 0; i < 64; ++i) {
+		jobs.spawn([&done_first]() { done_first.fetch_add(1); }, &first);
+	}
+	jobs.spawn_after(&first, [&]() { ordered = done_first.load() == 64; }, &second);
+	jobs.wait(&second);
+	CHECK(ordered.load());
+}
+
+TEST_CASE(job_system_nested_parallel_for)
+{
+	job_system            jobs(3);
+	std::atomic<uint32_t> count{0};
+	jobs.parallel_for(64, 4, [&](uint32_t begin, uint32_t end) {
+		for(uint32_t i = begin; i < end; ++i) {
+			jobs.parallel_for(16, 1, [&](uint32_t b, uint32_t e) { count.fetch_add(e - b); });
+		}
+	});
+	CHECK(count.load() == 64 * 16);
+}
+
+TEST_CASE(job_system_destructor_drains_queues)
+{
+	// wait 없이 파괴 : 남은 job 과 continuation 이 모두 실행되어야 함
+	job_counter           counter;
+	job_counter           after;
+	std::atomic<uint32_t> ran{0};
+	{
+		job_system jobs(2);
+		for(uint32_t i = 0; i < 3000; ++i) {
+			jobs.spawn([&ran]() { ran.fetch_add(1); }, &counter);
+		}
+		jobs.spawn_after(&counter, [&ran]() { ran.fetch_add(1); }, &after);
+	}
+	CHECK(ran.load() == 3001);
+	CHECK(counter.done());
+	CHECK(after.done());
+}
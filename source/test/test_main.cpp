@@ -0,0 +1,38 @@
+#include "test.h"
+
+namespace emt::test
+{
+static int s_failures = 0;
+
+std::vector<test_case>& registry()
+{
+	static std::vector<test_case> cases;
+	return cases;
+}
+
+void report(const char* expr, const char* file, int line)
+{
+	std::printf("  FAILED %s (%s:%d)\n", expr, file, line);
+	++s_failures;
+}
+}        // namespace emt::test
+
+int main(int argc, char** argv)
+{
+	const char* filter = argc > 1 ? argv[1] : nullptr;
+	int         run    = 0;
+	int         failed = 0;
+	for(const emt::test::test_case& c : emt::test::registry()) {
+		if(filter && !strstr(c.name, filter))
+			continue;
+		const int before = emt::test::s_failures;
+		std::printf("[ RUN  ] %s\n", c.name);
+		c.function();
+		const bool ok = emt::test::s_failures == before;
+		std::printf("[ %s ] %s\n", ok ? " OK " : "FAIL", c.name);
+		++run;
+		failed += ok ? 0 : 1;
+	}
+	std::printf("%d test(s), %d failed\n", run, failed);
+	return failed ? 1 : 0;
+}
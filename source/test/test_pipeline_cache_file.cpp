@@ -0,0 +1,194 @@
+#include "test.h"
+#include <emt/graphics/pipeline_cache_file.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace emt;
+
+static const uint64_t k_identity = 0x1234abcd5678ef00ull;
+
+static std::vector<uint8_t> sample_payload(size_t size)
+{
+	std::vector<uint8_t> payload(size);
+	for(size_t i = 0; i < size; ++i) {
+		payload[i] = uint8_t(i * 31 + 7);
+	}
+	return payload;
+}
+
+static const char* unpack(const std::vector<uint8_t>& data, uint64_t identity, std::vector<uint8_t>* payload = nullptr)
+{
+	const uint8_t* p{};
+	size_t         size{};
+	const char*    error = unpack_pipeline_cache(data.data(), data.size(), identity, &p, &size);
+	if(!error && payload)
+		payload->assign(p, p + size);
+	if(error)
+		CHECK(p == nullptr && size == 0);
+	return error;
+}
+
+static pipeline_cache_header& header_of(std::vector<uint8_t>& data)
+{
+	return *reinterpret_cast<pipeline_cache_header*>(data.data());
+}
+
+TEST_CASE(pipeline_cache_round_trip)
+{
+	for(size_t size : {size_t(0), size_t(1), size_t(4096)}) {
+		const std::vector<uint8_t> payload = sample_payload(size);
+		std::vector<uint8_t>       data;
+		pack_pipeline_cache(k_identity, payload.data(), payload.size(), &data);
+		CHECK(data.size() == sizeof(pipeline_cache_header) + size);
+
+		std::vector<uint8_t> out;
+		CHECK(unpack(data, k_identity, &out) == nullptr);
+		CHECK(out == payload);
+	}
+}
+
+TEST_CASE(pipeline_cache_rejects_mismatches)
+{
+	const std::vector<uint8_t> payload = sample_payload(256);
+	std::vector<uint8_t>       data;
+	pack_pipeline_cache(k_identity, payload.data(), payload.size(), &data);
+
+	// adapter / driver 가 바뀜
+	CHECK(unpack(data, k_identity + 1) != nullptr);
+
+	std::vector<uint8_t> version = data;
+	header_of(version).version   = pipeline_cache_version + 1;
+	CHECK(unpack(version, k_identity) != nullptr);
+
+	std::vector<uint8_t> magic = data;
+	header_of(magic).magic     = 0;
+	CHECK(unpack(magic, k_identity) != nullptr);
+}
+
+TEST_CASE(pipeline_cache_rejects_corruption)
+{
+	const std::vector<uint8_t> payload = sample_payload(256);
+	std::vector<uint8_t>       data;
+	pack_pipeline_cache(k_identity, payload.data(), payload.size(), &data);
+
+	// payload 의 어느 byte 가 바뀌어도 hash 로 거름
+	for(size_t i = sizeof(pipeline_cache_header); i < data.size(); i += 37) {
+		std::vector<uint8_t> corrupted = data;
+		corrupted[i] ^= 0x40;
+		CHECK(unpack(corrupted, k_identity) != nullptr);
+	}
+
+	std::vector<uint8_t> truncated = data;
+	truncated.pop_back();
+	CHECK(unpack(truncated, k_identity) != nullptr);
+
+	std::vector<uint8_t> extended = data;
+	extended.push_back(0);
+	CHECK(unpack(extended, k_identity) != nullptr);
+
+	std::vector<uint8_t> header_only(data.begin(), data.begin() + sizeof(pipeline_cache_header) - 1);
+	CHECK(unpack(header_only, k_identity) != nullptr);
+	CHECK(unpack({}, k_identity) != nullptr);
+}
+
+TEST_CASE(pipeline_cache_file_save_and_load)
+{
+	const std::filesystem::path dir  = std::filesystem::temp_directory_path() / "emt_test_pipeline_cache";
+	const std::string           path = (dir / "nested" / "cache.bin").string();
+	std::error_code             ec;
+	std::filesystem::remove_all(dir, ec);
+
+	std::vector<uint8_t> loaded = sample_payload(3);
+	CHECK(!load_pipeline_cache(path.c_str(), k_identity, &loaded));
+	CHECK(loaded.empty());
+
+	// 없는 directory 도 만들어 저장, 임시 파일은 남지 않음
+	const std::vector<uint8_t> payload = sample_payload(1000);
+	CHECK(save_pipeline_cache(path.c_str(), k_identity, payload.data(), payload.size()));
+	CHECK(load_pipeline_cache(path.c_str(), k_identity, &loaded));
+	CHECK(loaded == payload);
+	uint32_t files = 0;
+	for(const auto& entry : std::filesystem::directory_iterator(dir / "nested")) {
+		(void)entry;
+		++files;
+	}
+	CHECK(files == 1);
+
+	// 다른 identity 로는 읽지 않음
+	CHECK(!load_pipeline_cache(path.c_str(), k_identity ^ 1, &loaded));
+	CHECK(loaded.empty());
+
+	// 덮어쓰기
+	const std::vector<uint8_t> smaller = sample_payload(10);
+	CHECK(save_pipeline_cache(path.c_str(), k_identity, smaller.data(), smaller.size()));
+	CHECK(load_pipeline_cache(path.c_str(), k_identity, &loaded));
+	CHECK(loaded == smaller);
+
+	// 디스크에서 깨진 파일
+	{
+		std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(sizeof(pipeline_cache_header) + 2);
+		file.put(char(0x7f));
+	}
+	CHECK(!load_pipeline_cache(path.c_str(), k_identity, &loaded));
+	CHECK(loaded.empty());
+
+	std::filesystem::remove_all(dir, ec);
+}
+
+TEST_CASE(blob_table_round_trip_is_deterministic)
+{
+	blob_table blobs;
+	blobs[42]    = sample_payload(17);
+	blobs[7]     = sample_payload(0);
+	blobs[~0ull] = sample_payload(300);
+
+	// 삽입 순서가 달라도 같은 byte
+	blob_table shuffled;
+	shuffled[~0ull] = blobs[~0ull];
+	shuffled[42]    = blobs[42];
+	shuffled[7]     = blobs[7];
+
+	std::vector<uint8_t> a;
+	std::vector<uint8_t> b;
+	pack_blob_table(blobs, &a);
+	pack_blob_table(shuffled, &b);
+	CHECK(a == b);
+
+	blob_table out;
+	CHECK(unpack_blob_table(a.data(), a.size(), &out));
+	CHECK(out == blobs);
+
+	// 빈 table
+	std::vector<uint8_t> empty;
+	pack_blob_table({}, &empty);
+	CHECK(unpack_blob_table(empty.data(), empty.size(), &out));
+	CHECK(out.empty());
+}
+
+TEST_CASE(blob_table_rejects_truncation_and_trailing_bytes)
+{
+	blob_table blobs;
+	blobs[1] = sample_payload(64);
+	blobs[2] = sample_payload(8);
+	std::vector<uint8_t> data;
+	pack_blob_table(blobs, &data);
+
+	blob_table kept;
+	kept[99] = sample_payload(1);
+	for(size_t size = 0; size < data.size(); ++size) {
+		blob_table out = kept;
+		CHECK(!unpack_blob_table(data.data(), size, &out));
+		// 실패하면 건드리지 않음
+		CHECK(out == kept);
+	}
+	data.push_back(0);
+	CHECK(!unpack_blob_table(data.data(), data.size(), &kept));
+
+	// 크기가 남은 byte 보다 큰 blob
+	std::vector<uint8_t> huge;
+	pack_blob_table(blobs, &huge);
+	uint64_t size = ~0ull;
+	memcpy(huge.data() + sizeof(uint64_t) * 2, &size, sizeof(size));
+	CHECK(!unpack_blob_table(huge.data(), huge.size(), &kept));
+}
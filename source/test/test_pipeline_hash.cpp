@@ -0,0 +1,189 @@
+#include "test.h"
+#include <emt/graphics/dx/dx_pipeline_cache.h>
+#include <emt/graphics/dxbc_container.h>
+#include <string>
+
+using namespace emt;
+
+// dx_pipeline_cache::hash 는 device 없이 계산 : desc 가 가리키는 내용만 key 에 들어가야 함
+static const uint64_t k_root_signature = 0x5151515151515151ull;
+
+// desc 와 desc 가 가리키는 배열 / 문자열을 함께 소유 (instance 마다 다른 주소)
+struct pipeline_desc
+{
+	std::string                             semantics[2] = {"POSITION", "TEXCOORD"};
+	std::vector<uint8_t>                    vs           = {0x10, 0x20, 0x30, 0x40, 0x50};
+	std::vector<uint8_t>                    ps           = {0x60, 0x70, 0x80};
+	std::vector<D3D12_INPUT_ELEMENT_DESC>   elements;
+	std::vector<D3D12_SO_DECLARATION_ENTRY> so_entries;
+	std::vector<UINT>                       so_strides = {16};
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC      desc{};
+
+	pipeline_desc()
+	{
+		elements = {
+		    {semantics[0].c_str(), 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+		    {semantics[1].c_str(), 0, DXGI_FORMAT_R32G32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+		};
+		so_entries = {{0, semantics[0].c_str(), 0, 0, 3, 0}};
+
+		desc.VS                    = {vs.data(), vs.size()};
+		desc.PS                    = {ps.data(), ps.size()};
+		desc.StreamOutput          = {so_entries.data(), UINT(so_entries.size()), so_strides.data(), UINT(so_strides.size()), 0};
+		desc.BlendState            = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
+		desc.SampleMask            = D3D12_DEFAULT_SAMPLE_MASK;
+		desc.RasterizerState       = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+		desc.DepthStencilState     = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+		desc.InputLayout           = {elements.data(), UINT(elements.size())};
+		desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+		desc.NumRenderTargets      = 2;
+		desc.RTVFormats[0]         = DXGI_FORMAT_R8G8B8A8_UNORM;
+		desc.RTVFormats[1]         = DXGI_FORMAT_R16G16B16A16_FLOAT;
+		desc.DSVFormat             = DXGI_FORMAT_D32_FLOAT;
+		desc.SampleDesc.Count      = 1;
+	}
+	pipeline_desc(const pipeline_desc&) = delete;
+
+	uint64_t key(uint64_t root_signature = k_root_signature) const { return dx_pipeline_cache::hash(desc, root_signature); }
+};
+
+static void put_u32(std::vector<uint8_t>* out, uint32_t v)
+{
+	const uint8_t* p = reinterpret_cast<const uint8_t*>(&v);
+	out->insert(out->end(), p, p + 4);
+}
+
+// HASH, DXIL, ILDB part 로 된 container : 같은 크기로 만들어 BytecodeLength 는 같게
+static std::vector<uint8_t> make_shader(uint8_t digest, uint8_t program, uint8_t debug)
+{
+	const std::vector<uint8_t> parts[3] = {
+	    std::vector<uint8_t>(4 + dxbc::digest_size, digest),
+	    std::vector<uint8_t>(32, program),
+	    std::vector<uint8_t>(64, debug),
+	};
+	const uint32_t fourccs[3] = {dxbc::hash, dxbc::dxil, dxbc::ildb};
+
+	std::vector<uint8_t> out;
+	put_u32(&out, dxbc::container);
+	out.insert(out.end(), dxbc::digest_size, 0);
+	put_u32(&out, 1);
+	put_u32(&out, 0);
+	put_u32(&out, 3);
+	uint32_t offset = uint32_t(dxbc::header_size + 3 * 4);
+	for(const std::vector<uint8_t>& part : parts) {
+		put_u32(&out, offset);
+		offset += uint32_t(8 + part.size());
+	}
+	for(uint32_t i = 0; i < 3; ++i) {
+		put_u32(&out, fourccs[i]);
+		put_u32(&out, uint32_t(parts[i].size()));
+		out.insert(out.end(), parts[i].begin(), parts[i].end());
+	}
+	const uint32_t total = uint32_t(out.size());
+	memcpy(out.data() + 24, &total, 4);
+	return out;
+}
+
+TEST_CASE(identical_descs_at_different_addresses_hash_the_same)
+{
+	pipeline_desc a;
+	pipeline_desc b;
+	CHECK(a.desc.InputLayout.pInputElementDescs != b.desc.InputLayout.pInputElementDescs);
+	CHECK(a.desc.InputLayout.pInputElementDescs[0].SemanticName != b.desc.InputLayout.pInputElementDescs[0].SemanticName);
+	CHECK(a.desc.StreamOutput.pSODeclaration != b.desc.StreamOutput.pSODeclaration);
+	CHECK(a.desc.VS.pShaderBytecode != b.desc.VS.pShaderBytecode);
+	CHECK(a.key() == b.key());
+
+	// 쓰지 않는 RTV slot 은 key 에 들어가지 않음
+	b.desc.RTVFormats[5] = DXGI_FORMAT_R32_FLOAT;
+	CHECK(a.key() == b.key());
+
+	D3D12_COMPUTE_PIPELINE_STATE_DESC ca{};
+	D3D12_COMPUTE_PIPELINE_STATE_DESC cb{};
+	ca.CS = a.desc.VS;
+	cb.CS = b.desc.VS;
+	CHECK(dx_pipeline_cache::hash(ca, k_root_signature) == dx_pipeline_cache::hash(cb, k_root_signature));
+	// graphics 와 compute 는 섞이지 않음
+	CHECK(dx_pipeline_cache::hash(ca, k_root_signature) != a.key());
+}
+
+TEST_CASE(every_pointed_field_changes_the_key)
+{
+	pipeline_desc  base;
+	const uint64_t key = base.key();
+
+	{
+		pipeline_desc d;
+		d.semantics[1]             = "NORMAL";
+		d.elements[1].SemanticName = d.semantics[1].c_str();
+		CHECK(d.key() != key);
+	}
+	{
+		pipeline_desc d;
+		d.so_strides[0] = 32;
+		CHECK(d.key() != key);
+	}
+	{
+		pipeline_desc d;
+		d.ps[2] ^= 1;
+		CHECK(d.key() != key);
+	}
+}
+
+TEST_CASE(formats_blend_and_root_signature_change_the_key)
+{
+	pipeline_desc  base;
+	const uint64_t key = base.key();
+
+	for(UINT i = 0; i < base.desc.NumRenderTargets; ++i) {
+		pipeline_desc d;
+		d.desc.RTVFormats[i] = DXGI_FORMAT_R10G10B10A2_UNORM;
+		CHECK(d.key() != key);
+	}
+	{
+		pipeline_desc d;
+		d.desc.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
+		CHECK(d.key() != key);
+	}
+	{
+		pipeline_desc d;
+		d.desc.BlendState.RenderTarget[1].BlendEnable = TRUE;
+		CHECK(d.key() != key);
+	}
+	{
+		pipeline_desc d;
+		d.desc.BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_RED;
+		CHECK(d.key() != key);
+	}
+	{
+		pipeline_desc d;
+		d.desc.BlendState.AlphaToCoverageEnable = TRUE;
+		CHECK(d.key() != key);
+	}
+	CHECK(base.key(k_root_signature + 1) != key);
+}
+
+TEST_CASE(dxil_containers_hash_by_their_digest)
+{
+	const std::vector<uint8_t> shader = make_shader(0xaa, 0x01, 0x02);
+	// 같은 HASH, 다른 DXIL / ILDB : 같은 program (debug info 나 재배치만 다름)
+	const std::vector<uint8_t> rebuilt = make_shader(0xaa, 0x03, 0x04);
+	// 다른 HASH
+	const std::vector<uint8_t> other = make_shader(0xbb, 0x01, 0x02);
+
+	D3D12_COMPUTE_PIPELINE_STATE_DESC desc{};
+	desc.CS            = {shader.data(), shader.size()};
+	const uint64_t key = dx_pipeline_cache::hash(desc, k_root_signature);
+	desc.CS            = {rebuilt.data(), rebuilt.size()};
+	CHECK(dx_pipeline_cache::hash(desc, k_root_signature) == key);
+	desc.CS = {other.data(), other.size()};
+	CHECK(dx_pipeline_cache::hash(desc, k_root_signature) != key);
+
+	// container 가 아니면 byte 전체
+	std::vector<uint8_t> raw = shader;
+	raw[0]                   = 'X';
+	desc.CS                  = {raw.data(), raw.size()};
+	const uint64_t raw_key   = dx_pipeline_cache::hash(desc, k_root_signature);
+	raw[raw.size() - 1] ^= 1;
+	CHECK(dx_pipeline_cache::hash(desc, k_root_signature) != raw_key);
+}
@@ -0,0 +1,128 @@
+#include "test.h"
+#include <emt/graphics/queue_sync.h>
+
+using namespace emt;
+
+// gpu 없는 queue model : queue 마다 signal 값을 올리고 실제로 issue 한 wait 만 셈
+struct simulated_queues
+{
+	enum : uint32_t {
+		graphics,
+		compute,
+		copy,
+		count
+	};
+
+	queue_sync sync{count};
+	uint64_t   values[count]{};
+	uint32_t   waits = 0;
+
+	uint64_t signal(uint32_t queue)
+	{
+		sync.on_signal(queue, ++values[queue]);
+		return values[queue];
+	}
+	void wait(uint32_t waiter, uint32_t signaler, uint64_t value)
+	{
+		if(sync.require(waiter, signaler, value))
+			++waits;
+	}
+	// non-const known() 은 private
+	uint64_t known(uint32_t waiter, uint32_t signaler) const { return sync.known(waiter, signaler); }
+};
+
+TEST_CASE(first_wait_is_issued_and_repeats_are_skipped)
+{
+	simulated_queues q;
+	const uint64_t   c1 = q.signal(q.compute);
+	q.wait(q.graphics, q.compute, c1);
+	CHECK(q.waits == 1);
+	CHECK(q.known(q.graphics, q.compute) == c1);
+
+	// 같은 값, 더 작은 값은 이미 순서가 보장됨
+	q.wait(q.graphics, q.compute, c1);
+	CHECK(q.waits == 1);
+
+	const uint64_t c2 = q.signal(q.compute);
+	q.signal(q.compute);
+	q.wait(q.graphics, q.compute, c2 + 1);
+	q.wait(q.graphics, q.compute, c2);
+	CHECK(q.waits == 2);
+}
+
+TEST_CASE(compute_graphics_compute_chain_waits_once_per_edge)
+{
+	simulated_queues q;
+	const uint64_t   c1 = q.signal(q.compute);
+	q.wait(q.graphics, q.compute, c1);
+	const uint64_t g1 = q.signal(q.graphics);
+	q.wait(q.compute, q.graphics, g1);
+	CHECK(q.waits == 2);
+
+	// 다시 compute 가 g1 을, graphics 가 c1 을 요구해도 이미 알고 있음
+	q.wait(q.compute, q.graphics, g1);
+	q.wait(q.graphics, q.compute, c1);
+	CHECK(q.waits == 2);
+}
+
+TEST_CASE(knowledge_is_inherited_through_a_wait)
+{
+	simulated_queues q;
+	const uint64_t   c1 = q.signal(q.compute);
+	q.wait(q.graphics, q.compute, c1);
+	const uint64_t g1 = q.signal(q.graphics);
+
+	// copy 가 g1 을 기다리면 g1 이 이미 기다린 c1 도 알게 됨
+	q.wait(q.copy, q.graphics, g1);
+	CHECK(q.waits == 2);
+	CHECK(q.known(q.copy, q.compute) == c1);
+	q.wait(q.copy, q.compute, c1);
+	CHECK(q.waits == 2);
+
+	// g1 이후에 나온 compute 값은 상속되지 않음
+	const uint64_t c2 = q.signal(q.compute);
+	q.wait(q.copy, q.compute, c2);
+	CHECK(q.waits == 3);
+}
+
+TEST_CASE(inheritance_uses_the_snapshot_at_the_waited_value)
+{
+	simulated_queues q;
+	const uint64_t   g1 = q.signal(q.graphics);        // 아직 compute 를 모름
+	const uint64_t   c1 = q.signal(q.compute);
+	q.wait(q.graphics, q.compute, c1);
+	q.signal(q.graphics);
+
+	// g1 시점의 graphics 는 c1 을 몰랐음
+	q.wait(q.copy, q.graphics, g1);
+	CHECK(q.known(q.copy, q.compute) == 0);
+	q.wait(q.copy, q.compute, c1);
+	CHECK(q.waits == 3);
+}
+
+TEST_CASE(retired_values_need_no_wait)
+{
+	simulated_queues q;
+	const uint64_t   c1 = q.signal(q.compute);
+	const uint64_t   c2 = q.signal(q.compute);
+	q.sync.retire(q.compute, c1);
+	q.wait(q.graphics, q.compute, c1);
+	CHECK(q.waits == 0);
+	q.wait(q.graphics, q.compute, c2);
+	CHECK(q.waits == 1);
+
+	// 완료 값은 줄어들지 않음
+	q.sync.retire(q.compute, 0);
+	q.wait(q.copy, q.compute, c1);
+	CHECK(q.waits == 1);
+}
+
+TEST_CASE(zero_value_and_self_waits_are_ignored)
+{
+	simulated_queues q;
+	CHECK(!q.sync.require(q.graphics, q.compute, 0));
+	const uint64_t g1 = q.signal(q.graphics);
+	CHECK(!q.sync.require(q.graphics, q.graphics, g1));
+	CHECK(!q.sync.require(q.graphics, q.graphics, g1 + 1));
+	CHECK(q.known(q.graphics, q.compute) == 0);
+}
@@ -0,0 +1,220 @@
+#include "test.h"
+#include <emt/graphics/render_graph.h>
+
+using namespace emt;
+
+static bool same(const rg_barrier& b, uint32_t resource, resource_state before, resource_state after)
+{
+	return b.resource == resource && b.before == before && b.after == after;
+}
+
+TEST_CASE(render_graph_orders_by_dependency_then_declaration)
+{
+	render_graph g;
+	rg_handle    out   = g.import_resource("out", resource_state::common, resource_state::common);
+	rg_handle    other = g.import_resource("other", resource_state::common, resource_state::common);
+	rg_handle    t     = g.create_resource("t");
+
+	// 선언은 consumer 가 먼저
+	const uint32_t late  = g.add_pass("late");
+	const uint32_t early = g.add_pass("early");
+	const uint32_t a     = g.add_pass("a");
+	const uint32_t b     = g.add_pass("b");
+	t                    = g.write(early, t, resource_state::render_target);
+	g.read(late, t, resource_state::shader_read);
+	g.write(late, out, resource_state::render_target);
+	other = g.write(b, other, resource_state::copy_dst);
+	g.read(a, other, resource_state::copy_src);
+	g.write(a, g.create_resource("a_out"), resource_state::copy_dst);
+
+	CHECK(g.compile());
+	// a 는 b 의 결과가 필요 없으므로 (transient 만 씀) culling
+	CHECK(g.culled(a));
+	const std::vector<uint32_t> expected = {early, late, b};
+	CHECK(g.order() == expected);
+}
+
+TEST_CASE(render_graph_ties_keep_declaration_order)
+{
+	render_graph g;
+	rg_handle    r[4];
+	uint32_t     p[4];
+	for(uint32_t i = 0; i < 4; ++i) {
+		r[i] = g.import_resource("r", resource_state::common, resource_state::common);
+		p[i] = g.add_pass("independent");
+	}
+	for(uint32_t i = 4; i-- > 0;) {
+		g.write(p[i], r[i], resource_state::copy_dst);
+	}
+	CHECK(g.compile());
+	const std::vector<uint32_t> expected = {p[0], p[1], p[2], p[3]};
+	CHECK(g.order() == expected);
+}
+
+TEST_CASE(render_graph_culls_passes_that_do_not_reach_an_import)
+{
+	render_graph g;
+	rg_handle    out = g.import_resource("out", resource_state::common, resource_state::common);
+	rg_handle    t0  = g.create_resource("t0");
+	rg_handle    t1  = g.create_resource("t1");
+	rg_handle    t2  = g.create_resource("t2");
+	rg_handle    t3  = g.create_resource("t3");
+
+	const uint32_t feeds_dead = g.add_pass("feeds_dead");
+	const uint32_t dead       = g.add_pass("dead");
+	const uint32_t producer   = g.add_pass("producer");
+	const uint32_t present    = g.add_pass("present");
+	const uint32_t debug      = g.add_pass("debug", true);
+
+	t0 = g.write(feeds_dead, t0, resource_state::unordered_access);
+	g.read(dead, t0, resource_state::shader_read);
+	g.write(dead, t1, resource_state::render_target);
+	t2 = g.write(producer, t2, resource_state::render_target);
+	g.read(present, t2, resource_state::shader_read);
+	g.write(present, out, resource_state::render_target);
+	g.write(debug, t3, resource_state::copy_dst);
+
+	CHECK(g.compile());
+	CHECK(g.culled(feeds_dead));
+	CHECK(g.culled(dead));
+	CHECK(!g.culled(producer));
+	CHECK(!g.culled(present));
+	CHECK(!g.culled(debug));
+
+	uint32_t count = 1;
+	CHECK(g.barriers(dead, &count) == nullptr && count == 0);
+	const std::vector<uint32_t> expected = {producer, present, debug};
+	CHECK(g.order() == expected);
+}
+
+TEST_CASE(render_graph_merges_reads_into_one_transition)
+{
+	render_graph g;
+	rg_handle    bb = g.import_resource("backbuffer", resource_state::present, resource_state::present);
+	rg_handle    gb = g.create_resource("gbuffer");
+
+	const uint32_t geometry = g.add_pass("geometry");
+	const uint32_t lighting = g.add_pass("lighting");
+	const uint32_t post     = g.add_pass("post");
+	gb                      = g.write(geometry, gb, resource_state::render_target);
+	g.read(lighting, gb, resource_state::shader_read);
+	bb = g.write(lighting, bb, resource_state::render_target);
+	g.read(post, gb, resource_state::copy_src);
+	g.write(post, bb, resource_state::render_target);
+
+	CHECK(g.compile());
+	const std::vector<uint32_t> expected = {geometry, lighting, post};
+	CHECK(g.order() == expected);
+
+	// transient 는 첫 사용 상태로 생성, barrier 없음
+	CHECK(g.first_state(gb.resource) == resource_state::render_target);
+	uint32_t count = 0;
+	CHECK(g.barriers(geometry, &count) == nullptr && count == 0);
+
+	// lighting 과 post 의 read 는 lighting 에서 한 번에
+	const rg_barrier* b = g.barriers(lighting, &count);
+	CHECK(count == 2);
+	if(count == 2) {
+		CHECK(same(b[0], bb.resource, resource_state::present, resource_state::render_target));
+		CHECK(same(b[1], gb.resource, resource_state::render_target,
+		           resource_state::shader_read | resource_state::copy_src));
+	}
+	CHECK(g.barriers(post, &count) == nullptr && count == 0);
+
+	// imported 는 final 로 되돌림
+	CHECK(g.final_barriers().size() == 1);
+	if(g.final_barriers().size() == 1)
+		CHECK(same(g.final_barriers()[0], bb.resource, resource_state::render_target, resource_state::present));
+	CHECK(g.barrier_count() == 3);
+}
+
+TEST_CASE(render_graph_uav_after_uav_gets_a_uav_barrier)
+{
+	render_graph g;
+	rg_handle    buf = g.create_resource("buffer");
+
+	const uint32_t first  = g.add_pass("first");
+	const uint32_t second = g.add_pass("second");
+	const uint32_t reader = g.add_pass("reader", true);
+	buf                   = g.write(first, buf, resource_state::unordered_access);
+	buf                   = g.write(second, buf, resource_state::unordered_access);
+	g.read(reader, buf, resource_state::shader_read);
+
+	CHECK(g.compile());
+	CHECK(!g.culled(first) && !g.culled(second));
+
+	uint32_t          count = 0;
+	const rg_barrier* b     = g.barriers(second, &count);
+	CHECK(count == 1 && same(b[0], buf.resource, resource_state::unordered_access, resource_state::unordered_access));
+	b = g.barriers(reader, &count);
+	CHECK(count == 1 && same(b[0], buf.resource, resource_state::unordered_access, resource_state::shader_read));
+	CHECK(g.final_barriers().empty());
+}
+
+TEST_CASE(render_graph_write_after_read_waits_for_readers)
+{
+	render_graph g;
+	rg_handle    x   = g.import_resource("x", resource_state::common, resource_state::common);
+	rg_handle    out = g.import_resource("out", resource_state::common, resource_state::common);
+
+	// writer 가 먼저 선언되어도 이전 version 을 읽는 pass 뒤로
+	const uint32_t writer = g.add_pass("writer");
+	const uint32_t reader = g.add_pass("reader");
+	g.read(reader, x, resource_state::shader_read);
+	g.write(reader, out, resource_state::render_target);
+	g.write(writer, x, resource_state::copy_dst);
+
+	CHECK(g.compile());
+	const std::vector<uint32_t> expected = {reader, writer};
+	CHECK(g.order() == expected);
+
+	uint32_t          count = 0;
+	const rg_barrier* b     = g.barriers(writer, &count);
+	CHECK(count == 1 && same(b[0], x.resource, resource_state::shader_read, resource_state::copy_dst));
+	b = g.barriers(reader, &count);
+	CHECK(count == 2);
+}
+
+TEST_CASE(render_graph_reports_a_cycle)
+{
+	render_graph g;
+	rg_handle    x = g.import_resource("x", resource_state::common, resource_state::common);
+	rg_handle    y = g.import_resource("y", resource_state::common, resource_state::common);
+
+	// a 는 b 가 쓴 x 를, b 는 a 가 쓴 y 를 읽음
+	const uint32_t  a  = g.add_pass("a");
+	const uint32_t  b  = g.add_pass("b");
+	const rg_handle y1 = g.write(a, y, resource_state::render_target);
+	const rg_handle x1 = g.write(b, x, resource_state::render_target);
+	g.read(a, x1, resource_state::shader_read);
+	g.read(b, y1, resource_state::shader_read);
+
+	CHECK(!g.compile());
+	CHECK(g.order().empty());
+}
+
+TEST_CASE(render_graph_reset_reuses_and_recompiles_identically)
+{
+	render_graph          g;
+	std::vector<uint32_t> first_order;
+	uint32_t              first_barriers = 0;
+	for(uint32_t frame = 0; frame < 3; ++frame) {
+		g.reset();
+		CHECK(g.pass_count() == 0 && g.resource_count() == 0);
+		rg_handle      bb = g.import_resource("backbuffer", resource_state::present, resource_state::present);
+		rg_handle      t  = g.create_resource("t");
+		const uint32_t p0 = g.add_pass("p0");
+		const uint32_t p1 = g.add_pass("p1");
+		t                 = g.write(p0, t, resource_state::unordered_access);
+		g.read(p1, t, resource_state::shader_read);
+		g.write(p1, bb, resource_state::render_target);
+		CHECK(g.compile());
+		if(frame == 0) {
+			first_order    = g.order();
+			first_barriers = g.barrier_count();
+		}
+		CHECK(g.order() == first_order);
+		CHECK(g.barrier_count() == first_barriers);
+	}
+	CHECK(first_barriers == 3);
+}
@@ -0,0 +1,134 @@
+#include "test.h"
+#include <emt/graphics/render_pass.h>
+
+using namespace emt;
+
+TEST_CASE(begin_access_table)
+{
+	// [load][store]
+	static const render_pass_access expected[3][3] = {
+	    {render_pass_access::preserve, render_pass_access::preserve, render_pass_access::no_access},        // load
+	    {render_pass_access::clear,    render_pass_access::clear,    render_pass_access::no_access},        // clear
+	    {render_pass_access::discard,  render_pass_access::discard,  render_pass_access::no_access},        // discard
+	};
+	for(uint32_t l = 0; l < 3; ++l) {
+		for(uint32_t s = 0; s < 3; ++s) {
+			CHECK(render_pass_begin_access(load_operator(l), store_operator(s)) == expected[l][s]);
+		}
+	}
+}
+
+TEST_CASE(end_access_table)
+{
+	CHECK(render_pass_end_access(store_operator::store) == render_pass_access::preserve);
+	CHECK(render_pass_end_access(store_operator::discard) == render_pass_access::discard);
+	CHECK(render_pass_end_access(store_operator::no_access) == render_pass_access::no_access);
+}
+
+static render_pass_desc one_color()
+{
+	render_pass_desc desc;
+	desc.color_count = 1;
+	return desc;
+}
+
+static render_pass_desc depth_only()
+{
+	render_pass_desc desc;
+	desc.has_depth           = true;
+	desc.depth.type          = render_target_type::depth;
+	desc.depth.load          = load_operator::clear;
+	desc.depth.store         = store_operator::store;
+	desc.depth.stencil_load  = load_operator::discard;
+	desc.depth.stencil_store = store_operator::no_access;
+	return desc;
+}
+
+TEST_CASE(valid_render_passes)
+{
+	CHECK(validate_render_pass(one_color()) == nullptr);
+	CHECK(validate_render_pass(depth_only()) == nullptr);
+
+	// attachment 없이 UAV 만 쓰는 pass
+	render_pass_desc uav;
+	uav.uav_writes = true;
+	CHECK(validate_render_pass(uav) == nullptr);
+
+	// 모든 color + depth_stencil, 안 쓰는 color 는 discard / no_access
+	render_pass_desc full;
+	full.color_count     = MAX_RENDER_PASS_COLORS;
+	full.colors[1].load  = load_operator::discard;
+	full.colors[1].store = store_operator::no_access;
+	full.has_depth       = true;
+	CHECK(validate_render_pass(full) == nullptr);
+
+	// stencil only : depth 쪽은 no_access
+	render_pass_desc stencil;
+	stencil.has_depth           = true;
+	stencil.depth.type          = render_target_type::stencil;
+	stencil.depth.load          = load_operator::discard;
+	stencil.depth.store         = store_operator::no_access;
+	stencil.depth.stencil_load  = load_operator::clear;
+	stencil.depth.stencil_store = store_operator::store;
+	CHECK(validate_render_pass(stencil) == nullptr);
+}
+
+TEST_CASE(rejects_attachment_counts)
+{
+	render_pass_desc empty;
+	CHECK(validate_render_pass(empty) != nullptr);
+
+	render_pass_desc many = one_color();
+	many.color_count      = MAX_RENDER_PASS_COLORS + 1;
+	CHECK(validate_render_pass(many) != nullptr);
+}
+
+TEST_CASE(rejects_wrong_attachment_types)
+{
+	render_pass_desc color = one_color();
+	color.colors[0].type   = render_target_type::depth;
+	CHECK(validate_render_pass(color) != nullptr);
+
+	render_pass_desc depth = depth_only();
+	depth.depth.type       = render_target_type::color;
+	CHECK(validate_render_pass(depth) != nullptr);
+}
+
+TEST_CASE(rejects_loading_no_access_attachments)
+{
+	for(load_operator load : {load_operator::load, load_operator::clear}) {
+		render_pass_desc color = one_color();
+		color.colors[0].load   = load;
+		color.colors[0].store  = store_operator::no_access;
+		CHECK(validate_render_pass(color) != nullptr);
+
+		render_pass_desc depth = depth_only();
+		depth.depth.load       = load;
+		depth.depth.store      = store_operator::no_access;
+		CHECK(validate_render_pass(depth) != nullptr);
+
+		render_pass_desc stencil    = depth_only();
+		stencil.depth.type          = render_target_type::depth_stencil;
+		stencil.depth.stencil_load  = load;
+		stencil.depth.stencil_store = store_operator::no_access;
+		CHECK(validate_render_pass(stencil) != nullptr);
+	}
+}
+
+TEST_CASE(rejects_access_to_a_missing_plane)
+{
+	// depth only 의 stencil, stencil only 의 depth 는 no_access 여야 함
+	render_pass_desc depth    = depth_only();
+	depth.depth.stencil_store = store_operator::discard;
+	CHECK(validate_render_pass(depth) != nullptr);
+	depth.depth.stencil_store = store_operator::no_access;
+	depth.depth.stencil_load  = load_operator::clear;
+	CHECK(validate_render_pass(depth) != nullptr);
+
+	render_pass_desc stencil   = depth_only();
+	stencil.depth.type         = render_target_type::stencil;
+	stencil.depth.load         = load_operator::discard;
+	stencil.depth.store        = store_operator::store;
+	stencil.depth.stencil_load = load_operator::clear;
+	CHECK(validate_render_pass(stencil) != nullptr);
+}
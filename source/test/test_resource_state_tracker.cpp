@@ -0,0 +1,238 @@
+#include "test.h"
+#include <emt/graphics/resource_state_tracker.h>
+
+using namespace emt;
+
+// resource 는 주소로만 구분 : dereference 하지 않으므로 아무 주소나 사용
+static int s_buffer;
+static int s_texture;
+static int s_array;
+
+static std::vector<state_barrier> flush(resource_state_tracker& tracker)
+{
+	std::vector<state_barrier> out;
+	tracker.flush([&out](const state_barrier* barriers, uint32_t count) { out.assign(barriers, barriers + count); });
+	return out;
+}
+
+static bool same(const state_barrier& b, const void* resource, uint32_t subresource, resource_state before,
+                 resource_state after)
+{
+	return b.resource == resource && b.subresource == subresource && b.before == before && b.after == after;
+}
+
+// legacy barrier (promotion 있음) 와 enhanced barrier (texture promotion 없음) 양쪽
+static void set_mode(resource_state_registry& registry, bool enhanced)
+{
+	registry.set_texture_promotion(!enhanced);
+}
+
+TEST_CASE(buffer_promotes_from_common_and_decays_in_both_modes)
+{
+	for(bool enhanced : {false, true}) {
+		resource_state_registry registry;
+		set_mode(registry, enhanced);
+
+		resource_state_tracker tracker;
+		tracker.track(&s_buffer, 1, true);
+		tracker.require(&s_buffer, resource_state::copy_dst);
+		CHECK(flush(tracker).empty());
+
+		std::vector<state_barrier> fixups;
+		CHECK(tracker.resolve(&registry, &fixups) == 0);
+		CHECK(registry.state(&s_buffer) == resource_state::common);
+
+		// 다음 list : 명시적인 barrier 는 list 안에, 끝나면 다시 common
+		tracker.reset();
+		tracker.track(&s_buffer, 1, true);
+		tracker.require(&s_buffer, resource_state::shader_read);
+		tracker.require(&s_buffer, resource_state::unordered_access);
+		const std::vector<state_barrier> barriers = flush(tracker);
+		CHECK(barriers.size() == 1);
+		if(barriers.size() == 1)
+			CHECK(same(barriers[0], &s_buffer, 0, resource_state::shader_read, resource_state::unordered_access));
+		CHECK(tracker.resolve(&registry, &fixups) == 0);
+		CHECK(registry.state(&s_buffer) == resource_state::common);
+	}
+}
+
+TEST_CASE(texture_read_promotes_and_decays_with_legacy_barriers)
+{
+	resource_state_registry registry;
+	set_mode(registry, false);
+
+	resource_state_tracker tracker;
+	tracker.track(&s_texture, 1, false);
+	tracker.require(&s_texture, resource_state::shader_read);
+	CHECK(flush(tracker).empty());
+
+	std::vector<state_barrier> fixups;
+	CHECK(tracker.resolve(&registry, &fixups) == 0);
+	// promotion 된 read 는 submit 뒤에 common 으로 decay
+	CHECK(registry.state(&s_texture) == resource_state::common);
+
+	// promotion 된 write (copy_dst) 는 decay 하지 않음
+	tracker.reset();
+	tracker.track(&s_texture, 1, false);
+	tracker.require(&s_texture, resource_state::copy_dst);
+	flush(tracker);
+	CHECK(tracker.resolve(&registry, &fixups) == 0);
+	CHECK(registry.state(&s_texture) == resource_state::copy_dst);
+}
+
+TEST_CASE(texture_promoted_then_transitioned_keeps_its_state)
+{
+	resource_state_registry registry;
+	set_mode(registry, false);
+
+	resource_state_tracker tracker;
+	tracker.track(&s_texture, 1, false);
+	tracker.require(&s_texture, resource_state::shader_read);
+	tracker.require(&s_texture, resource_state::render_target);
+	const std::vector<state_barrier> barriers = flush(tracker);
+	CHECK(barriers.size() == 1);
+	if(barriers.size() == 1)
+		CHECK(same(barriers[0], &s_texture, 0, resource_state::shader_read, resource_state::render_target));
+
+	std::vector<state_barrier> fixups;
+	CHECK(tracker.resolve(&registry, &fixups) == 0);
+	CHECK(registry.state(&s_texture) == resource_state::render_target);
+
+	// 다음 list 는 registry 의 상태에서 시작 : 보정 필요
+	tracker.reset();
+	tracker.track(&s_texture, 1, false);
+	tracker.require(&s_texture, resource_state::shader_read);
+	flush(tracker);
+	CHECK(tracker.resolve(&registry, &fixups) == 1);
+	if(fixups.size() == 1)
+		CHECK(same(fixups[0], &s_texture, 0, resource_state::render_target, resource_state::shader_read));
+	// 명시적인 전환이므로 decay 없음
+	CHECK(registry.state(&s_texture) == resource_state::shader_read);
+}
+
+TEST_CASE(texture_never_promotes_with_enhanced_barriers)
+{
+	resource_state_registry registry;
+	set_mode(registry, true);
+
+	resource_state_tracker tracker;
+	tracker.track(&s_texture, 1, false);
+	tracker.require(&s_texture, resource_state::shader_read);
+	flush(tracker);
+
+	std::vector<state_barrier> fixups;
+	CHECK(tracker.resolve(&registry, &fixups) == 1);
+	if(fixups.size() == 1)
+		CHECK(same(fixups[0], &s_texture, 0, resource_state::common, resource_state::shader_read));
+	CHECK(registry.state(&s_texture) == resource_state::shader_read);
+}
+
+TEST_CASE(render_target_is_never_promoted)
+{
+	for(bool enhanced : {false, true}) {
+		resource_state_registry registry;
+		set_mode(registry, enhanced);
+
+		resource_state_tracker tracker;
+		tracker.track(&s_texture, 1, false);
+		tracker.require(&s_texture, resource_state::render_target);
+		flush(tracker);
+
+		std::vector<state_barrier> fixups;
+		CHECK(tracker.resolve(&registry, &fixups) == 1);
+		if(fixups.size() == 1)
+			CHECK(same(fixups[0], &s_texture, 0, resource_state::common, resource_state::render_target));
+		CHECK(registry.state(&s_texture) == resource_state::render_target);
+	}
+}
+
+TEST_CASE(reads_merge_into_one_combined_state)
+{
+	resource_state_tracker tracker;
+	tracker.track(&s_texture, 1, false);
+	tracker.require(&s_texture, resource_state::render_target);
+	tracker.require(&s_texture, resource_state::shader_read);
+	tracker.require(&s_texture, resource_state::copy_src);
+	tracker.require(&s_texture, resource_state::shader_read);        // 이미 포함
+
+	const std::vector<state_barrier> barriers = flush(tracker);
+	CHECK(barriers.size() == 2);
+	if(barriers.size() == 2) {
+		CHECK(same(barriers[0], &s_texture, 0, resource_state::render_target, resource_state::shader_read));
+		CHECK(same(barriers[1], &s_texture, 0, resource_state::shader_read,
+		           resource_state::shader_read | resource_state::copy_src));
+	}
+}
+
+TEST_CASE(subresources_collapse_when_uniform)
+{
+	resource_state_registry registry;
+	resource_state_tracker  tracker;
+	tracker.track(&s_array, 4, false);
+	tracker.require(&s_array, resource_state::render_target);
+	tracker.require(&s_array, resource_state::shader_read);
+	tracker.require(&s_array, resource_state::unordered_access, 2);
+	tracker.require(&s_array, resource_state::shader_read);
+
+	const std::vector<state_barrier> barriers = flush(tracker);
+	CHECK(barriers.size() == 3);
+	if(barriers.size() == 3) {
+		CHECK(same(barriers[0], &s_array, all_subresources, resource_state::render_target, resource_state::shader_read));
+		CHECK(same(barriers[1], &s_array, 2, resource_state::shader_read, resource_state::unordered_access));
+		// 상태가 다른 subresource 가 있으면 바뀌는 것만
+		CHECK(same(barriers[2], &s_array, 2, resource_state::unordered_access, resource_state::shader_read));
+	}
+
+	// 모든 subresource 가 같은 보정 -> 하나로
+	std::vector<state_barrier> fixups;
+	CHECK(tracker.resolve(&registry, &fixups) == 1);
+	if(fixups.size() == 1)
+		CHECK(same(fixups[0], &s_array, all_subresources, resource_state::common, resource_state::render_target));
+	for(uint32_t i = 0; i < 4; ++i) {
+		CHECK(registry.state(&s_array, i) == resource_state::shader_read);
+	}
+}
+
+TEST_CASE(subresource_fixups_stay_separate_when_they_differ)
+{
+	resource_state_registry registry;
+	registry.set(&s_array, 2, resource_state::render_target, false);
+
+	resource_state_tracker tracker;
+	tracker.track(&s_array, 2, false);
+	tracker.require(&s_array, resource_state::shader_read, 0);
+	tracker.require(&s_array, resource_state::render_target, 1);
+	flush(tracker);
+
+	std::vector<state_barrier> fixups;
+	CHECK(tracker.resolve(&registry, &fixups) == 1);
+	if(fixups.size() == 1)
+		CHECK(same(fixups[0], &s_array, 0, resource_state::render_target, resource_state::shader_read));
+	CHECK(registry.state(&s_array, 0) == resource_state::shader_read);
+	CHECK(registry.state(&s_array, 1) == resource_state::render_target);
+}
+
+TEST_CASE(uav_barrier_and_unknown_resources)
+{
+	resource_state_tracker tracker;
+	tracker.track(&s_buffer, 1, true);
+	tracker.uav(&s_buffer);
+	const std::vector<state_barrier> barriers = flush(tracker);
+	CHECK(barriers.size() == 1);
+	if(barriers.size() == 1) {
+		CHECK(same(barriers[0], &s_buffer, all_subresources, resource_state::unordered_access,
+		           resource_state::unordered_access));
+	}
+
+	resource_state_registry registry;
+	CHECK(registry.state(&s_texture) == resource_state::common);
+	// subresource 수가 다르면 다시 만들어진 resource : common 에서 시작
+	registry.set(&s_texture, 1, resource_state::render_target, false);
+	tracker.reset();
+	tracker.track(&s_texture, 3, false);
+	tracker.require(&s_texture, resource_state::copy_dst);
+	flush(tracker);
+	std::vector<state_barrier> fixups;
+	CHECK(tracker.resolve(&registry, &fixups) == 0);        // common -> copy_dst 는 promotion
+	CHECK(registry.state(&s_texture, 2) == resource_state::copy_dst);
+}
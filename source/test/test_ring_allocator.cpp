@@ -0,0 +1,152 @@
+#include "test.h"
+#include <emt/graphics/ring_allocator.h>
+
+using namespace emt;
+
+// timeline 별 완료 값 (retire predicate)
+struct completed_values
+{
+	uint64_t values[2]{};
+	bool     operator()(const ring_fence& f) const { return f.value <= values[f.timeline]; }
+};
+
+TEST_CASE(allocations_are_sequential_and_aligned)
+{
+	ring_allocator ring;
+	ring.initialize(1024);
+	CHECK(ring.allocate(10, 1, {0, 1}) == 0);
+	CHECK(ring.allocate(16, 16, {0, 1}) == 16);        // 10 -> 16 padding
+	CHECK(ring.used() == 32);
+	CHECK(ring.allocate(0, 1, {0, 1}) == ring_allocator::invalid);
+	CHECK(ring.allocate(2048, 1, {0, 1}) == ring_allocator::invalid);
+	CHECK(ring.used() == 32);
+}
+
+TEST_CASE(full_ring_rejects_until_retired)
+{
+	ring_allocator   ring;
+	completed_values done;
+	ring.initialize(256);
+	CHECK(ring.allocate(128, 1, {0, 1}) == 0);
+	CHECK(ring.allocate(128, 1, {0, 2}) == 128);
+	CHECK(ring.used() == 256);
+	CHECK(ring.allocate(1, 1, {0, 3}) == ring_allocator::invalid);
+
+	// 아무것도 끝나지 않음
+	CHECK(ring.retire(done) == 0);
+	CHECK(ring.allocate(1, 1, {0, 3}) == ring_allocator::invalid);
+
+	done.values[0] = 1;
+	CHECK(ring.retire(done) == 128);
+	CHECK(ring.oldest().value == 2);
+	CHECK(ring.allocate(128, 1, {0, 3}) == 0);
+	CHECK(ring.allocate(1, 1, {0, 3}) == ring_allocator::invalid);
+}
+
+TEST_CASE(wrap_skips_the_end_and_charges_the_padding)
+{
+	ring_allocator   ring;
+	completed_values done;
+	ring.initialize(100);
+	CHECK(ring.allocate(60, 1, {0, 1}) == 0);
+	CHECK(ring.allocate(30, 1, {0, 2}) == 60);
+	done.values[0] = 1;
+	ring.retire(done);
+	CHECK(ring.used() == 30);
+
+	// 90 에서 20 은 넘침 -> 끝의 10 을 버리고 0 부터, 버린 10 은 이 allocation 몫
+	CHECK(ring.allocate(20, 1, {0, 3}) == 0);
+	CHECK(ring.used() == 30 + 10 + 20);
+
+	// fence 2 가 끝나면 30 만, fence 3 이 끝나야 padding 까지 풀림
+	done.values[0] = 2;
+	CHECK(ring.retire(done) == 30);
+	done.values[0] = 3;
+	CHECK(ring.retire(done) == 30);
+	CHECK(ring.used() == 0);
+	CHECK(ring.empty());
+	// 비면 처음부터
+	CHECK(ring.allocate(100, 1, {0, 4}) == 0);
+}
+
+TEST_CASE(alignment_padding_wraps_too)
+{
+	ring_allocator   ring;
+	completed_values done;
+	ring.initialize(256);
+	CHECK(ring.allocate(200, 1, {0, 1}) == 0);
+	done.values[0] = 1;
+	ring.allocate(8, 1, {0, 2});        // 200
+	ring.retire(done);
+	// 208 -> 256 정렬이면 끝 : 0 으로
+	CHECK(ring.allocate(64, 64, {0, 3}) == 0);
+	CHECK(ring.used() == 8 + 48 + 64);
+}
+
+TEST_CASE(same_fence_allocations_merge)
+{
+	ring_allocator   ring;
+	completed_values done;
+	ring.initialize(64);
+	ring.allocate(8, 1, {0, 1});
+	ring.allocate(8, 1, {0, 1});
+	ring.allocate(8, 1, {1, 1});        // 다른 timeline 의 같은 값은 별개
+	done.values[0] = 1;
+	CHECK(ring.retire(done) == 16);
+	CHECK(ring.oldest().timeline == 1);
+}
+
+TEST_CASE(out_of_order_completion_retires_in_fifo_order)
+{
+	ring_allocator   ring;
+	completed_values done;
+	ring.initialize(300);
+	ring.allocate(100, 1, {0, 1});        // graphics
+	ring.allocate(100, 1, {1, 1});        // copy
+	ring.allocate(100, 1, {0, 2});        // graphics
+
+	// copy 와 뒤의 graphics 가 먼저 끝나도 앞의 graphics 가 막고 있음
+	done.values[1] = 1;
+	done.values[0] = 0;
+	CHECK(ring.retire(done) == 0);
+	CHECK(ring.allocate(1, 1, {0, 3}) == ring_allocator::invalid);
+
+	done.values[0] = 2;
+	CHECK(ring.retire(done) == 300);
+	CHECK(ring.empty());
+}
+
+TEST_CASE(many_frames_stay_in_bounds)
+{
+	// 크기가 다른 allocation 을 frame 마다 : 범위 안, 살아 있는 구간이 겹치지 않음
+	ring_allocator   ring;
+	completed_values done;
+	ring.initialize(1000);
+	struct live
+	{
+		uint64_t offset, size, frame;
+	};
+	std::vector<live> alive;
+	uint32_t          seed = 1;
+	for(uint64_t frame = 1; frame < 500; ++frame) {
+		for(int i = 0; i < 4; ++i) {
+			seed = seed * 1664525u + 1013904223u;
+
+			const uint64_t size = 1 + (seed >> 24) % 120;
+			const uint64_t o    = ring.allocate(size, 4, {0, frame});
+			if(o == ring_allocator::invalid)
+				continue;
+			CHECK(o + size <= ring.capacity());
+			for(const live& l : alive)
+				CHECK(o + size <= l.offset || l.offset + l.size <= o);
+			alive.push_back({o, size, frame});
+		}
+		CHECK(ring.used() <= ring.capacity());
+		// gpu 는 2 frame 늦음
+		if(frame > 2) {
+			done.values[0] = frame - 2;
+			ring.retire(done);
+			std::erase_if(alive, [&](const live& l) { return l.frame <= frame - 2; });
+		}
+	}
+}
@@ -0,0 +1,200 @@
+#include "test.h"
+#include <emt/graphics/shader_disk_cache.h>
+#include <emt/graphics/dxbc_container.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace emt;
+namespace fs = std::filesystem;
+
+static const uint64_t k_compiler = 0x0dc0ffee12345678ull;
+
+// test 마다 빈 directory : <tmp>/emt_test_shader_cache/<name>
+static fs::path fresh_dir(const char* name)
+{
+	const fs::path  dir = fs::temp_directory_path() / "emt_test_shader_cache" / name;
+	std::error_code ec;
+	fs::remove_all(dir, ec);
+	fs::create_directories(dir, ec);
+	return dir;
+}
+
+static void write_text(const fs::path& path, const std::string& text)
+{
+	fs::create_directories(path.parent_path());
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file << text;
+}
+
+// source 를 다시 읽어 key 를 구함 (compile 하는 쪽과 같은 순서)
+static uint64_t key_of(const shader_disk_cache& cache, const fs::path& file, const char* const* args,
+                       uint32_t arg_count, std::vector<std::string>* dependencies = nullptr)
+{
+	std::vector<uint8_t> source;
+	read_binary_file(file.string().c_str(), &source);
+	return cache.key(file.string().c_str(), source.data(), source.size(), args, arg_count, {}, dependencies);
+}
+
+// part 가 없는 가장 작은 DXBC container
+static std::vector<uint8_t> empty_container()
+{
+	std::vector<uint8_t> bytes(dxbc::header_size, 0);
+	const uint32_t       magic = dxbc::container;
+	const uint32_t       total = uint32_t(dxbc::header_size);
+	memcpy(bytes.data(), &magic, 4);
+	memcpy(bytes.data() + 24, &total, 4);
+	return bytes;
+}
+
+TEST_CASE(key_is_stable_and_covers_args_and_compiler)
+{
+	const fs::path dir = fresh_dir("key");
+	write_text(dir / "main.hlsl", "#include \"common.hlsli\"\nfloat4 main() : SV_Target { return 1; }\n");
+	write_text(dir / "common.hlsli", "#define ONE 1\n");
+
+	shader_disk_cache cache;
+	cache.initialize((dir / "cache").string().c_str(), k_compiler);
+	const char*    args[] = {"-E", "main", "-T", "ps_6_6"};
+	const uint64_t key    = key_of(cache, dir / "main.hlsl", args, 4);
+	CHECK(key == key_of(cache, dir / "main.hlsl", args, 4));
+
+	// 다른 instance, 같은 입력 -> 같은 key (실행이 바뀌어도 disk 에서 찾을 수 있음)
+	shader_disk_cache other;
+	other.initialize((dir / "cache").string().c_str(), k_compiler);
+	CHECK(key == key_of(other, dir / "main.hlsl", args, 4));
+
+	const char* profile[] = {"-E", "main", "-T", "ps_6_7"};
+	CHECK(key != key_of(cache, dir / "main.hlsl", profile, 4));
+	// 인자 경계가 섞이지 않음 : "-E" "main" != "-Emain"
+	const char* joined[] = {"-Emain", "-T", "ps_6_6"};
+	CHECK(key != key_of(cache, dir / "main.hlsl", joined, 3));
+	CHECK(key != key_of(cache, dir / "main.hlsl", args, 3));
+
+	shader_disk_cache compiler;
+	compiler.initialize((dir / "cache").string().c_str(), k_compiler + 1);
+	CHECK(key != key_of(compiler, dir / "main.hlsl", args, 4));
+}
+
+TEST_CASE(key_follows_transitive_includes)
+{
+	const fs::path dir = fresh_dir("includes");
+	write_text(dir / "main.hlsl", "  #  include \"a.hlsli\"\nfloat4 main() : SV_Target { return A; }\n");
+	write_text(dir / "a.hlsli", "#include \"sub/b.hlsli\"\n#define A B\n");
+	write_text(dir / "sub" / "b.hlsli", "#include <c.hlsli>\n#define B 1\n");
+	write_text(dir / "inc" / "c.hlsli", "// c\n");
+
+	shader_disk_cache cache;
+	cache.initialize((dir / "cache").string().c_str(), k_compiler);
+	cache.add_include_dir((dir / "inc").string().c_str());
+	const char*              args[] = {"-T", "ps_6_6"};
+	std::vector<std::string> dependencies;
+	const uint64_t           key = key_of(cache, dir / "main.hlsl", args, 2, &dependencies);
+
+	// file 자신 + 찾은 include 전체 (찾은 그대로의 경로)
+	CHECK(dependencies.size() == 4);
+	if(dependencies.size() == 4) {
+		CHECK(dependencies[0] == (dir / "main.hlsl").string());
+		CHECK(fs::equivalent(dependencies[1], dir / "a.hlsli"));
+		CHECK(fs::equivalent(dependencies[2], dir / "sub" / "b.hlsli"));
+		CHECK(fs::equivalent(dependencies[3], dir / "inc" / "c.hlsli"));
+	}
+
+	// 두 단계 아래 include 의 내용이 바뀌어도 key 가 바뀜
+	write_text(dir / "inc" / "c.hlsli", "// c changed\n");
+	const uint64_t changed = key_of(cache, dir / "main.hlsl", args, 2);
+	CHECK(changed != key);
+	write_text(dir / "inc" / "c.hlsli", "// c\n");
+	CHECK(key_of(cache, dir / "main.hlsl", args, 2) == key);
+
+	// 없던 include 가 생겨도 바뀜
+	write_text(dir / "sub" / "b.hlsli", "#include <c.hlsli>\n#include \"d.hlsli\"\n#define B 1\n");
+	const uint64_t missing = key_of(cache, dir / "main.hlsl", args, 2);
+	CHECK(missing != key);
+	write_text(dir / "sub" / "d.hlsli", "\n");
+	CHECK(key_of(cache, dir / "main.hlsl", args, 2) != missing);
+}
+
+TEST_CASE(include_cycles_are_visited_once)
+{
+	const fs::path dir = fresh_dir("cycle");
+	write_text(dir / "main.hlsl", "#include \"a.hlsli\"\n#include \"b.hlsli\"\n");
+	write_text(dir / "a.hlsli", "#include \"b.hlsli\"\n");
+	write_text(dir / "b.hlsli", "#include \"a.hlsli\"\n");
+
+	shader_disk_cache cache;
+	cache.initialize((dir / "cache").string().c_str(), k_compiler);
+	std::vector<std::string> dependencies;
+	key_of(cache, dir / "main.hlsl", nullptr, 0, &dependencies);
+	CHECK(dependencies.size() == 3);
+}
+
+TEST_CASE(store_and_load_round_trip)
+{
+	const fs::path    dir = fresh_dir("store");
+	shader_disk_cache cache;
+	cache.initialize((dir / "cache").string().c_str(), k_compiler);
+	CHECK(cache.enabled());
+
+	const std::vector<uint8_t> bytecode = empty_container();
+	std::vector<uint8_t>       loaded;
+	CHECK(!cache.load(42, &loaded));
+	CHECK(cache.store(42, bytecode.data(), bytecode.size()));
+	CHECK(fs::exists(cache.path_of(42)));
+	CHECK(cache.load(42, &loaded));
+	CHECK(loaded == bytecode);
+
+	// 같은 key 의 다른 extension 은 따로, container 검사 없음
+	const std::vector<uint8_t> reflection = {1, 2, 3};
+	CHECK(cache.store(42, reflection.data(), reflection.size(), "refl"));
+	CHECK(cache.load(42, &loaded, "refl"));
+	CHECK(loaded == reflection);
+	CHECK(cache.load(42, &loaded));
+	CHECK(loaded == bytecode);
+	CHECK(!cache.load(43, &loaded, "refl"));
+
+	// directory 가 없으면 꺼짐
+	shader_disk_cache disabled;
+	disabled.initialize(nullptr, k_compiler);
+	CHECK(!disabled.enabled());
+	CHECK(!disabled.store(42, bytecode.data(), bytecode.size()));
+	CHECK(!disabled.load(42, &loaded));
+}
+
+TEST_CASE(damaged_entries_are_misses)
+{
+	const fs::path    dir = fresh_dir("damaged");
+	shader_disk_cache cache;
+	cache.initialize((dir / "cache").string().c_str(), k_compiler);
+	const std::vector<uint8_t> bytecode = empty_container();
+	std::vector<uint8_t>       loaded;
+
+	// 깨진 byte
+	CHECK(cache.store(1, bytecode.data(), bytecode.size()));
+	{
+		std::fstream file(cache.path_of(1), std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(-3, std::ios::end);
+		file.put(char(0x5a));
+	}
+	CHECK(!cache.load(1, &loaded));
+	CHECK(loaded.empty());
+
+	// 잘린 파일
+	CHECK(cache.store(2, bytecode.data(), bytecode.size()));
+	fs::resize_file(cache.path_of(2), fs::file_size(cache.path_of(2)) - 1);
+	CHECK(!cache.load(2, &loaded));
+
+	// 다른 key 의 파일이 이 이름으로 들어옴 (identity = key)
+	CHECK(cache.store(3, bytecode.data(), bytecode.size()));
+	fs::copy_file(cache.path_of(3), cache.path_of(4));
+	CHECK(!cache.load(4, &loaded));
+
+	// 파일 형식은 맞지만 container 가 아님
+	const std::vector<uint8_t> garbage(64, 0xcd);
+	CHECK(cache.store(5, garbage.data(), garbage.size()));
+	CHECK(!cache.load(5, &loaded));
+	CHECK(loaded.empty());
+
+	std::error_code ec;
+	fs::remove_all(fs::temp_directory_path() / "emt_test_shader_cache", ec);
+}